@@ -0,0 +1,387 @@
+#include "sdk.h"
+//
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <signal.h>
+#include <sys/ptrace.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <future>
+#include <iostream>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "http_server.h"
+#include "uring_server.h"
+
+namespace {
+
+namespace net = boost::asio;
+using namespace std::literals;
+namespace http = boost::beast::http;
+using tcp = net::ip::tcp;
+using Clock = std::chrono::steady_clock;
+
+unsigned ParseArg(int argc, const char* argv[], int index, unsigned default_value) {
+    if (argc <= index) {
+        return default_value;
+    }
+    const std::string_view arg = argv[index];
+    unsigned value = 0;
+    const auto [end, ec] = std::from_chars(arg.data(), arg.data() + arg.size(), value);
+    if (ec != std::errc{} || end != arg.data() + arg.size() || value == 0) {
+        throw std::invalid_argument("Invalid argument: "s + std::string(arg));
+    }
+    return value;
+}
+
+[[noreturn]] void ThrowLastError(const char* what) {
+    throw std::system_error(errno, std::generic_category(), what);
+}
+
+// Отвечает на GET телом "Hello, <target>", как обработчик hello_async
+struct HelloHandler {
+    // Принимает http::request и http_server::RequestView
+    template <typename Request, typename Send>
+    void operator()(const Request& req, Send&& send) const {
+        std::string_view target = req.target();
+        if (!target.empty() && target.front() == '/') {
+            target.remove_prefix(1);
+        }
+        send(header_cache->MakeResponse(http::status::ok, req.version(), "text/html"sv,
+                                        req.keep_alive(), "Hello, "s.append(target)));
+    }
+
+    http_server::ResponseHeaderCache* header_cache;
+};
+
+enum class Backend { ASIO, IO_URING };
+
+std::string_view GetBackendName(Backend backend) {
+    return backend == Backend::ASIO ? "asio (epoll)"sv : "io_uring"sv;
+}
+
+// Возвращает свободный порт, который назначит ядро
+unsigned short FindFreePort() {
+    const int fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        ThrowLastError("socket");
+    }
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t size = sizeof(address);
+    const bool bound = bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0
+                       && getsockname(fd, reinterpret_cast<sockaddr*>(&address), &size) == 0;
+    const int error = errno;
+    close(fd);
+    if (!bound) {
+        errno = error;
+        ThrowLastError("bind");
+    }
+    return ntohs(address.sin_port);
+}
+
+// Запускает однопоточный сервер в дочернем процессе, чтобы трассировать только его
+pid_t StartServer(Backend backend, unsigned short port) {
+    const pid_t pid = fork();
+    if (pid < 0) {
+        ThrowLastError("fork");
+    }
+    if (pid > 0) {
+        return pid;
+    }
+    try {
+        http_server::ResponseHeaderCache header_cache;
+        const HelloHandler handler{&header_cache};
+        const tcp::endpoint endpoint{net::ip::make_address("127.0.0.1"), port};
+        if (backend == Backend::ASIO) {
+            net::io_context ioc{1};
+            http_server::ServeHttp(ioc, endpoint, handler);
+            ioc.run();
+        } else {
+            http_server::UringServer<HelloHandler> server{endpoint, handler};
+            server.Run();
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Server: "sv << e.what() << std::endl;
+        _exit(EXIT_FAILURE);
+    }
+    _exit(EXIT_SUCCESS);
+}
+
+/*
+Клиент, поддерживающий connections соединений keep-alive. За один раунд клиент отправляет по
+запросу в каждое соединение, а затем читает все ответы. Поэтому у сервера одновременно готовы
+к чтению до connections сокетов, и он может обработать их за одну итерацию цикла событий.
+*/
+class LoadClient {
+public:
+    LoadClient(unsigned short port, unsigned connections) {
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.sin_port = htons(port);
+        for (unsigned i = 0; i < connections; ++i) {
+            const int fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+            if (fd < 0) {
+                ThrowLastError("socket");
+            }
+            fds_.push_back(fd);
+            // Сервер мог ещё не начать принимать соединения
+            const auto deadline = Clock::now() + 5s;
+            while (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+                if (errno != ECONNREFUSED || Clock::now() > deadline) {
+                    ThrowLastError("connect");
+                }
+                std::this_thread::sleep_for(10ms);
+            }
+            const int enable = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+        }
+    }
+
+    LoadClient(const LoadClient&) = delete;
+    LoadClient& operator=(const LoadClient&) = delete;
+
+    ~LoadClient() {
+        for (const int fd : fds_) {
+            close(fd);
+        }
+    }
+
+    // Выполняет один раунд и возвращает количество запросов
+    size_t RunRound() {
+        for (const int fd : fds_) {
+            if (send(fd, REQUEST.data(), REQUEST.size(), MSG_NOSIGNAL)
+                != static_cast<ssize_t>(REQUEST.size())) {
+                ThrowLastError("send");
+            }
+        }
+        for (const int fd : fds_) {
+            ReadResponse(fd);
+        }
+        return fds_.size();
+    }
+
+private:
+    static constexpr std::string_view REQUEST = "GET /bench HTTP/1.1\r\nHost: localhost\r\n\r\n"sv;
+    static constexpr std::string_view EXPECTED_BODY = "Hello, bench"sv;
+
+    // Ответы на одинаковые запросы одинаковы, поэтому достаточно прочитать столько байт,
+    // сколько занял первый ответ
+    void ReadResponse(int fd) {
+        size_t size = 0;
+        while (size < buffer_.size() && (response_size_ == 0 || size < response_size_)) {
+            const ssize_t result = recv(fd, buffer_.data() + size, buffer_.size() - size, 0);
+            if (result <= 0) {
+                throw std::runtime_error("Connection closed by server");
+            }
+            size += static_cast<size_t>(result);
+            const std::string_view response{buffer_.data(), size};
+            if (response_size_ == 0 && response.ends_with(EXPECTED_BODY)) {
+                if (!response.starts_with("HTTP/1.1 200 OK\r\n"sv)) {
+                    throw std::runtime_error("Unexpected response: "s + std::string(response));
+                }
+                response_size_ = size;
+            }
+        }
+        if (size != response_size_) {
+            throw std::runtime_error("Unexpected response size");
+        }
+    }
+
+    std::vector<int> fds_;
+    std::array<char, 4096> buffer_;
+    size_t response_size_ = 0;
+};
+
+/*
+Считает системные вызовы всех потоков процесса с помощью ptrace, как strace -c. Трассировка
+многократно замедляет процесс, поэтому пропускная способность измеряется без неё.
+*/
+class SyscallCounter {
+public:
+    explicit SyscallCounter(pid_t pid)
+        : pid_(pid) {
+        std::promise<void> attached;
+        auto attached_future = attached.get_future();
+        // Все запросы ptrace должны выполняться из потока, подключившегося к процессу
+        thread_ = std::jthread{[this, attached = std::move(attached)]() mutable {
+            Trace(attached);
+        }};
+        attached_future.get();
+    }
+
+    // Завершает подсчёт и трассируемый процесс. Возвращает количество вызовов по номерам
+    std::map<long, std::uint64_t> Stop() {
+        stop_ = true;
+        // Сигнал останавливает процесс и пробуждает трассирующий поток
+        kill(pid_, SIGURG);
+        thread_.join();
+        return counts_;
+    }
+
+private:
+    void Trace(std::promise<void>& attached) {
+        try {
+            constexpr long OPTIONS = PTRACE_O_TRACESYSGOOD | PTRACE_O_TRACECLONE
+                                     | PTRACE_O_EXITKILL;
+            const auto task_dir = std::filesystem::path{"/proc"} / std::to_string(pid_) / "task";
+            for (const auto& task : std::filesystem::directory_iterator{task_dir}) {
+                const pid_t tid = std::stoi(task.path().filename().string());
+                if (ptrace(PTRACE_SEIZE, tid, nullptr, OPTIONS) < 0
+                    || ptrace(PTRACE_INTERRUPT, tid, nullptr, nullptr) < 0) {
+                    ThrowLastError("ptrace");
+                }
+            }
+        } catch (...) {
+            attached.set_exception(std::current_exception());
+            return;
+        }
+        attached.set_value();
+
+        while (true) {
+            int status = 0;
+            const pid_t tid = waitpid(-1, &status, __WALL);
+            if (tid < 0 || stop_) {
+                // При завершении трассирующего потока процесс завершится из-за
+                // PTRACE_O_EXITKILL
+                return;
+            }
+            if (!WIFSTOPPED(status)) {
+                continue;
+            }
+            int signal = 0;
+            if (WSTOPSIG(status) == (SIGTRAP | 0x80)) {
+                __ptrace_syscall_info info{};
+                if (ptrace(PTRACE_GET_SYSCALL_INFO, tid, sizeof(info), &info) > 0
+                    && info.op == PTRACE_SYSCALL_INFO_ENTRY) {
+                    ++counts_[static_cast<long>(info.entry.nr)];
+                }
+            } else if (status >> 16 == 0) {
+                // Обычный сигнал доставляется процессу
+                signal = WSTOPSIG(status);
+            }
+            ptrace(PTRACE_SYSCALL, tid, nullptr, signal);
+        }
+    }
+
+    pid_t pid_;
+    std::atomic<bool> stop_{false};
+    std::map<long, std::uint64_t> counts_;
+    std::jthread thread_;
+};
+
+std::string GetSyscallName(long number) {
+    static const std::map<long, std::string_view> names = {
+        {SYS_read, "read"sv},
+        {SYS_write, "write"sv},
+        {SYS_readv, "readv"sv},
+        {SYS_writev, "writev"sv},
+        {SYS_recvfrom, "recvfrom"sv},
+        {SYS_sendto, "sendto"sv},
+        {SYS_recvmsg, "recvmsg"sv},
+        {SYS_sendmsg, "sendmsg"sv},
+        {SYS_epoll_wait, "epoll_wait"sv},
+        {SYS_epoll_pwait, "epoll_pwait"sv},
+        {SYS_epoll_ctl, "epoll_ctl"sv},
+        {SYS_io_uring_enter, "io_uring_enter"sv},
+        {SYS_accept4, "accept4"sv},
+        {SYS_close, "close"sv},
+        {SYS_futex, "futex"sv},
+        {SYS_timerfd_settime, "timerfd_settime"sv},
+        {SYS_ioctl, "ioctl"sv},
+    };
+    const auto it = names.find(number);
+    return it != names.end() ? std::string(it->second) : "syscall "s + std::to_string(number);
+}
+
+void RunBenchmark(Backend backend, unsigned connections, std::chrono::seconds duration,
+                  unsigned traced_requests) {
+    const unsigned short port = FindFreePort();
+    const pid_t pid = StartServer(backend, port);
+    try {
+        LoadClient client{port, connections};
+        // Прогрев: соединения приняты, буферы выделены
+        for (int i = 0; i < 100; ++i) {
+            client.RunRound();
+        }
+
+        size_t requests = 0;
+        const auto start = Clock::now();
+        while (Clock::now() - start < duration) {
+            requests += client.RunRound();
+        }
+        const std::chrono::duration<double> elapsed = Clock::now() - start;
+        std::cout << GetBackendName(backend) << ": "sv << requests / elapsed.count()
+                  << " requests/s"sv << std::endl;
+
+        SyscallCounter counter{pid};
+        size_t traced = 0;
+        while (traced < traced_requests) {
+            traced += client.RunRound();
+        }
+        const auto counts = counter.Stop();
+
+        std::vector<std::pair<std::uint64_t, long>> by_count;
+        std::uint64_t total = 0;
+        for (const auto& [number, count] : counts) {
+            by_count.emplace_back(count, number);
+            total += count;
+        }
+        std::sort(by_count.rbegin(), by_count.rend());
+        const auto per_request = [traced](std::uint64_t count) {
+            return static_cast<double>(count) / traced;
+        };
+        std::cout << GetBackendName(backend) << ": "sv << per_request(total)
+                  << " syscalls/request ("sv;
+        for (size_t i = 0; i < by_count.size(); ++i) {
+            std::cout << (i > 0 ? ", "sv : ""sv) << GetSyscallName(by_count[i].second) << ' '
+                      << per_request(by_count[i].first);
+        }
+        std::cout << ')' << std::endl;
+    } catch (...) {
+        kill(pid, SIGKILL);
+        waitpid(pid, nullptr, 0);
+        throw;
+    }
+    kill(pid, SIGKILL);
+    waitpid(pid, nullptr, 0);
+}
+
+}  // namespace
+
+/*
+Сравнивает сервер на реакторе asio (epoll) с сервером на io_uring. Каждый сервер работает в
+одном потоке в дочернем процессе. Сначала измеряется пропускная способность, затем с помощью
+ptrace подсчитываются системные вызовы сервера на запрос.
+*/
+int main(int argc, const char* argv[]) {
+    try {
+        // hello_async_backend_benchmark [<connections> [<seconds> [<traced requests>]]]
+        const unsigned connections = ParseArg(argc, argv, 1, 64);
+        const std::chrono::seconds duration{ParseArg(argc, argv, 2, 5)};
+        const unsigned traced_requests = ParseArg(argc, argv, 3, 20'000);
+
+        for (const Backend backend : {Backend::ASIO, Backend::IO_URING}) {
+            RunBenchmark(backend, connections, duration, traced_requests);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+}
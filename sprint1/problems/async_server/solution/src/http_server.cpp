@@ -5,6 +5,13 @@
 
 namespace http_server {
 
+namespace {
+
+//   ,      
+constexpr size_t READ_SIZE = 4096;
+
+}  // namespace
+
 void ReportError(beast::error_code ec, std::string_view what) {
     std::cerr << what << ": " << ec.message() << std::endl;
 }
@@ -32,15 +39,55 @@ void SessionBase::OnWrite(bool close, beast::error_code ec, [[maybe_unused]] std
 
 void SessionBase::Read() {
     using namespace std::literals;
+    //      
+    stream_.expires_after(30s);
+    ContinueRead();
+}
+
+void SessionBase::ContinueRead() {
+    //   ,   buffer_   
+    const auto data = buffer_.cdata();
+    RequestView view;
+    const auto [status, size] = ParseRequest(
+        {static_cast<const char*>(data.data()), data.size()}, view);
+    if (status == ParseStatus::COMPLETE) {
+        //  view   buffer_,     
+        HandleRequest(view);
+        buffer_.consume(size);
+        return;
+    }
+    if (status == ParseStatus::INCOMPLETE) {
+        stream_.async_read_some(buffer_.prepare(READ_SIZE),
+            beast::bind_front_handler(&SessionBase::OnReadSome, GetSharedThis()));
+        return;
+    }
+
     //      ( Read     )
     request_ = {};
-    stream_.expires_after(30s);
-    //  request_  stream_,  buffer_    
+    //  request_  stream_,  buffer_    .
+    //    beast   buffer_
     http::async_read(stream_, buffer_, request_,
         //       OnRead
         beast::bind_front_handler(&SessionBase::OnRead, GetSharedThis()));
 }
 
+void SessionBase::OnReadSome(beast::error_code ec, std::size_t bytes_read) {
+    using namespace std::literals;
+    if (ec == net::error::eof && buffer_.size() == 0) {
+        //   -   
+        return Close();
+    }
+    if (ec == net::error::eof) {
+        //   ,   
+        ec = http::error::partial_message;
+    }
+    if (ec) {
+        return ReportError(ec, "read"sv);
+    }
+    buffer_.commit(bytes_read);
+    ContinueRead();
+}
+
 void SessionBase::OnRead(beast::error_code ec, [[maybe_unused]] std::size_t bytes_read) {
     using namespace std::literals;
     if (ec == http::error::end_of_stream) {
@@ -5,9 +5,13 @@
 
 #include <boost/asio/ip/tcp.hpp>
 #include <boost/asio/strand.hpp>
+#include <boost/asio/write.hpp>
 #include <boost/beast/core.hpp>
 #include <boost/beast/http.hpp>
 
+#include "request_parser.h"
+#include "response_cache.h"
+
 namespace http_server {
 
 namespace net = boost::asio;
@@ -47,11 +51,28 @@ protected:
             });
     }
 
+    // Отправляет ответ с заранее сформированными заголовками одной операцией записи
+    void Write(PrebuiltResponse&& response) {
+        auto safe_response = std::make_shared<PrebuiltResponse>(std::move(response));
+
+        auto self = GetSharedThis();
+        net::async_write(stream_, safe_response->GetBuffers(),
+            [safe_response, self](beast::error_code ec, std::size_t bytes_written) {
+                self->OnWrite(safe_response->need_eof(), ec, bytes_written);
+            });
+    }
+
 private:
     void OnWrite(bool close, beast::error_code ec, [[maybe_unused]] std::size_t bytes_written);
 
     void Read();
 
+    // Разбирает запрос из buffer_ без участия beast, при необходимости дочитывая данные.
+    // Запросы, которые RequestView не поддерживает, считывает http::async_read
+    void ContinueRead();
+
+    void OnReadSome(beast::error_code ec, std::size_t bytes_read);
+
     void OnRead(beast::error_code ec, [[maybe_unused]] std::size_t bytes_read);
 
     void Close();
@@ -59,6 +80,9 @@ private:
     // Обработку запроса делегируем подклассу
     virtual void HandleRequest(HttpRequest&& request) = 0;
 
+    // Строки request ссылаются на buffer_ и действительны только во время вызова
+    virtual void HandleRequest(const RequestView& request) = 0;
+
     virtual std::shared_ptr<SessionBase> GetSharedThis() = 0;
 
     // tcp_stream содержит внутри себя сокет и добавляет поддержку таймаутов
@@ -77,12 +101,21 @@ public:
     }
 private:
     void HandleRequest(HttpRequest&& request) override {
+        request_handler_(std::move(request), MakeSender());
+    }
+
+    // Обработчик должен принимать как http::request, так и RequestView
+    void HandleRequest(const RequestView& request) override {
+        request_handler_(request, MakeSender());
+    }
+
+    auto MakeSender() {
         // Захватываем умный указатель на текущий объект Session в лямбде,
         // чтобы продлить время жизни сессии до вызова лямбды.
         // Используется generic-лямбда функция, способная принять response произвольного типа
-        request_handler_(std::move(request), [self = this->shared_from_this()](auto&& response) {
+        return [self = this->shared_from_this()](auto&& response) {
             self->Write(std::move(response));
-            });
+        };
     }
 
     std::shared_ptr<SessionBase> GetSharedThis() override {
@@ -1,12 +1,21 @@
 #include "sdk.h"
 //
 #include <boost/asio/signal_set.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <charconv>
+#include <fstream>
 #include <iostream>
+#include <memory>
 #include <mutex>
+#include <optional>
 #include <thread>
 #include <vector>
 
 #include "http_server.h"
+#include "sampling_profiler.h"
+#ifdef HELLO_ASYNC_IO_URING
+#include "uring_server.h"
+#endif
 
 namespace {
 namespace net = boost::asio;
@@ -27,44 +36,51 @@ struct ContentType {
     // При необходимости внутрь ContentType можно добавить и другие типы контента
 };
 
-// Создаёт StringResponse с заданными параметрами
-StringResponse MakeStringResponse(http::status status, std::string_view body, unsigned http_version,
-                                  bool keep_alive,
-                                  std::string_view content_type = ContentType::TEXT_HTML) {
-    StringResponse response(status, http_version);
-    response.set(http::field::content_type, content_type);
-    response.body() = body;
-    response.content_length(body.size());
-    response.keep_alive(keep_alive);
-    return response;
+// Создаёт ответ с заданными параметрами. Блок заголовков берётся из кэша, поэтому
+// поля ответа не формируются для каждого запроса заново
+http_server::PrebuiltResponse MakeStringResponse(
+    http_server::ResponseHeaderCache& header_cache, http::status status, std::string body,
+    unsigned http_version, bool keep_alive,
+    std::string_view content_type = ContentType::TEXT_HTML) {
+    return header_cache.MakeResponse(status, http_version, content_type, keep_alive,
+                                     std::move(body));
 }
 
-StringResponse HandleRequest(StringRequest&& req) {
+// Обрабатывает запрос и передаёт ответ в send. Запрос без тела сервер передаёт в виде
+// http_server::RequestView, остальные - в виде StringRequest
+template <typename Request, typename Send>
+void HandleRequest(http_server::ResponseHeaderCache& header_cache, const Request& req,
+                   Send&& send) {
     auto method = req.method();
-    std::string target = std::string(req.target()); // копируем в std::string для удобства
+    std::string_view target = req.target();
+    // Сэмплы профилировщика группируются по пути запроса без строки параметров
+    const std::string_view endpoint = target.substr(0, target.find('?'));
 
     // Удаляем ведущий символ '/' если он есть
     if (!target.empty() && target.front() == '/') {
-        target.erase(0, 1);
+        target.remove_prefix(1);
     }
 
     if (method == http::verb::get) {
+        profiler::RouteScope route{"GET", endpoint};
         // GET: тело "Hello, {target}"
-        std::string body = "Hello, " + target;
-        return MakeStringResponse(http::status::ok, std::string_view(body), req.version(), req.keep_alive());
+        std::string body = "Hello, "s.append(target);
+        send(MakeStringResponse(header_cache, http::status::ok, std::move(body), req.version(),
+                                req.keep_alive()));
     }
     else if (method == http::verb::head) {
+        profiler::RouteScope route{"HEAD", endpoint};
         // HEAD: заголовки как у GET, но тело пустое. Content-Length должен быть длиной GET-ответа.
-        std::string body = "Hello, " + target;
-        StringResponse response(http::status::ok, req.version());
-        response.set(http::field::content_type, ContentType::TEXT_HTML);
-        response.content_length(body.size());           // длина как для GET
-        response.keep_alive(req.keep_alive());
-        // тело остаётся пустым
-        return response;
+        const size_t content_length = "Hello, "sv.size() + target.size();
+        send(http_server::PrebuiltResponse{
+            header_cache.GetHeader(http::status::ok, req.version(), ContentType::TEXT_HTML,
+                                   req.keep_alive()),
+            content_length, {}, req.keep_alive()});
     }
     else {
-        // Любой другой метод -> 405 Method Not Allowed
+        profiler::RouteScope route{"method_not_allowed", endpoint};
+        // Любой другой метод -> 405 Method Not Allowed.
+        // Ответ содержит заголовок Allow, поэтому формируется без кэша
         constexpr std::string_view body = "Invalid method"sv; // длина 14
         StringResponse response(http::status::method_not_allowed, req.version());
         response.set(http::field::content_type, ContentType::TEXT_HTML);
@@ -72,7 +88,7 @@ StringResponse HandleRequest(StringRequest&& req) {
         response.body() = body;
         response.content_length(body.size());
         response.keep_alive(req.keep_alive());
-        return response;
+        send(std::move(response));
     }
 }
 
@@ -89,33 +105,171 @@ void RunWorkers(unsigned n, const Fn& fn) {
     fn();
 }
 
+// Параметры профилирования, заданные в командной строке
+struct ProfileArgs {
+    std::chrono::seconds duration;
+    std::string output = "profile.folded";
+};
+
+// Способ выполнения сетевого ввода-вывода
+enum class Backend {
+    // Реактор asio (epoll в Linux)
+    ASIO,
+    // Очереди io_uring, по серверу UringServer на поток
+    IO_URING,
+};
+
+struct Args {
+    // Если профилирование не запрошено, nullopt
+    std::optional<ProfileArgs> profile;
+    Backend backend = Backend::ASIO;
+};
+
+// Разбирает параметры --profile=<seconds>, --profile-output=<file> и --backend=asio|io_uring
+Args ParseArgs(int argc, const char* const argv[]) {
+    constexpr auto PROFILE = "--profile="sv;
+    constexpr auto PROFILE_OUTPUT = "--profile-output="sv;
+    constexpr auto BACKEND = "--backend="sv;
+
+    Args result;
+    std::optional<std::string> output;
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        if (arg.starts_with(BACKEND)) {
+            const auto value = arg.substr(BACKEND.size());
+            if (value == "asio"sv) {
+                result.backend = Backend::ASIO;
+#ifdef HELLO_ASYNC_IO_URING
+            } else if (value == "io_uring"sv) {
+                result.backend = Backend::IO_URING;
+#endif
+            } else {
+                throw std::invalid_argument("Unsupported backend: "s + std::string(value));
+            }
+        } else if (arg.starts_with(PROFILE)) {
+            const auto value = arg.substr(PROFILE.size());
+            unsigned seconds = 0;
+            const auto [end, ec] = std::from_chars(value.data(), value.data() + value.size(),
+                                                   seconds);
+            if (ec != std::errc{} || end != value.data() + value.size() || seconds == 0) {
+                throw std::invalid_argument("Invalid profiling duration: "s + std::string(value));
+            }
+            result.profile = ProfileArgs{std::chrono::seconds{seconds}};
+        } else if (arg.starts_with(PROFILE_OUTPUT)) {
+            output = arg.substr(PROFILE_OUTPUT.size());
+        } else {
+            throw std::invalid_argument("Unknown argument: "s + std::string(arg));
+        }
+    }
+    if (output) {
+        if (!result.profile) {
+            throw std::invalid_argument("--profile-output requires --profile");
+        }
+        result.profile->output = std::move(*output);
+    }
+    return result;
+}
+
 }  // namespace
 
-int main() {
+int main(int argc, const char* argv[]) {
+    Args args;
+    try {
+        args = ParseArgs(argc, argv);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        std::cerr << "Usage: hello_async [--profile=<seconds> [--profile-output=<file>]] "sv
+                     "[--backend=asio|io_uring]"sv
+                  << std::endl;
+        return EXIT_FAILURE;
+    }
+    const std::optional<ProfileArgs>& profile_args = args.profile;
+
     const unsigned num_threads = std::thread::hardware_concurrency();
 
+    // Кэш объявлен раньше io_context, так как ответы ссылаются на его блоки заголовков
+    http_server::ResponseHeaderCache header_cache;
+
     net::io_context ioc(num_threads);
 
+    // Профилировщик останавливается по таймеру, а стеки записываются при завершении сервера
+    profiler::SamplingProfiler sampling_profiler;
+    net::steady_timer profile_timer(ioc);
+    if (profile_args) {
+        sampling_profiler.Start(profile_args->duration);
+        profile_timer.expires_after(profile_args->duration);
+        profile_timer.async_wait([&sampling_profiler](const sys::error_code& ec) {
+            if (!ec) {
+                sampling_profiler.Stop();
+                std::cerr << "Profiling finished"sv << std::endl;
+            }
+        });
+    }
+
+    const auto address = net::ip::make_address("0.0.0.0");
+    constexpr net::ip::port_type port = 8080;
+    auto handler = [&header_cache](auto&& req, auto&& sender) {
+        HandleRequest(header_cache, std::forward<decltype(req)>(req),
+                      std::forward<decltype(sender)>(sender));
+    };
+
+#ifdef HELLO_ASYNC_IO_URING
+    // Серверы io_uring слушают один и тот же адрес, по одному на поток
+    std::vector<std::unique_ptr<http_server::UringServer<decltype(handler)>>> uring_servers;
+    if (args.backend == Backend::IO_URING) {
+        for (unsigned i = 0; i < std::max(1u, num_threads); ++i) {
+            uring_servers.push_back(std::make_unique<http_server::UringServer<decltype(handler)>>(
+                http_server::tcp::endpoint{address, port}, handler));
+        }
+    }
+#endif
+
     // Подписываемся на сигналы и при их получении завершаем работу сервера
     net::signal_set signals(ioc, SIGINT, SIGTERM);
-    signals.async_wait([&ioc](const sys::error_code& ec, [[maybe_unused]] int signal_number) {
+    signals.async_wait([&](const sys::error_code& ec, [[maybe_unused]] int signal_number) {
         if (!ec) {
             ioc.stop();
+#ifdef HELLO_ASYNC_IO_URING
+            for (auto& server : uring_servers) {
+                server->Stop();
+            }
+#endif
         }
     });
 
-    const auto address = net::ip::make_address("0.0.0.0");
-    constexpr net::ip::port_type port = 8080;
-    http_server::ServeHttp(ioc, {address, port}, [](auto&& req, auto&& sender) {
-         sender(HandleRequest(std::forward<decltype(req)>(req)));
-    });
+    if (args.backend == Backend::ASIO) {
+        http_server::ServeHttp(ioc, {address, port}, handler);
+    }
 
     // Эта надпись сообщает тестам о том, что сервер запущен и готов обрабатывать запросы
     std::cout << "Server has started..."sv << std::endl;
 
-    RunWorkers(num_threads, [&ioc] {
+    if (args.backend == Backend::ASIO) {
+        RunWorkers(num_threads, [&ioc] {
+            ioc.run();
+        });
+    }
+#ifdef HELLO_ASYNC_IO_URING
+    if (args.backend == Backend::IO_URING) {
+        // Текущий поток обрабатывает сигналы и таймер профилировщика
+        std::vector<std::jthread> workers;
+        for (auto& server : uring_servers) {
+            workers.emplace_back([&server] {
+                server->Run();
+            });
+        }
         ioc.run();
-    });
+    }
+#endif
+
+    if (profile_args) {
+        sampling_profiler.Stop();
+        std::ofstream out(profile_args->output);
+        sampling_profiler.WriteFoldedStacks(out);
+        std::cerr << "Profile: "sv << sampling_profiler.GetSampleCount() << " samples, "sv
+                  << sampling_profiler.GetDroppedCount() << " dropped, written to "sv
+                  << profile_args->output << std::endl;
+    }
 
     //std::cout << "Shutting down"sv << std::endl;
 }
@@ -0,0 +1,309 @@
+#include "request_parser.h"
+
+#include <boost/beast/core/string.hpp>
+#include <algorithm>
+#include <atomic>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define HTTP_SERVER_HAS_SSE42 1
+#include <nmmintrin.h>
+#endif
+
+namespace http_server {
+
+namespace beast = boost::beast;
+using namespace std::literals;
+
+namespace {
+
+// Совпадает с ограничением размера заголовков http::request_parser
+constexpr size_t MAX_HEADER_SIZE = 8 * 1024;
+
+// Класс символов, на которых останавливается поиск
+struct CharClass {
+    std::array<bool, 256> is_delimiter{};
+    // Границы диапазонов для pcmpestri, покрывающих все разделители. Диапазоны могут включать
+    // и допустимые символы, их отсеивает is_delimiter
+    alignas(16) std::array<char, 16> ranges{};
+    int ranges_size = 0;
+};
+
+template <typename Predicate>
+constexpr CharClass MakeCharClass(Predicate is_delimiter, std::string_view ranges) {
+    CharClass result;
+    for (int ch = 0; ch < 256; ++ch) {
+        result.is_delimiter[ch] = is_delimiter(static_cast<unsigned char>(ch));
+    }
+    std::copy(ranges.begin(), ranges.end(), result.ranges.begin());
+    result.ranges_size = static_cast<int>(ranges.size());
+    return result;
+}
+
+constexpr bool IsTokenChar(unsigned char ch) {
+    const unsigned char lower = ch | 0x20;
+    return (ch >= '0' && ch <= '9') || (lower >= 'a' && lower <= 'z')
+           || "!#$%&'*+-.^_`|~"sv.find(static_cast<char>(ch)) != std::string_view::npos;
+}
+
+// Символы метода и имени заголовка (token из RFC 9110)
+constexpr CharClass TOKEN = MakeCharClass(
+    [](unsigned char ch) {
+        return !IsTokenChar(ch);
+    },
+    "\x00\x20\"\"(),,//:@[]{\xff"sv);
+
+// Символы цели запроса: видимые символы ASCII
+constexpr CharClass TARGET = MakeCharClass(
+    [](unsigned char ch) {
+        return ch <= 0x20 || ch >= 0x7f;
+    },
+    "\x00\x20\x7f\xff"sv);
+
+// Символы значения заголовка: видимые символы, пробел, табуляция и obs-text
+constexpr CharClass VALUE = MakeCharClass(
+    [](unsigned char ch) {
+        return (ch < 0x20 && ch != '\t') || ch == 0x7f;
+    },
+    "\x00\x08\x0a\x1f\x7f\x7f"sv);
+
+#ifdef HTTP_SERVER_HAS_SSE42
+
+bool HasSse42() noexcept {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("sse4.2");
+}
+
+const bool CPU_HAS_SSE42 = HasSse42();
+std::atomic<bool> simd_enabled{CPU_HAS_SSE42};
+
+// Проверяет по 16 символов за инструкцию. Возвращает первый символ, попадающий в диапазоны
+// char_class, или начало остатка короче 16 байт
+__attribute__((target("sse4.2"))) const char* FindCandidateSse42(
+    const char* p, const char* end, const CharClass& char_class) noexcept {
+    const __m128i ranges =
+        _mm_load_si128(reinterpret_cast<const __m128i*>(char_class.ranges.data()));
+    for (; end - p >= 16; p += 16) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        const int index = _mm_cmpestri(ranges, char_class.ranges_size, chunk, 16,
+                                       _SIDD_UBYTE_OPS | _SIDD_CMP_RANGES
+                                           | _SIDD_LEAST_SIGNIFICANT);
+        if (index != 16) {
+            return p + index;
+        }
+    }
+    return p;
+}
+
+#endif
+
+// Возвращает первый разделитель из [p, end) или end
+const char* FindDelimiter(const char* p, const char* end, const CharClass& char_class) noexcept {
+    while (p != end) {
+#ifdef HTTP_SERVER_HAS_SSE42
+        if (end - p >= 16 && simd_enabled.load(std::memory_order_relaxed)) {
+            p = FindCandidateSse42(p, end, char_class);
+            if (p == end) {
+                break;
+            }
+        }
+#endif
+        if (char_class.is_delimiter[static_cast<unsigned char>(*p)]) {
+            return p;
+        }
+        ++p;
+    }
+    return end;
+}
+
+enum class Match { FULL, PARTIAL, NONE };
+
+// Сравнивает начало [p, end) со строкой expected. PARTIAL означает, что данных не хватило
+Match MatchPrefix(const char* p, const char* end, std::string_view expected) noexcept {
+    const size_t size = std::min(expected.size(), static_cast<size_t>(end - p));
+    if (!std::equal(p, p + size, expected.begin())) {
+        return Match::NONE;
+    }
+    return size == expected.size() ? Match::FULL : Match::PARTIAL;
+}
+
+// Вызывает fn для каждого элемента списка через запятую без окружающих пробелов
+template <typename Fn>
+void ForEachListItem(std::string_view list, Fn&& fn) {
+    while (!list.empty()) {
+        const size_t comma = list.find(',');
+        std::string_view item = list.substr(0, comma);
+        list.remove_prefix(comma == std::string_view::npos ? list.size() : comma + 1);
+        while (!item.empty() && (item.front() == ' ' || item.front() == '\t')) {
+            item.remove_prefix(1);
+        }
+        while (!item.empty() && (item.back() == ' ' || item.back() == '\t')) {
+            item.remove_suffix(1);
+        }
+        fn(item);
+    }
+}
+
+// Проверяет, что элементы списка - token, как это делает beast для Connection
+bool IsTokenList(std::string_view list) noexcept {
+    bool valid = true;
+    ForEachListItem(list, [&valid](std::string_view item) {
+        valid = valid && std::all_of(item.begin(), item.end(), [](char ch) {
+                    return !TOKEN.is_delimiter[static_cast<unsigned char>(ch)];
+                });
+    });
+    return valid;
+}
+
+// Проверяет, содержит ли список через запятую элемент token без учёта регистра
+bool HasToken(std::string_view list, std::string_view token) noexcept {
+    bool found = false;
+    ForEachListItem(list, [&found, token](std::string_view item) {
+        found = found || beast::iequals(item, token);
+    });
+    return found;
+}
+
+}  // namespace
+
+struct RequestParser {
+    static ParseResult Parse(std::string_view input, RequestView& request) noexcept {
+        const char* p = input.data();
+        const char* const end = p + std::min(input.size(), MAX_HEADER_SIZE);
+        // Заголовки, не уместившиеся в ограничение, разбирает beast, сообщая об ошибке
+        const ParseResult incomplete{input.size() < MAX_HEADER_SIZE ? ParseStatus::INCOMPLETE
+                                                                    : ParseStatus::UNSUPPORTED};
+        constexpr ParseResult unsupported{ParseStatus::UNSUPPORTED};
+
+        // Строка запроса: метод, цель и версия через одиночные пробелы
+        const char* const method_end = FindDelimiter(p, end, TOKEN);
+        if (method_end == end) {
+            return incomplete;
+        }
+        if (*method_end != ' ' || method_end == p) {
+            return unsupported;
+        }
+        request.method_string_ = {p, method_end};
+        request.method_ = http::string_to_verb(request.method_string_);
+        p = method_end + 1;
+
+        const char* const target_end = FindDelimiter(p, end, TARGET);
+        if (target_end == end) {
+            return incomplete;
+        }
+        if (*target_end != ' ' || target_end == p) {
+            return unsupported;
+        }
+        request.target_ = {p, target_end};
+        p = target_end + 1;
+
+        switch (MatchPrefix(p, end, "HTTP/1."sv)) {
+            case Match::NONE:
+                return unsupported;
+            case Match::PARTIAL:
+                return incomplete;
+            case Match::FULL:
+                p += "HTTP/1."sv.size();
+        }
+        if (p == end) {
+            return incomplete;
+        }
+        if (*p != '0' && *p != '1') {
+            return unsupported;
+        }
+        request.version_ = *p == '1' ? 11 : 10;
+        ++p;
+
+        std::string_view connection;
+        request.num_headers_ = 0;
+        while (true) {
+            switch (MatchPrefix(p, end, "\r\n"sv)) {
+                case Match::NONE:
+                    return unsupported;
+                case Match::PARTIAL:
+                    return incomplete;
+                case Match::FULL:
+                    p += 2;
+            }
+            if (p == end) {
+                return incomplete;
+            }
+            if (*p == '\r') {
+                // Пустая строка завершает заголовки
+                if (end - p < 2) {
+                    return incomplete;
+                }
+                if (p[1] != '\n') {
+                    return unsupported;
+                }
+                p += 2;
+                break;
+            }
+
+            // Продолжение значения на следующей строке (obs-fold) также не является token
+            const char* const name_end = FindDelimiter(p, end, TOKEN);
+            if (name_end == end) {
+                return incomplete;
+            }
+            if (*name_end != ':' || name_end == p
+                || request.num_headers_ == RequestView::MAX_HEADERS) {
+                return unsupported;
+            }
+            const std::string_view name{p, name_end};
+            p = name_end + 1;
+            while (p != end && (*p == ' ' || *p == '\t')) {
+                ++p;
+            }
+            const char* const value_end = FindDelimiter(p, end, VALUE);
+            if (value_end == end) {
+                return incomplete;
+            }
+            const char* value_last = value_end;
+            while (value_last != p && (value_last[-1] == ' ' || value_last[-1] == '\t')) {
+                --value_last;
+            }
+            const std::string_view value{p, value_last};
+            p = value_end;
+
+            if (beast::iequals(name, "content-length"sv)) {
+                if (value != "0"sv) {
+                    return unsupported;
+                }
+            } else if (beast::iequals(name, "transfer-encoding"sv)) {
+                return unsupported;
+            } else if (beast::iequals(name, "connection"sv)) {
+                if (!connection.empty() || !IsTokenList(value)) {
+                    return unsupported;
+                }
+                connection = value;
+            } else if (beast::iequals(name, "proxy-connection"sv) && !IsTokenList(value)) {
+                return unsupported;
+            }
+            request.headers_[request.num_headers_++] = {name, value};
+        }
+
+        request.keep_alive_ = request.version_ == 11 ? !HasToken(connection, "close"sv)
+                                                     : HasToken(connection, "keep-alive"sv);
+        return {ParseStatus::COMPLETE, static_cast<size_t>(p - input.data())};
+    }
+};
+
+std::string_view RequestView::operator[](std::string_view name) const noexcept {
+    for (const HeaderView& header : headers()) {
+        if (beast::iequals(header.name, name)) {
+            return header.value;
+        }
+    }
+    return {};
+}
+
+ParseResult ParseRequest(std::string_view input, RequestView& request) noexcept {
+    return RequestParser::Parse(input, request);
+}
+
+void SetSimdEnabled([[maybe_unused]] bool enabled) noexcept {
+#ifdef HTTP_SERVER_HAS_SSE42
+    simd_enabled = enabled && CPU_HAS_SSE42;
+#endif
+}
+
+}  // namespace http_server
@@ -0,0 +1,103 @@
+#pragma once
+// boost.beast будет использовать std::string_view вместо boost::string_view
+#define BOOST_BEAST_USE_STD_STRING_VIEW
+
+#include <boost/beast/http/field.hpp>
+#include <boost/beast/http/verb.hpp>
+#include <array>
+#include <span>
+#include <string_view>
+
+namespace http_server {
+
+namespace http = boost::beast::http;
+
+// Заголовок запроса. Строки ссылаются на буфер, из которого разобран запрос
+struct HeaderView {
+    std::string_view name;
+    std::string_view value;
+};
+
+/*
+Запрос без тела, разобранный ParseRequest. Строки запроса ссылаются на буфер с прочитанными
+данными и действительны, пока буфер не изменён, то есть только во время вызова обработчика.
+Методы повторяют методы http::request, которыми пользуется обработчик запросов, поэтому
+обработчик может принимать оба вида запросов через параметр шаблона.
+*/
+class RequestView {
+public:
+    static constexpr size_t MAX_HEADERS = 32;
+
+    http::verb method() const noexcept {
+        return method_;
+    }
+
+    std::string_view method_string() const noexcept {
+        return method_string_;
+    }
+
+    std::string_view target() const noexcept {
+        return target_;
+    }
+
+    // 10 для HTTP/1.0 и 11 для HTTP/1.1
+    unsigned version() const noexcept {
+        return version_;
+    }
+
+    bool keep_alive() const noexcept {
+        return keep_alive_;
+    }
+
+    // Значение первого заголовка с именем name (без учёта регистра) или пустая строка
+    std::string_view operator[](std::string_view name) const noexcept;
+
+    std::string_view operator[](http::field name) const noexcept {
+        return (*this)[http::to_string(name)];
+    }
+
+    std::span<const HeaderView> headers() const noexcept {
+        return {headers_.data(), num_headers_};
+    }
+
+private:
+    friend struct RequestParser;
+
+    http::verb method_ = http::verb::unknown;
+    std::string_view method_string_;
+    std::string_view target_;
+    unsigned version_ = 11;
+    bool keep_alive_ = true;
+    std::array<HeaderView, MAX_HEADERS> headers_;
+    size_t num_headers_ = 0;
+};
+
+enum class ParseStatus {
+    // Запрос разобран
+    COMPLETE,
+    // Запрос прочитан не полностью
+    INCOMPLETE,
+    // Запрос нужно разобрать средствами beast
+    UNSUPPORTED,
+};
+
+struct ParseResult {
+    ParseStatus status;
+    // Размер разобранного запроса в байтах
+    size_t size = 0;
+};
+
+/*
+Разбирает запрос в начале input без копирования и выделения памяти, по образцу picohttpparser.
+Разделители в строке запроса и заголовках ищутся инструкцией SSE4.2 pcmpestri по 16 байт за
+раз, если процессор её поддерживает. Разбираются только запросы HTTP/1.0 и HTTP/1.1 без тела
+с не более чем MAX_HEADERS заголовками. Для запросов с телом, некорректных или необычных
+запросов (например, с переносом строки без CR) возвращается UNSUPPORTED, и такой запрос, а
+также ошибку в нём, обрабатывает beast.
+*/
+ParseResult ParseRequest(std::string_view input, RequestView& request) noexcept;
+
+// Разрешает или запрещает использование SSE4.2. Нужно для сравнения в бенчмарке
+void SetSimdEnabled(bool enabled) noexcept;
+
+}  // namespace http_server
@@ -0,0 +1,110 @@
+// boost.beast будет использовать std::string_view вместо boost::string_view
+#define BOOST_BEAST_USE_STD_STRING_VIEW
+
+#include <boost/beast/core.hpp>
+#include <boost/beast/http.hpp>
+#include <charconv>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+#include "response_cache.h"
+
+namespace {
+
+namespace net = boost::asio;
+namespace beast = boost::beast;
+namespace http = beast::http;
+using namespace std::literals;
+using Clock = std::chrono::steady_clock;
+
+constexpr std::string_view TEXT_HTML = "text/html"sv;
+
+unsigned ParseArg(int argc, const char* argv[], int index, unsigned default_value) {
+    if (argc <= index) {
+        return default_value;
+    }
+    const std::string_view arg = argv[index];
+    unsigned value = 0;
+    const auto [end, ec] = std::from_chars(arg.data(), arg.data() + arg.size(), value);
+    if (ec != std::errc{} || end != arg.data() + arg.size()) {
+        throw std::invalid_argument("Invalid argument: "s + std::string(arg));
+    }
+    return value;
+}
+
+// Копирует последовательность буферов в out, как это сделала бы запись в сокет
+template <typename ConstBufferSequence>
+void Append(std::string& out, const ConstBufferSequence& buffers) {
+    for (auto it = net::buffer_sequence_begin(buffers); it != net::buffer_sequence_end(buffers);
+         ++it) {
+        const net::const_buffer buffer = *it;
+        out.append(static_cast<const char*>(buffer.data()), buffer.size());
+    }
+}
+
+// Ответ собирается через http::response и сериализуется http::serializer, как в http::write
+void WriteStringResponse(std::string_view body, bool keep_alive, std::string& out) {
+    http::response<http::string_body> response(http::status::ok, 11);
+    response.set(http::field::content_type, TEXT_HTML);
+    response.body() = body;
+    response.content_length(body.size());
+    response.keep_alive(keep_alive);
+
+    http::response_serializer<http::string_body> serializer{response};
+    beast::error_code ec;
+    while (!serializer.is_done()) {
+        size_t size = 0;
+        serializer.next(ec, [&out, &size](beast::error_code&, const auto& buffers) {
+            Append(out, buffers);
+            size = net::buffer_size(buffers);
+        });
+        serializer.consume(size);
+    }
+}
+
+void WritePrebuiltResponse(http_server::ResponseHeaderCache& cache, std::string_view body,
+                           bool keep_alive, std::string& out) {
+    const auto response =
+        cache.MakeResponse(http::status::ok, 11, TEXT_HTML, keep_alive, std::string(body));
+    Append(out, response.GetBuffers());
+}
+
+template <typename Fn>
+void Measure(std::string_view name, unsigned iterations, const Fn& write_response) {
+    std::string out;
+    size_t total_size = 0;
+    const auto start = Clock::now();
+    for (unsigned i = 0; i < iterations; ++i) {
+        out.clear();
+        // Тело меняется от ответа к ответу, как у "Hello, {target}"
+        write_response("Hello, "sv.substr(0, 5 + i % 3), i % 8 != 0, out);
+        total_size += out.size();
+    }
+    const double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    std::cout << name << ": "sv << ns / iterations << " ns/response ("sv << total_size
+              << " bytes)"sv << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, const char* argv[]) {
+    try {
+        // hello_async_response_benchmark [<iterations>]
+        const unsigned iterations = ParseArg(argc, argv, 1, 2'000'000);
+
+        Measure("http::response + serializer"sv, iterations,
+                [](std::string_view body, bool keep_alive, std::string& out) {
+                    WriteStringResponse(body, keep_alive, out);
+                });
+        http_server::ResponseHeaderCache cache;
+        Measure("cached header block"sv, iterations,
+                [&cache](std::string_view body, bool keep_alive, std::string& out) {
+                    WritePrebuiltResponse(cache, body, keep_alive, out);
+                });
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,84 @@
+#include "response_cache.h"
+
+#include <boost/beast/http/empty_body.hpp>
+#include <boost/beast/http/message.hpp>
+#include <boost/beast/http/write.hpp>
+#include <charconv>
+#include <functional>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+
+namespace http_server {
+
+using namespace std::literals;
+
+PrebuiltResponse::PrebuiltResponse(const HeaderBlock& header, size_t content_length,
+                                   std::string body, bool keep_alive)
+    : header_{&header}
+    , body_{std::move(body)}
+    , keep_alive_{keep_alive} {
+    char* const begin = content_length_.data();
+    char* const end = std::to_chars(begin, begin + content_length_.size(), content_length).ptr;
+    content_length_size_ = static_cast<size_t>(end - begin);
+}
+
+size_t ResponseHeaderCache::KeyHasher::operator()(const Key& key) const noexcept {
+    size_t hash = std::hash<std::string_view>{}(key.content_type);
+    hash = hash * 37 + static_cast<size_t>(key.status);
+    hash = hash * 37 + key.http_version;
+    return hash * 2 + key.keep_alive;
+}
+
+const HeaderBlock& ResponseHeaderCache::GetHeader(http::status status, unsigned http_version,
+                                                  std::string_view content_type,
+                                                  bool keep_alive) {
+    const Key key{status, http_version, keep_alive, content_type};
+    {
+        std::shared_lock lock{mutex_};
+        if (auto it = headers_.find(key); it != headers_.end()) {
+            return it->second;
+        }
+    }
+
+    HeaderBlock header = SerializeHeader(status, http_version, content_type, keep_alive);
+    std::unique_lock lock{mutex_};
+    // Пока блокировка не была захвачена, блок мог добавить другой поток
+    if (auto it = headers_.find(key); it != headers_.end()) {
+        return it->second;
+    }
+    const std::string& stored_content_type = content_types_.emplace_back(content_type);
+    Key stored_key{status, http_version, keep_alive, stored_content_type};
+    return headers_.emplace(stored_key, std::move(header)).first->second;
+}
+
+size_t ResponseHeaderCache::GetSize() const {
+    std::shared_lock lock{mutex_};
+    return headers_.size();
+}
+
+HeaderBlock ResponseHeaderCache::SerializeHeader(http::status status, unsigned http_version,
+                                                 std::string_view content_type,
+                                                 bool keep_alive) {
+    // Заголовки формирует beast в том же порядке, что и MakeStringResponse, поэтому ответы
+    // побайтно совпадают с ответами, собранными через http::response
+    http::response<http::empty_body> response{status, http_version};
+    response.set(http::field::content_type, content_type);
+    response.content_length(0);
+    response.keep_alive(keep_alive);
+
+    std::ostringstream out;
+    out << response.base();
+    HeaderBlock result{out.str()};
+    // Значение-заглушку 0 вырезаем, запоминая его позицию
+    constexpr auto CONTENT_LENGTH = "\r\nContent-Length: 0"sv;
+    const size_t pos = result.text.find(CONTENT_LENGTH);
+    if (pos == std::string::npos) {
+        throw std::logic_error("Content-Length is missing in the serialized header");
+    }
+    result.content_length_pos = pos + CONTENT_LENGTH.size() - 1;
+    result.text.erase(result.content_length_pos, 1);
+    return result;
+}
+
+}  // namespace http_server
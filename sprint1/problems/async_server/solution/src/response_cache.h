@@ -0,0 +1,114 @@
+#pragma once
+// boost.beast будет использовать std::string_view вместо boost::string_view
+#define BOOST_BEAST_USE_STD_STRING_VIEW
+
+#include <boost/asio/buffer.hpp>
+#include <boost/beast/http/status.hpp>
+#include <array>
+#include <deque>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace http_server {
+
+namespace net = boost::asio;
+namespace http = boost::beast::http;
+
+// Сериализованные заголовки ответа без значения Content-Length
+struct HeaderBlock {
+    std::string text;
+    // Позиция в text, куда вставляется значение Content-Length
+    size_t content_length_pos = 0;
+};
+
+/*
+Ответ с заранее сформированным блоком заголовков.
+Отправляется одной операцией записи из четырёх буферов: части блока заголовков до значения
+Content-Length, самого значения, оставшейся части блока и тела. Объект http::response и его
+поля при этом не создаются.
+*/
+class PrebuiltResponse {
+public:
+    // header - блок заголовков из ResponseHeaderCache.
+    // Для ответа на HEAD content_length может не совпадать с размером body
+    PrebuiltResponse(const HeaderBlock& header, size_t content_length, std::string body,
+                     bool keep_alive);
+
+    // Буферы ссылаются на сам объект, поэтому его нельзя перемещать до окончания записи
+    std::array<net::const_buffer, 4> GetBuffers() const noexcept {
+        const std::string& text = header_->text;
+        const size_t pos = header_->content_length_pos;
+        return {net::buffer(text.data(), pos),
+                net::buffer(content_length_.data(), content_length_size_),
+                net::buffer(text.data() + pos, text.size() - pos), net::buffer(body_)};
+    }
+
+    bool need_eof() const noexcept {
+        return !keep_alive_;
+    }
+
+private:
+    const HeaderBlock* header_;
+    // Десятичная запись Content-Length
+    std::array<char, 20> content_length_;
+    size_t content_length_size_ = 0;
+    std::string body_;
+    bool keep_alive_;
+};
+
+/*
+Кэш блоков заголовков ответа.
+Блок для каждого сочетания статуса, версии HTTP, Content-Type и keep-alive сериализуется
+средствами beast один раз при первом обращении и далее используется повторно. Поиск в кэше
+не выделяет память. Методы класса можно вызывать из разных потоков. Кэш должен существовать,
+пока отправляются созданные им ответы.
+*/
+class ResponseHeaderCache {
+public:
+    ResponseHeaderCache() = default;
+
+    ResponseHeaderCache(const ResponseHeaderCache&) = delete;
+    ResponseHeaderCache& operator=(const ResponseHeaderCache&) = delete;
+
+    const HeaderBlock& GetHeader(http::status status, unsigned http_version,
+                                 std::string_view content_type, bool keep_alive);
+
+    // Создаёт ответ с телом body и Content-Length, равным размеру body
+    PrebuiltResponse MakeResponse(http::status status, unsigned http_version,
+                                  std::string_view content_type, bool keep_alive,
+                                  std::string body) {
+        const size_t content_length = body.size();
+        return PrebuiltResponse{GetHeader(status, http_version, content_type, keep_alive),
+                                content_length, std::move(body), keep_alive};
+    }
+
+    // Количество сформированных блоков заголовков
+    size_t GetSize() const;
+
+private:
+    struct Key {
+        http::status status;
+        unsigned http_version;
+        bool keep_alive;
+        // Указывает на строку из content_types_
+        std::string_view content_type;
+
+        bool operator==(const Key&) const = default;
+    };
+
+    struct KeyHasher {
+        size_t operator()(const Key& key) const noexcept;
+    };
+
+    static HeaderBlock SerializeHeader(http::status status, unsigned http_version,
+                                       std::string_view content_type, bool keep_alive);
+
+    mutable std::shared_mutex mutex_;
+    std::unordered_map<Key, HeaderBlock, KeyHasher> headers_;
+    // Копии значений Content-Type, на которые ссылаются ключи. Элементы deque не перемещаются
+    std::deque<std::string> content_types_;
+};
+
+}  // namespace http_server
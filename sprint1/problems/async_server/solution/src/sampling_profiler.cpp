@@ -0,0 +1,286 @@
+#include "sampling_profiler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+#ifndef _WIN32
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <signal.h>
+#include <sys/time.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#endif
+
+namespace profiler {
+
+namespace {
+
+// Глубина сохраняемого стека. Более глубокие стеки обрезаются со стороны main
+constexpr size_t MAX_DEPTH = 32;
+// Максимальный размер буфера сэмплов (около 20 МБ)
+constexpr size_t MAX_SAMPLES = size_t{1} << 16;
+// Максимальная длина сохраняемой точки входа. Более длинные пути обрезаются
+constexpr size_t MAX_ENDPOINT = 64;
+
+struct Sample {
+    std::atomic<bool> ready{false};
+    std::uint8_t depth = 0;
+    std::uint8_t endpoint_size = 0;
+    const char* route = nullptr;
+    // Путь копируется, так как буфер запроса освобождается раньше, чем выводятся стеки
+    char endpoint[MAX_ENDPOINT];
+    void* frames[MAX_DEPTH];
+};
+
+// Состояние, доступное обработчику сигнала
+struct SampleBuffer {
+    std::unique_ptr<Sample[]> samples;
+    size_t capacity = 0;
+    std::atomic<size_t> next{0};
+    std::atomic<std::uint64_t> dropped{0};
+    std::atomic<bool> active{false};
+    // Количество обработчиков сигнала, выполняющихся в данный момент
+    std::atomic<int> handlers_running{0};
+};
+
+static_assert(std::atomic<size_t>::is_always_lock_free);
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free);
+
+SampleBuffer g_buffer;
+std::atomic<bool> g_profiler_exists{false};
+thread_local const char* t_route = nullptr;
+// Точка входа хранится указателем и длиной: у string_view в thread_local переменной
+// обработчику сигнала пришлось бы проверять инициализацию
+thread_local const char* t_endpoint = nullptr;
+thread_local size_t t_endpoint_size = 0;
+
+#ifndef _WIN32
+
+struct sigaction g_prev_action;
+
+// Обработчик SIGPROF. Использует только атомарные операции и заранее выделенную память
+void OnProfSignal(int) {
+    const int saved_errno = errno;
+    // Пара «запись handlers_running, затем чтение active» здесь и обратная пара в Stop
+    // образуют рукопожатие Деккера. Acquire/release не упорядочивает запись перед
+    // последующим чтением, поэтому все четыре операции выполняются с seq_cst: тогда либо
+    // обработчик увидит active == false, либо Stop увидит его в handlers_running
+    g_buffer.handlers_running.fetch_add(1, std::memory_order_seq_cst);
+
+    if (g_buffer.active.load(std::memory_order_seq_cst)) {
+        const size_t index = g_buffer.next.fetch_add(1, std::memory_order_relaxed);
+        if (index < g_buffer.capacity) {
+            // Первые два кадра - сам обработчик и кадр ядра, вызвавший его
+            constexpr int SKIP_FRAMES = 2;
+            void* frames[MAX_DEPTH + SKIP_FRAMES];
+            const int depth = std::max(backtrace(frames, std::size(frames)) - SKIP_FRAMES, 0);
+
+            Sample& sample = g_buffer.samples[index];
+            std::copy_n(frames + SKIP_FRAMES, depth, sample.frames);
+            sample.depth = static_cast<std::uint8_t>(depth);
+            sample.route = t_route;
+            const size_t endpoint_size = std::min(t_endpoint_size, MAX_ENDPOINT);
+            std::copy_n(t_endpoint, endpoint_size, sample.endpoint);
+            sample.endpoint_size = static_cast<std::uint8_t>(endpoint_size);
+            sample.ready.store(true, std::memory_order_release);
+        } else {
+            g_buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    g_buffer.handlers_running.fetch_sub(1, std::memory_order_release);
+    errno = saved_errno;
+}
+
+std::string Symbolize(void* address) {
+    // Адрес возврата указывает на инструкцию после вызова. Чтобы попасть в вызывающую
+    // функцию, ищем символ для предыдущего байта
+    const auto* lookup = static_cast<const char*>(address) - 1;
+
+    Dl_info info{};
+    if (dladdr(lookup, &info) && info.dli_sname) {
+        int status = 0;
+        std::unique_ptr<char, decltype(&std::free)> demangled{
+            abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status), &std::free};
+        return status == 0 && demangled ? demangled.get() : info.dli_sname;
+    }
+
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%p", address);
+    if (info.dli_fname) {
+        std::string module = info.dli_fname;
+        return module.substr(module.find_last_of('/') + 1) + "@" + buffer;
+    }
+    return buffer;
+}
+
+#endif
+
+}  // namespace
+
+SamplingProfiler::~SamplingProfiler() {
+    Stop();
+    if (g_buffer.samples) {
+        g_buffer.samples.reset();
+        g_buffer.capacity = 0;
+        g_profiler_exists = false;
+    }
+}
+
+void SamplingProfiler::Start(std::chrono::seconds duration, unsigned frequency) {
+#ifdef _WIN32
+    throw std::runtime_error("Sampling profiler is not supported on this platform");
+#else
+    if (frequency == 0 || frequency > 1'000'000) {
+        throw std::invalid_argument("Invalid sampling frequency");
+    }
+    if (g_profiler_exists.exchange(true)) {
+        throw std::logic_error("Sampling profiler has already been started");
+    }
+
+    // Первый вызов backtrace загружает библиотеку раскрутки стека и выделяет память.
+    // Делаем это заранее, чтобы в обработчике сигнала это не происходило
+    void* dummy[1];
+    backtrace(dummy, 1);
+
+    const size_t threads = std::max(1u, std::thread::hardware_concurrency());
+    const auto expected_samples =
+        static_cast<size_t>(std::max<std::int64_t>(duration.count(), 1)) * frequency * threads;
+    g_buffer.capacity = std::min(expected_samples, MAX_SAMPLES);
+    g_buffer.samples = std::make_unique<Sample[]>(g_buffer.capacity);
+    g_buffer.next = 0;
+    g_buffer.dropped = 0;
+
+    struct sigaction action{};
+    action.sa_handler = OnProfSignal;
+    action.sa_flags = SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    if (sigaction(SIGPROF, &action, &g_prev_action) != 0) {
+        throw std::runtime_error("Failed to install SIGPROF handler");
+    }
+    g_buffer.active.store(true, std::memory_order_release);
+
+    const auto interval_us = static_cast<suseconds_t>(1'000'000 / frequency);
+    itimerval timer{};
+    timer.it_interval.tv_sec = interval_us / 1'000'000;
+    timer.it_interval.tv_usec = interval_us % 1'000'000;
+    timer.it_value = timer.it_interval;
+    if (setitimer(ITIMER_PROF, &timer, nullptr) != 0) {
+        g_buffer.active = false;
+        sigaction(SIGPROF, &g_prev_action, nullptr);
+        throw std::runtime_error("Failed to start profiling timer");
+    }
+    running_ = true;
+#endif
+}
+
+void SamplingProfiler::Stop() {
+#ifndef _WIN32
+    if (!running_) {
+        return;
+    }
+    running_ = false;
+
+    itimerval timer{};
+    setitimer(ITIMER_PROF, &timer, nullptr);
+    // Упорядочено с проверкой в OnProfSignal, см. комментарий там
+    g_buffer.active.store(false, std::memory_order_seq_cst);
+    // Сигнал, сгенерированный до остановки таймера, может ещё ожидать доставки. Обычно прежнее
+    // действие - SIG_DFL, и такой сигнал завершил бы процесс. Установка SIG_IGN отбрасывает
+    // ожидающие сигналы, после чего прежнее действие можно восстановить
+    struct sigaction ignore{};
+    ignore.sa_handler = SIG_IGN;
+    sigemptyset(&ignore.sa_mask);
+    sigaction(SIGPROF, &ignore, nullptr);
+    // Дожидаемся завершения обработчиков, которые уже начали выполняться в других потоках
+    while (g_buffer.handlers_running.load(std::memory_order_seq_cst) != 0) {
+        std::this_thread::yield();
+    }
+    sigaction(SIGPROF, &g_prev_action, nullptr);
+#endif
+}
+
+std::uint64_t SamplingProfiler::GetSampleCount() const noexcept {
+    return std::min(g_buffer.next.load(std::memory_order_relaxed), g_buffer.capacity);
+}
+
+std::uint64_t SamplingProfiler::GetDroppedCount() const noexcept {
+    return g_buffer.dropped.load(std::memory_order_relaxed);
+}
+
+void SamplingProfiler::WriteFoldedStacks(std::ostream& out) const {
+#ifndef _WIN32
+    std::unordered_map<void*, std::string> symbols;
+    std::map<std::string, std::uint64_t> stacks;
+
+    const size_t count = GetSampleCount();
+    for (size_t i = 0; i < count; ++i) {
+        const Sample& sample = g_buffer.samples[i];
+        if (!sample.ready.load(std::memory_order_acquire)) {
+            continue;
+        }
+
+        std::string stack = sample.route ? sample.route : "[untagged]";
+        if (sample.endpoint_size > 0) {
+            stack += ' ';
+            stack.append(sample.endpoint, sample.endpoint_size);
+            std::replace(stack.begin(), stack.end(), ';', ':');
+        }
+        // Кадры сохранены от вызываемой функции к вызывающей, а в folded stacks
+        // они перечисляются начиная с корня
+        for (size_t frame = sample.depth; frame-- > 0;) {
+            auto [it, inserted] = symbols.try_emplace(sample.frames[frame]);
+            if (inserted) {
+                it->second = Symbolize(sample.frames[frame]);
+                // Символ ; разделяет кадры в формате folded stacks
+                std::replace(it->second.begin(), it->second.end(), ';', ':');
+            }
+            stack += ';';
+            stack += it->second;
+        }
+        ++stacks[std::move(stack)];
+    }
+
+    for (const auto& [stack, samples] : stacks) {
+        out << stack << ' ' << samples << '\n';
+    }
+    out.flush();
+#endif
+}
+
+RouteScope::RouteScope(const char* route, std::string_view endpoint) noexcept
+    : prev_route_{t_route}
+    , prev_endpoint_{t_endpoint, t_endpoint_size} {
+    // Сначала обнуляем длину, чтобы обработчик сигнала не прочитал новый указатель
+    // со старой длиной
+    t_endpoint_size = 0;
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+    t_endpoint = endpoint.data();
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+    t_endpoint_size = endpoint.size();
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+    t_route = route;
+}
+
+RouteScope::~RouteScope() {
+    t_route = prev_route_;
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+    t_endpoint_size = 0;
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+    t_endpoint = prev_endpoint_.data();
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+    t_endpoint_size = prev_endpoint_.size();
+}
+
+}  // namespace profiler
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <string_view>
+
+namespace profiler {
+
+/*
+ * Встроенный сэмплирующий профилировщик для окружений, где нет perf.
+ * По сигналу SIGPROF, который ядро посылает процессу через равные интервалы процессорного
+ * времени, обработчик сохраняет стек вызовов прерванного потока в заранее выделенный буфер.
+ * Запись в буфер не использует блокировок и не выделяет память.
+ * После остановки стеки можно сохранить в формате folded stacks, из которого flamegraph.pl
+ * строит flame graph:
+ *
+ * route endpoint;main;RunWorkers;...;HandleRequest 42
+ *
+ * Для читаемых имён функций исполняемый файл нужно собирать с флагом -rdynamic.
+ * Одновременно может работать только один профилировщик.
+ */
+class SamplingProfiler {
+public:
+    // Частота сэмплирования по умолчанию. Нечётное значение снижает вероятность
+    // синхронизации с периодическими процессами в программе
+    static constexpr unsigned DEFAULT_FREQUENCY = 199;
+
+    SamplingProfiler() = default;
+    ~SamplingProfiler();
+
+    SamplingProfiler(const SamplingProfiler&) = delete;
+    SamplingProfiler& operator=(const SamplingProfiler&) = delete;
+
+    // Начинает сэмплирование. Размер буфера рассчитывается так, чтобы вместить сэмплы
+    // всех потоков за время duration
+    void Start(std::chrono::seconds duration, unsigned frequency = DEFAULT_FREQUENCY);
+
+    // Прекращает сэмплирование. Безопасно вызывать повторно
+    void Stop();
+
+    bool IsRunning() const noexcept {
+        return running_;
+    }
+
+    // Выводит собранные стеки в формате folded stacks
+    void WriteFoldedStacks(std::ostream& out) const;
+
+    std::uint64_t GetSampleCount() const noexcept;
+    // Количество сэмплов, не поместившихся в буфер
+    std::uint64_t GetDroppedCount() const noexcept;
+
+private:
+    bool running_ = false;
+};
+
+/*
+ * Помечает сэмплы, снятые в текущем потоке в пределах области видимости, именем маршрута
+ * и точкой входа (например, путём запроса).
+ * route должен указывать на строку со статическим временем жизни, например на литерал.
+ * endpoint должен оставаться действительным до конца области видимости, обработчик сигнала
+ * копирует его в сэмпл.
+ */
+class RouteScope {
+public:
+    explicit RouteScope(const char* route, std::string_view endpoint = {}) noexcept;
+    ~RouteScope();
+
+    RouteScope(const RouteScope&) = delete;
+    RouteScope& operator=(const RouteScope&) = delete;
+
+private:
+    const char* prev_route_;
+    std::string_view prev_endpoint_;
+};
+
+}  // namespace profiler
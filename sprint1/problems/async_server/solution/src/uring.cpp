@@ -0,0 +1,179 @@
+#include "uring.h"
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <system_error>
+
+namespace uring {
+
+namespace {
+
+[[noreturn]] void ThrowLastError(const char* what) {
+    throw std::system_error(errno, std::generic_category(), what);
+}
+
+int Setup(unsigned entries, io_uring_params& params) {
+    return static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+}
+
+void* Map(int fd, size_t size, off_t offset) {
+    void* ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, offset);
+    if (ptr == MAP_FAILED) {
+        ThrowLastError("mmap io_uring");
+    }
+    return ptr;
+}
+
+template <typename T>
+T* At(void* base, unsigned offset) {
+    return reinterpret_cast<T*>(static_cast<char*>(base) + offset);
+}
+
+}  // namespace
+
+Ring::Ring(unsigned entries) {
+    io_uring_params params{};
+    // Задачи завершения операций выполняются только внутри io_uring_enter потока-владельца,
+    // а не прерывают его работу. Владельцем становится поток, первым вызвавший
+    // io_uring_enter, так как до этого кольцо отключено. Флаги появились в Linux 6.1, на более
+    // старых ядрах кольцо создаётся без них
+    params.flags = IORING_SETUP_CQSIZE | IORING_SETUP_SINGLE_ISSUER
+                   | IORING_SETUP_DEFER_TASKRUN | IORING_SETUP_R_DISABLED;
+    params.cq_entries = entries * 4;
+    fd_ = Setup(entries, params);
+    if (fd_ < 0 && errno == EINVAL) {
+        params = {};
+        params.flags = IORING_SETUP_CQSIZE;
+        params.cq_entries = entries * 4;
+        fd_ = Setup(entries, params);
+    }
+    enabled_ = !(params.flags & IORING_SETUP_R_DISABLED);
+    if (fd_ < 0) {
+        ThrowLastError("io_uring_setup");
+    }
+
+    try {
+        sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        if (params.features & IORING_FEAT_SINGLE_MMAP) {
+            // Обе очереди находятся в одной области памяти
+            sq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+            sq_ring_ = Map(fd_, sq_ring_size_, IORING_OFF_SQ_RING);
+        } else {
+            sq_ring_ = Map(fd_, sq_ring_size_, IORING_OFF_SQ_RING);
+            cq_ring_ = Map(fd_, cq_ring_size_, IORING_OFF_CQ_RING);
+        }
+        sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+        sqes_ = static_cast<io_uring_sqe*>(Map(fd_, sqes_size_, IORING_OFF_SQES));
+    } catch (...) {
+        Release();
+        throw;
+    }
+
+    sq_head_ = At<unsigned>(sq_ring_, params.sq_off.head);
+    sq_tail_ = At<unsigned>(sq_ring_, params.sq_off.tail);
+    sq_array_ = At<unsigned>(sq_ring_, params.sq_off.array);
+    sq_mask_ = *At<unsigned>(sq_ring_, params.sq_off.ring_mask);
+    sq_entries_ = params.sq_entries;
+
+    void* cq_ring = cq_ring_ ? cq_ring_ : sq_ring_;
+    cq_head_ = At<unsigned>(cq_ring, params.cq_off.head);
+    cq_tail_ = At<unsigned>(cq_ring, params.cq_off.tail);
+    cqes_ = At<io_uring_cqe>(cq_ring, params.cq_off.cqes);
+    cq_mask_ = *At<unsigned>(cq_ring, params.cq_off.ring_mask);
+}
+
+Ring::~Ring() {
+    Release();
+}
+
+void Ring::Release() noexcept {
+    if (sqes_) {
+        munmap(sqes_, sqes_size_);
+    }
+    if (cq_ring_) {
+        munmap(cq_ring_, cq_ring_size_);
+    }
+    if (sq_ring_) {
+        munmap(sq_ring_, sq_ring_size_);
+    }
+    if (fd_ >= 0) {
+        close(fd_);
+    }
+}
+
+void Ring::Reserve(unsigned count) {
+    const auto get_free = [this] {
+        const unsigned head = std::atomic_ref{*sq_head_}.load(std::memory_order_acquire);
+        // Хвост очереди отправки изменяет только этот поток
+        return sq_entries_ - (*sq_tail_ - head);
+    };
+    if (get_free() < count) {
+        Enter(sq_pending_, 0, 0);
+        if (get_free() < count) {
+            throw std::system_error(EBUSY, std::generic_category(), "io_uring submission queue");
+        }
+    }
+}
+
+io_uring_sqe& Ring::GetSqe() {
+    Reserve(1);
+    const unsigned tail = *sq_tail_;
+    const unsigned index = tail & sq_mask_;
+    io_uring_sqe& sqe = sqes_[index];
+    std::memset(&sqe, 0, sizeof(sqe));
+    sq_array_[index] = index;
+    // SQE заполняется до следующего вызова io_uring_enter, поэтому хвост можно сдвинуть сразу
+    std::atomic_ref{*sq_tail_}.store(tail + 1, std::memory_order_release);
+    ++sq_pending_;
+    return sqe;
+}
+
+void Ring::SubmitAndWait(unsigned wait_nr) {
+    Enter(sq_pending_, wait_nr, wait_nr > 0 ? IORING_ENTER_GETEVENTS : 0);
+}
+
+void Ring::Enter(unsigned to_submit, unsigned wait_nr, unsigned flags) {
+    if (!enabled_) {
+        if (syscall(__NR_io_uring_register, fd_, IORING_REGISTER_ENABLE_RINGS, nullptr, 0) < 0) {
+            ThrowLastError("io_uring_register");
+        }
+        enabled_ = true;
+    }
+    while (true) {
+        ++enter_count_;
+        const long submitted =
+            syscall(__NR_io_uring_enter, fd_, to_submit, wait_nr, flags, nullptr, 0);
+        if (submitted >= 0) {
+            sq_pending_ -= static_cast<unsigned>(submitted);
+            to_submit -= static_cast<unsigned>(submitted);
+            if (to_submit == 0) {
+                return;
+            }
+            // Ядро приняло не все SQE. Повторяем вызов, не ожидая завершений
+            wait_nr = 0;
+            flags &= ~IORING_ENTER_GETEVENTS;
+        } else if (errno == EINTR) {
+            continue;
+        } else if (errno == EBUSY || errno == EAGAIN) {
+            // Очередь завершений переполнена. Отправка продолжится после обработки CQE
+            return;
+        } else {
+            ThrowLastError("io_uring_enter");
+        }
+    }
+}
+
+void Ring::RegisterBuffers(std::span<const iovec> buffers) {
+    if (syscall(__NR_io_uring_register, fd_, IORING_REGISTER_BUFFERS, buffers.data(),
+                static_cast<unsigned>(buffers.size())) < 0) {
+        ThrowLastError("io_uring_register");
+    }
+}
+
+}  // namespace uring
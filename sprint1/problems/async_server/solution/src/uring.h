@@ -0,0 +1,99 @@
+#pragma once
+#include <linux/io_uring.h>
+#include <sys/uio.h>
+
+#include <atomic>
+#include <cstdint>
+#include <span>
+
+namespace uring {
+
+/*
+Кольцо io_uring, работающее напрямую через системные вызовы io_uring_setup, io_uring_enter и
+io_uring_register, без библиотеки liburing.
+Подготовленные SQE накапливаются в очереди отправки и передаются ядру вместе с ожиданием
+завершений одним вызовом io_uring_enter в SubmitAndWait. Поэтому операции всех соединений,
+подготовленные за одну итерацию цикла событий, стоят одного системного вызова.
+Кольцо можно создать в одном потоке, но операции с ним должен выполнять один и тот же поток.
+*/
+class Ring {
+public:
+    // entries - размер очереди отправки. Очередь завершений вчетверо больше, так как
+    // многократные операции (например, приём соединений) порождают несколько CQE
+    explicit Ring(unsigned entries);
+    ~Ring();
+
+    Ring(const Ring&) = delete;
+    Ring& operator=(const Ring&) = delete;
+
+    // Возвращает обнулённый SQE в конце очереди отправки. Если очередь заполнена, сначала
+    // передаёт её ядру без ожидания завершений
+    io_uring_sqe& GetSqe();
+
+    // Гарантирует, что следующие count вызовов GetSqe не передадут очередь ядру. Цепочку
+    // связанных SQE нельзя разрывать между вызовами io_uring_enter
+    void Reserve(unsigned count);
+
+    // Передаёт ядру подготовленные SQE и ждёт, пока в очереди завершений не окажется хотя бы
+    // wait_nr CQE
+    void SubmitAndWait(unsigned wait_nr);
+
+    // Вызывает fn(const io_uring_cqe&) для каждого CQE из очереди завершений и освобождает их.
+    // fn может подготавливать новые SQE. Возвращает количество обработанных CQE
+    template <typename Fn>
+    unsigned ForEachCompletion(Fn&& fn) {
+        unsigned count = 0;
+        // Голову очереди завершений изменяет только этот поток
+        unsigned head = *cq_head_;
+        while (head != std::atomic_ref{*cq_tail_}.load(std::memory_order_acquire)) {
+            const io_uring_cqe cqe = cqes_[head & cq_mask_];
+            std::atomic_ref{*cq_head_}.store(++head, std::memory_order_release);
+            fn(cqe);
+            ++count;
+        }
+        return count;
+    }
+
+    // Регистрирует буферы для операций IORING_OP_READ_FIXED. Буферы должны существовать,
+    // пока существует кольцо. Выбрасывает std::system_error, если регистрация не удалась
+    void RegisterBuffers(std::span<const iovec> buffers);
+
+    // Количество вызовов io_uring_enter
+    std::uint64_t GetEnterCount() const noexcept {
+        return enter_count_;
+    }
+
+private:
+    void Release() noexcept;
+
+    void Enter(unsigned to_submit, unsigned wait_nr, unsigned flags);
+
+    int fd_ = -1;
+
+    // Отображённые в память области колец и массив SQE
+    void* sq_ring_ = nullptr;
+    size_t sq_ring_size_ = 0;
+    void* cq_ring_ = nullptr;
+    size_t cq_ring_size_ = 0;
+    io_uring_sqe* sqes_ = nullptr;
+    size_t sqes_size_ = 0;
+
+    unsigned* sq_head_ = nullptr;
+    unsigned* sq_tail_ = nullptr;
+    unsigned* sq_array_ = nullptr;
+    unsigned sq_mask_ = 0;
+    unsigned sq_entries_ = 0;
+    // SQE, подготовленные, но ещё не переданные ядру
+    unsigned sq_pending_ = 0;
+
+    unsigned* cq_head_ = nullptr;
+    unsigned* cq_tail_ = nullptr;
+    io_uring_cqe* cqes_ = nullptr;
+    unsigned cq_mask_ = 0;
+
+    // Отключённое кольцо включается при первом вызове io_uring_enter
+    bool enabled_ = true;
+    std::uint64_t enter_count_ = 0;
+};
+
+}  // namespace uring
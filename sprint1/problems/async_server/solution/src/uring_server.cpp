@@ -0,0 +1,369 @@
+#include "uring_server.h"
+
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cstring>
+
+namespace http_server {
+
+namespace {
+
+constexpr unsigned OPERATION_BITS = 8;
+
+[[noreturn]] void ThrowLastError(const char* what) {
+    throw sys::system_error(sys::error_code(errno, sys::system_category()), what);
+}
+
+// Создаёт слушающий сокет. Опция SO_REUSEPORT позволяет нескольким серверам слушать
+// один и тот же адрес
+int Listen(const tcp::endpoint& endpoint) {
+    const int fd = socket(endpoint.protocol().family(), SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        ThrowLastError("socket");
+    }
+    const int enable = 1;
+    if (setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable)) < 0
+        || setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &enable, sizeof(enable)) < 0
+        || bind(fd, endpoint.data(), static_cast<socklen_t>(endpoint.size())) < 0
+        || listen(fd, SOMAXCONN) < 0) {
+        const int error = errno;
+        close(fd);
+        errno = error;
+        ThrowLastError("listen");
+    }
+    return fd;
+}
+
+beast::error_code MakeErrorCode(int result) {
+    return {-result, sys::system_category()};
+}
+
+}  // namespace
+
+UringServerBase::UringServerBase(const tcp::endpoint& endpoint, const UringServerConfig& config)
+    : config_(config)
+    , ring_(config.ring_entries) {
+    if (config_.read_buffer_size == 0) {
+        throw std::invalid_argument("Read buffer size must be positive");
+    }
+    read_timeout_.tv_sec = config_.read_timeout.count();
+
+    if (config_.fixed_buffers > 0) {
+        fixed_buffers_ = std::make_unique<char[]>(config_.fixed_buffers
+                                                  * config_.read_buffer_size);
+        // Вся область регистрируется одним буфером, а соединения читают в её части
+        const iovec region{fixed_buffers_.get(), config_.fixed_buffers * config_.read_buffer_size};
+        try {
+            ring_.RegisterBuffers({&region, 1});
+            free_buffers_.reserve(config_.fixed_buffers);
+            for (int index = static_cast<int>(config_.fixed_buffers); index-- > 0;) {
+                free_buffers_.push_back(index);
+            }
+        } catch (const std::system_error& e) {
+            // Например, при нехватке RLIMIT_MEMLOCK. Сервер работает и без
+            // зарегистрированных буферов
+            ReportError(beast::error_code(e.code().value(), sys::system_category()),
+                        "register buffers"sv);
+            fixed_buffers_.reset();
+        }
+    }
+
+    listen_fd_ = Listen(endpoint);
+    stop_fd_ = eventfd(0, EFD_CLOEXEC);
+    if (stop_fd_ < 0) {
+        close(listen_fd_);
+        ThrowLastError("eventfd");
+    }
+}
+
+UringServerBase::~UringServerBase() {
+    for (const Connection& connection : connections_) {
+        // Дескрипторы закрывающихся соединений закроет ядро
+        if (connection.fd >= 0 && !connection.closing) {
+            close(connection.fd);
+        }
+    }
+    close(stop_fd_);
+    close(listen_fd_);
+}
+
+void UringServerBase::Run() {
+    SubmitAccept();
+    SubmitStopWait();
+    while (!stopped_) {
+        ring_.SubmitAndWait(1);
+        ring_.ForEachCompletion([this](const io_uring_cqe& cqe) {
+            OnCompletion(cqe);
+        });
+    }
+}
+
+void UringServerBase::Stop() {
+    const std::uint64_t value = 1;
+    [[maybe_unused]] const auto written = write(stop_fd_, &value, sizeof(value));
+}
+
+io_uring_sqe& UringServerBase::GetSqe(std::uint32_t id, Operation operation) {
+    io_uring_sqe& sqe = ring_.GetSqe();
+    sqe.user_data = (std::uint64_t{id} << OPERATION_BITS) | static_cast<std::uint8_t>(operation);
+    return sqe;
+}
+
+void UringServerBase::OnCompletion(const io_uring_cqe& cqe) {
+    const auto id = static_cast<std::uint32_t>(cqe.user_data >> OPERATION_BITS);
+    switch (static_cast<Operation>(cqe.user_data & ((1u << OPERATION_BITS) - 1))) {
+        case Operation::ACCEPT:
+            return OnAccept(cqe.res, cqe.flags);
+        case Operation::STOP:
+            stopped_ = true;
+            return;
+        case Operation::READ:
+            return OnRead(id, cqe.res);
+        case Operation::WRITE:
+            return OnWrite(id, cqe.res);
+        case Operation::TIMEOUT:
+        case Operation::CLOSE:
+            return OnOperationFinished(id);
+    }
+}
+
+void UringServerBase::SubmitAccept() {
+    io_uring_sqe& sqe = GetSqe(0, Operation::ACCEPT);
+    sqe.opcode = IORING_OP_ACCEPT;
+    sqe.fd = listen_fd_;
+    sqe.accept_flags = SOCK_CLOEXEC;
+    if (multishot_accept_) {
+        // Одна операция принимает все последующие соединения (Linux 5.19)
+        sqe.ioprio = IORING_ACCEPT_MULTISHOT;
+    }
+}
+
+void UringServerBase::SubmitStopWait() {
+    io_uring_sqe& sqe = GetSqe(0, Operation::STOP);
+    sqe.opcode = IORING_OP_READ;
+    sqe.fd = stop_fd_;
+    sqe.addr = reinterpret_cast<std::uintptr_t>(&stop_value_);
+    sqe.len = sizeof(stop_value_);
+}
+
+void UringServerBase::OnAccept(int result, unsigned flags) {
+    if (result >= 0) {
+        OpenConnection(result);
+    } else if (result == -EINVAL && multishot_accept_) {
+        // Ядро не поддерживает многократный приём соединений
+        multishot_accept_ = false;
+    } else {
+        ReportError(MakeErrorCode(result), "accept"sv);
+    }
+    if (!(flags & IORING_CQE_F_MORE)) {
+        SubmitAccept();
+    }
+}
+
+void UringServerBase::OpenConnection(int fd) {
+    std::uint32_t id = 0;
+    if (free_connections_.empty()) {
+        id = static_cast<std::uint32_t>(connections_.size());
+        connections_.emplace_back();
+    } else {
+        id = free_connections_.back();
+        free_connections_.pop_back();
+    }
+    Connection& connection = connections_[id];
+    connection.fd = fd;
+    if (fixed_buffers_ && !free_buffers_.empty()) {
+        connection.buffer_index = free_buffers_.back();
+        free_buffers_.pop_back();
+        connection.buffer =
+            fixed_buffers_.get() + connection.buffer_index * config_.read_buffer_size;
+    } else {
+        if (!connection.heap_buffer) {
+            connection.heap_buffer = std::make_unique<char[]>(config_.read_buffer_size);
+        }
+        connection.buffer = connection.heap_buffer.get();
+    }
+    SubmitRead(id, connection);
+}
+
+void UringServerBase::SubmitRead(std::uint32_t id, Connection& connection) {
+    ring_.Reserve(2);
+    io_uring_sqe& read = GetSqe(id, Operation::READ);
+    read.fd = connection.fd;
+    read.addr = reinterpret_cast<std::uintptr_t>(connection.buffer + connection.size);
+    read.len = static_cast<unsigned>(config_.read_buffer_size - connection.size);
+    if (connection.buffer_index >= 0) {
+        read.opcode = IORING_OP_READ_FIXED;
+        // Зарегистрирована одна область, в которой находятся буферы всех соединений
+        read.buf_index = 0;
+    } else {
+        read.opcode = IORING_OP_RECV;
+    }
+    // Следующий SQE ограничивает время ожидания данных
+    read.flags = IOSQE_IO_LINK;
+
+    io_uring_sqe& timeout = GetSqe(id, Operation::TIMEOUT);
+    timeout.opcode = IORING_OP_LINK_TIMEOUT;
+    timeout.addr = reinterpret_cast<std::uintptr_t>(&read_timeout_);
+    timeout.len = 1;
+    connection.pending_ops += 2;
+}
+
+void UringServerBase::SubmitWrite(std::uint32_t id, Connection& connection) {
+    ring_.Reserve(3);
+    io_uring_sqe& sqe = GetSqe(id, Operation::WRITE);
+    sqe.opcode = IORING_OP_SEND;
+    sqe.fd = connection.fd;
+    sqe.addr = reinterpret_cast<std::uintptr_t>(connection.output.data());
+    sqe.len = static_cast<unsigned>(connection.output.size());
+    // С MSG_WAITALL ядро само дописывает ответ, если сокет принял его не целиком
+    sqe.msg_flags = MSG_NOSIGNAL | MSG_WAITALL;
+    ++connection.pending_ops;
+    if (!connection.close_after_write) {
+        // Чтение следующего запроса начнётся после успешной записи без отдельного
+        // системного вызова. Если запись не удастся, ядро отменит чтение
+        sqe.flags = IOSQE_IO_LINK;
+        SubmitRead(id, connection);
+    }
+}
+
+void UringServerBase::OnRead(std::uint32_t id, int result) {
+    Connection& connection = connections_[id];
+    if (connection.closing) {
+        return OnOperationFinished(id);
+    }
+    --connection.pending_ops;
+    if (result > 0) {
+        connection.size += static_cast<size_t>(result);
+        return ProcessInput(id, connection);
+    }
+    if (result == 0) {
+        // Клиент закрыл соединение. Если он не дослал запрос, это ошибка
+        if (connection.size > 0 || (connection.parser && connection.parser->got_some())) {
+            ReportError(http::error::partial_message, "read"sv);
+        }
+    } else if (result == -ECANCELED) {
+        // Чтение отменено по таймауту. Отмену из-за ошибки записи обрабатывает OnWrite,
+        // закрывая соединение
+        ReportError(beast::error::timeout, "read"sv);
+    } else {
+        ReportError(MakeErrorCode(result), "read"sv);
+    }
+    Close(id, connection);
+}
+
+void UringServerBase::OnWrite(std::uint32_t id, int result) {
+    Connection& connection = connections_[id];
+    if (connection.closing) {
+        return OnOperationFinished(id);
+    }
+    --connection.pending_ops;
+    if (result < 0 || static_cast<size_t>(result) != connection.output.size()) {
+        ReportError(result < 0 ? MakeErrorCode(result) : make_error_code(sys::errc::io_error),
+                    "write"sv);
+        return Close(id, connection);
+    }
+    connection.output.clear();
+    if (connection.close_after_write) {
+        // Семантика ответа требует закрыть соединение
+        Close(id, connection);
+    }
+}
+
+void UringServerBase::ProcessInput(std::uint32_t id, Connection& connection) {
+    size_t offset = 0;
+    while (offset < connection.size && !connection.close_after_write) {
+        if (!connection.parser) {
+            // Запросы без тела разбираются без beast прямо в буфере соединения
+            RequestView view;
+            const auto [status, size] = ParseRequest(
+                {connection.buffer + offset, connection.size - offset}, view);
+            if (status == ParseStatus::INCOMPLETE) {
+                break;
+            }
+            if (status == ParseStatus::COMPLETE) {
+                offset += size;
+                connection.responded = false;
+                HandleRequest(connection, view);
+                if (!connection.responded) {
+                    ReportError(make_error_code(sys::errc::no_message), "handle request"sv);
+                    return Close(id, connection);
+                }
+                continue;
+            }
+            connection.parser.emplace();
+            // Тело разбирается тем же вызовом put, что и заголовки
+            connection.parser->eager(true);
+        }
+        beast::error_code ec;
+        const size_t consumed = connection.parser->put(
+            net::buffer(connection.buffer + offset, connection.size - offset), ec);
+        offset += consumed;
+        if (ec == http::error::need_more) {
+            break;
+        }
+        if (ec) {
+            ReportError(ec, "read"sv);
+            return Close(id, connection);
+        }
+        if (!connection.parser->is_done()) {
+            if (consumed == 0) {
+                break;
+            }
+            continue;
+        }
+
+        HttpRequest request = connection.parser->release();
+        connection.parser.reset();
+        connection.responded = false;
+        HandleRequest(connection, std::move(request));
+        if (!connection.responded) {
+            ReportError(make_error_code(sys::errc::no_message), "handle request"sv);
+            return Close(id, connection);
+        }
+    }
+    // Неразобранный остаток запроса переносим в начало буфера
+    std::memmove(connection.buffer, connection.buffer + offset, connection.size - offset);
+    connection.size -= offset;
+
+    if (!connection.output.empty()) {
+        SubmitWrite(id, connection);
+    } else if (connection.size == config_.read_buffer_size) {
+        ReportError(http::error::buffer_overflow, "read"sv);
+        Close(id, connection);
+    } else {
+        SubmitRead(id, connection);
+    }
+}
+
+void UringServerBase::Close(std::uint32_t id, Connection& connection) {
+    connection.closing = true;
+    io_uring_sqe& sqe = GetSqe(id, Operation::CLOSE);
+    sqe.opcode = IORING_OP_CLOSE;
+    sqe.fd = connection.fd;
+    ++connection.pending_ops;
+}
+
+void UringServerBase::OnOperationFinished(std::uint32_t id) {
+    Connection& connection = connections_[id];
+    if (--connection.pending_ops > 0 || !connection.closing) {
+        return;
+    }
+    // Все операции соединения завершены, и его можно использовать повторно
+    if (connection.buffer_index >= 0) {
+        free_buffers_.push_back(connection.buffer_index);
+    }
+    // Буфер в куче и память буфера ответов остаются для следующего соединения
+    connection.fd = -1;
+    connection.buffer = nullptr;
+    connection.buffer_index = -1;
+    connection.size = 0;
+    connection.parser.reset();
+    connection.output.clear();
+    connection.close_after_write = false;
+    connection.closing = false;
+    free_connections_.push_back(id);
+}
+
+}  // namespace http_server
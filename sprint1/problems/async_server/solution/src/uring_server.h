@@ -0,0 +1,198 @@
+#pragma once
+#include "sdk.h"
+// boost.beast будет использовать std::string_view вместо boost::string_view
+#define BOOST_BEAST_USE_STD_STRING_VIEW
+
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/beast/core.hpp>
+#include <boost/beast/http.hpp>
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "http_server.h"
+#include "request_parser.h"
+#include "response_cache.h"
+#include "uring.h"
+
+namespace http_server {
+
+// Параметры сервера UringServer
+struct UringServerConfig {
+    // Размер очереди отправки кольца io_uring
+    unsigned ring_entries = 4096;
+    // Количество буферов чтения, зарегистрированных в кольце. Соединения сверх этого
+    // количества читают данные в буферы, выделенные в куче
+    unsigned fixed_buffers = 128;
+    // Размер буфера чтения соединения. Должен вмещать заголовки запроса
+    size_t read_buffer_size = 16 * 1024;
+    std::chrono::seconds read_timeout{30};
+};
+
+/*
+HTTP-сервер, выполняющий ввод-вывод через io_uring вместо реактора asio на основе epoll.
+Сервер работает в потоке, вызвавшем Run, и принимает соединения на собственный слушающий
+сокет с опцией SO_REUSEPORT, поэтому для многопоточной работы создаётся по серверу на поток
+с одним и тем же адресом, а соединения между ними распределяет ядро.
+Операции всех соединений, подготовленные при обработке очередной порции завершений, передаются
+ядру одним вызовом io_uring_enter, который заодно ожидает следующих завершений. Чтение
+выполняется операцией IORING_OP_READ_FIXED в буферы, заранее зарегистрированные в кольце,
+поэтому ядру не нужно закреплять страницы буфера при каждом чтении. Запись ответа связывается
+со следующим чтением в одну цепочку SQE.
+Обработчик запросов должен вызывать send синхронно, до возврата из обработчика.
+*/
+class UringServerBase {
+public:
+    UringServerBase(const UringServerBase&) = delete;
+    UringServerBase& operator=(const UringServerBase&) = delete;
+
+    // Обрабатывает соединения в текущем потоке, пока не будет вызван Stop
+    void Run();
+
+    // Завершает работу Run. Метод можно вызывать из любого потока
+    void Stop();
+
+    // Количество системных вызовов io_uring_enter, выполненных сервером
+    std::uint64_t GetEnterCount() const noexcept {
+        return ring_.GetEnterCount();
+    }
+
+protected:
+    using HttpRequest = http::request<http::string_body>;
+
+    // Соединение с клиентом
+    struct Connection {
+        int fd = -1;
+        // Буфер чтения: зарегистрированный в кольце (buffer_index >= 0) или heap_buffer
+        char* buffer = nullptr;
+        int buffer_index = -1;
+        std::unique_ptr<char[]> heap_buffer;
+        // Прочитанные, но ещё не разобранные данные находятся в начале буфера
+        size_t size = 0;
+        std::optional<http::request_parser<http::string_body>> parser;
+        // Ответы, ожидающие отправки
+        std::string output;
+        // Соединение закрывается после отправки output
+        bool close_after_write = false;
+        bool responded = false;
+        bool closing = false;
+        // Количество операций соединения, CQE которых ещё не получены
+        unsigned pending_ops = 0;
+    };
+
+    UringServerBase(const tcp::endpoint& endpoint, const UringServerConfig& config);
+    ~UringServerBase();
+
+    template <typename Body, typename Fields>
+    void Write(Connection& connection, http::response<Body, Fields>&& response) {
+        // Ответ сериализуется в буфер соединения, так как объект response уничтожится
+        // до завершения записи
+        http::serializer<false, Body, Fields> serializer{response};
+        beast::error_code ec;
+        while (!ec && !serializer.is_done()) {
+            serializer.next(ec, [&connection, &serializer](beast::error_code&,
+                                                           const auto& buffers) {
+                for (const auto buffer : beast::buffers_range_ref(buffers)) {
+                    connection.output.append(static_cast<const char*>(buffer.data()),
+                                             buffer.size());
+                }
+                serializer.consume(beast::buffer_bytes(buffers));
+            });
+        }
+        OnResponse(connection, response.need_eof());
+    }
+
+    // Копирует ответ с заранее сформированными заголовками в буфер соединения
+    void Write(Connection& connection, PrebuiltResponse&& response) {
+        for (const auto& buffer : response.GetBuffers()) {
+            connection.output.append(static_cast<const char*>(buffer.data()), buffer.size());
+        }
+        OnResponse(connection, response.need_eof());
+    }
+
+private:
+    // Вид операции. Хранится в младшем байте user_data вместе с номером соединения
+    enum class Operation : std::uint8_t { ACCEPT, STOP, READ, TIMEOUT, WRITE, CLOSE };
+
+    // Обработку запроса делегируем подклассу. Ответ должен быть передан в Write до возврата
+    virtual void HandleRequest(Connection& connection, HttpRequest&& request) = 0;
+
+    // Строки request ссылаются на буфер соединения и действительны только во время вызова
+    virtual void HandleRequest(Connection& connection, const RequestView& request) = 0;
+
+    void OnResponse(Connection& connection, bool close) noexcept {
+        connection.responded = true;
+        connection.close_after_write |= close;
+    }
+
+    void OnCompletion(const io_uring_cqe& cqe);
+    void OnAccept(int result, unsigned flags);
+    void OnRead(std::uint32_t id, int result);
+    void OnWrite(std::uint32_t id, int result);
+    void OnOperationFinished(std::uint32_t id);
+
+    void SubmitAccept();
+    void SubmitStopWait();
+    void SubmitRead(std::uint32_t id, Connection& connection);
+    void SubmitWrite(std::uint32_t id, Connection& connection);
+    void Close(std::uint32_t id, Connection& connection);
+
+    void OpenConnection(int fd);
+    // Разбирает прочитанные запросы, передаёт их обработчику и отправляет ответы
+    void ProcessInput(std::uint32_t id, Connection& connection);
+
+    io_uring_sqe& GetSqe(std::uint32_t id, Operation operation);
+
+    UringServerConfig config_;
+    // Память зарегистрированных буферов и буферов соединений освобождается после закрытия
+    // кольца: незавершённые операции чтения могут писать в неё до его закрытия
+    std::unique_ptr<char[]> fixed_buffers_;
+    std::vector<int> free_buffers_;
+    // deque не перемещает элементы при добавлении, поэтому ссылки на соединения остаются
+    // действительными
+    std::deque<Connection> connections_;
+    std::vector<std::uint32_t> free_connections_;
+    uring::Ring ring_;
+    int listen_fd_ = -1;
+    // eventfd, через который Stop сообщает о завершении работы
+    int stop_fd_ = -1;
+    std::uint64_t stop_value_ = 0;
+    bool stopped_ = false;
+    bool multishot_accept_ = true;
+    __kernel_timespec read_timeout_{};
+};
+
+template <typename RequestHandler>
+class UringServer : public UringServerBase {
+public:
+    template <typename Handler>
+    UringServer(const tcp::endpoint& endpoint, Handler&& request_handler,
+                const UringServerConfig& config = {})
+        : UringServerBase(endpoint, config)
+        , request_handler_(std::forward<Handler>(request_handler)) {
+    }
+
+private:
+    void HandleRequest(Connection& connection, HttpRequest&& request) override {
+        // В отличие от Session, соединение не продлевает своё время жизни, поэтому обработчик
+        // должен вызвать send синхронно
+        request_handler_(std::move(request), MakeSender(connection));
+    }
+
+    void HandleRequest(Connection& connection, const RequestView& request) override {
+        request_handler_(request, MakeSender(connection));
+    }
+
+    auto MakeSender(Connection& connection) {
+        return [this, &connection](auto&& response) {
+            Write(connection, std::move(response));
+        };
+    }
+
+    RequestHandler request_handler_;
+};
+
+}  // namespace http_server
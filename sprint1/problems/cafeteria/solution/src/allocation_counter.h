@@ -0,0 +1,127 @@
+#pragma once
+/*
+Подсчёт выделений памяти в бенчмарках. Заголовок заменяет глобальные operator new и
+operator delete, поэтому его подключает ровно одна единица трансляции исполняемого файла.
+Заменены все варианты операторов (обычные, массивов, nothrow, с размером и с выравниванием),
+чтобы память, выделенная любым из них, освобождалась парным оператором.
+*/
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+namespace allocation_counter {
+
+// Количество вызовов глобального operator new
+inline std::atomic<std::uint64_t> g_allocations{0};
+
+inline void* Allocate(std::size_t size, std::size_t alignment) noexcept {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    size = size ? size : 1;
+    if (alignment <= alignof(std::max_align_t)) {
+        return std::malloc(size);
+    }
+    // Размер для aligned_alloc должен быть кратен выравниванию
+    return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+}
+
+inline void Deallocate(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+inline void* AllocateOrThrow(std::size_t size, std::size_t alignment) {
+    if (void* ptr = Allocate(size, alignment)) {
+        return ptr;
+    }
+    throw std::bad_alloc{};
+}
+
+}  // namespace allocation_counter
+
+inline std::uint64_t GetAllocationCount() noexcept {
+    return allocation_counter::g_allocations.load(std::memory_order_relaxed);
+}
+
+void* operator new(std::size_t size) {
+    return allocation_counter::AllocateOrThrow(size, alignof(std::max_align_t));
+}
+
+void* operator new[](std::size_t size) {
+    return allocation_counter::AllocateOrThrow(size, alignof(std::max_align_t));
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    return allocation_counter::AllocateOrThrow(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return allocation_counter::AllocateOrThrow(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return allocation_counter::Allocate(size, alignof(std::max_align_t));
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return allocation_counter::Allocate(size, alignof(std::max_align_t));
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment,
+                   const std::nothrow_t&) noexcept {
+    return allocation_counter::Allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment,
+                     const std::nothrow_t&) noexcept {
+    return allocation_counter::Allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* ptr) noexcept {
+    allocation_counter::Deallocate(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    allocation_counter::Deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    allocation_counter::Deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+    allocation_counter::Deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept {
+    allocation_counter::Deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t) noexcept {
+    allocation_counter::Deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept {
+    allocation_counter::Deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept {
+    allocation_counter::Deallocate(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+    allocation_counter::Deallocate(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+    allocation_counter::Deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept {
+    allocation_counter::Deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept {
+    allocation_counter::Deallocate(ptr);
+}
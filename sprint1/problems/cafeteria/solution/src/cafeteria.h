@@ -4,17 +4,25 @@
 #endif
 
 #include <boost/asio/io_context.hpp>
-#include <boost/asio/steady_timer.hpp>
 #include <boost/asio/strand.hpp>
+#include <boost/smart_ptr/intrusive_ptr.hpp>
+#include <atomic>
+#include <cassert>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
 
 #include "hotdog.h"
 #include "result.h"
+#include "timer_wheel.h"
 
 namespace net = boost::asio;
 
 // Функция-обработчик операции приготовления хот-дога
 using HotDogHandler = std::function<void(Result<HotDog> hot_dog)>;
+// Функция-обработчик пакетного заказа хот-догов
+using HotDogsHandler = std::function<void(std::vector<Result<HotDog>> hot_dogs)>;
 
 // Класс "Кафетерий". Готовит хот-доги
 class Cafeteria {
@@ -23,87 +31,298 @@ public:
         : io_{io} {
     }
 
+    Cafeteria(const Cafeteria&) = delete;
+    Cafeteria& operator=(const Cafeteria&) = delete;
+
     // Асинхронно готовит хот-дог и вызывает handler, как только хот-дог будет готов.
     // Этот метод может быть вызван из произвольного потока
     void OrderHotDog(HotDogHandler handler) {
-        try {
-            // Получаем уникальные id сразу, атомарно
-            int bread_id = next_id_.fetch_add(1, std::memory_order_relaxed);
-            int sausage_id = next_id_.fetch_add(1, std::memory_order_relaxed);
-            int hotdog_id = next_id_.fetch_add(1, std::memory_order_relaxed);
-
-            // Создаём ингредиенты напрямую с id, минуя внутренний счётчик Store
-            auto bread = std::make_shared<Bread>(bread_id);
-            auto sausage = std::make_shared<Sausage>(sausage_id);
-
-            // Состояние готовки ингредиентов
-            auto bread_done = std::make_shared<std::atomic_bool>(false);
-            auto sausage_done = std::make_shared<std::atomic_bool>(false);
-
-            auto handler_ptr = std::make_shared<HotDogHandler>(std::move(handler));
-            auto check_completion = std::make_shared<std::function<void()>>();
-
-            *check_completion = [bread, sausage, bread_done, sausage_done, handler_ptr, hotdog_id, check_completion]() {
-                if (*bread_done && *sausage_done) {
-                    try {
-                        auto bread_time = bread->GetBakingDuration();
-                        auto sausage_time = sausage->GetCookDuration();
-
-                        if (bread_time < HotDog::MIN_BREAD_COOK_DURATION ||
-                            bread_time > HotDog::MAX_BREAD_COOK_DURATION) {
-                            (*handler_ptr)(Result<HotDog>(
-                                std::make_exception_ptr(std::runtime_error("Bread cook duration out of range"))));
-                            return;
-                        }
-
-                        if (sausage_time < HotDog::MIN_SAUSAGE_COOK_DURATION ||
-                            sausage_time > HotDog::MAX_SAUSAGE_COOK_DURATION) {
-                            (*handler_ptr)(Result<HotDog>(
-                                std::make_exception_ptr(std::runtime_error("Sausage cook duration out of range"))));
-                            return;
-                        }
-
-                        auto hotdog = std::make_shared<HotDog>(hotdog_id, sausage, bread);
-                        (*handler_ptr)(Result<HotDog>(*hotdog));
-                    }
-                    catch (const std::exception& e) {
-                        (*handler_ptr)(Result<HotDog>(std::make_exception_ptr(e)));
-                    }
-                }
-                };
-
-            // Асинхронная готовка булки
-            bread->StartBake(*gas_cooker_, [this, bread, bread_done, check_completion]() {
-                auto timer = std::make_shared<boost::asio::steady_timer>(io_);
-                timer->expires_after(HotDog::MIN_BREAD_COOK_DURATION);
-                timer->async_wait([bread, bread_done, check_completion, timer](const boost::system::error_code& ec) {
-                    if (ec) return;
-                    bread->StopBaking();
-                    *bread_done = true;
-                    (*check_completion)();
-                    });
-                });
-
-            // Асинхронная готовка сосиски
-            sausage->StartFry(*gas_cooker_, [this, sausage, sausage_done, check_completion]() {
-                auto timer = std::make_shared<boost::asio::steady_timer>(io_);
-                timer->expires_after(HotDog::MIN_SAUSAGE_COOK_DURATION);
-                timer->async_wait([sausage, sausage_done, check_completion, timer](const boost::system::error_code& ec) {
-                    if (ec) return;
-                    sausage->StopFry();
-                    *sausage_done = true;
-                    (*check_completion)();
-                    });
-                });
-
-        }
-        catch (const std::exception& e) {
-            handler(Result<HotDog>(std::make_exception_ptr(e)));
+        // Получаем уникальные id для булки, сосиски и хот-дога сразу, атомарно
+        StartOrder(next_id_.fetch_add(3, std::memory_order_relaxed), std::move(handler));
+    }
+
+    /*
+     * Асинхронно готовит count хот-догов и один раз вызывает handler, когда будут готовы все.
+     * i-й элемент вектора содержит результат приготовления i-го хот-дога.
+     * Память под результаты выделяется заранее, а обработчики отдельных хот-догов не выделяют
+     * память. Если count равен нулю, handler вызывается сразу.
+     * Этот метод может быть вызван из произвольного потока
+     */
+    void OrderHotDogs(size_t count, HotDogsHandler handler) {
+        if (count == 0) {
+            handler({});
+            return;
+        }
+        auto batch = std::make_unique<Batch>(count, std::move(handler));
+
+        // id всех хот-догов пакета выделяются одной атомарной операцией
+        const int first_id =
+            next_id_.fetch_add(static_cast<int>(count * 3), std::memory_order_relaxed);
+        // После запуска последнего заказа пакет может быть удалён в другом потоке
+        Batch* batch_ptr = batch.release();
+        for (size_t i = 0; i < count; ++i) {
+            StartOrder(first_id + static_cast<int>(i * 3), [batch_ptr, i](Result<HotDog> result) {
+                batch_ptr->OnHotDogReady(i, std::move(result));
+            });
         }
     }
 
+    // Количество незавершённых заказов. После выполнения всех заказов должно быть равно 0,
+    // иначе состояние какого-то заказа удерживается и не возвращается в пул
+    size_t GetActiveOrderCount() const {
+        return orders_.GetActiveCount();
+    }
+
+    // Количество созданных объектов состояния заказа, включая находящиеся в пуле
+    size_t GetAllocatedOrderCount() const {
+        return orders_.GetAllocatedCount();
+    }
 
 private:
+    class OrderPool;
+    class Order;
+
+    // Пакет заказов. Собирает результаты и удаляет себя после вызова обработчика пакета
+    class Batch {
+    public:
+        Batch(size_t count, HotDogsHandler handler)
+            : results_(count)
+            , remaining_{count}
+            , handler_{std::move(handler)} {
+        }
+
+        void OnHotDogReady(size_t index, Result<HotDog> result) {
+            results_[index].emplace(std::move(result));
+            // Обработчик пакета вызывает поток, получивший последний результат
+            if (remaining_.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+                return;
+            }
+            const std::unique_ptr<Batch> self{this};
+            std::vector<Result<HotDog>> hot_dogs;
+            hot_dogs.reserve(results_.size());
+            for (auto& result : results_) {
+                hot_dogs.push_back(std::move(*result));
+            }
+            handler_(std::move(hot_dogs));
+        }
+
+    private:
+        std::vector<std::optional<Result<HotDog>>> results_;
+        std::atomic_size_t remaining_;
+        HotDogsHandler handler_;
+    };
+
+    // Начинает приготовление хот-дога. Булка, сосиска и хот-дог получают id first_id,
+    // first_id + 1 и first_id + 2
+    void StartOrder(int first_id, HotDogHandler handler) {
+        boost::intrusive_ptr<Order> order;
+        BreadPtr bread;
+        SausagePtr sausage;
+        try {
+            // Берём ингредиенты с заданными id, минуя внутренний счётчик Store
+            bread = store_.GetBread(first_id);
+            sausage = store_.GetSausage(first_id + 1);
+            order = orders_.Acquire();
+        } catch (...) {
+            handler(Result<HotDog>::FromCurrentException());
+            return;
+        }
+        order->Reset(first_id + 2, bread, sausage, std::move(handler));
+
+        // Ингредиенты готовятся параллельно. Хот-дог собирается, когда готовы оба.
+        // std::function размещает без выделения памяти только тривиально копируемые объекты,
+        // поэтому обработчики захватывают сырой указатель, которому передаётся ссылка на заказ.
+        // Если StartBake или StartFry выбросит исключение, обработчик не будет вызван,
+        // и переданную ему ссылку нужно освободить
+        Order* const bread_ref = AddRef(order);
+        try {
+            bread->StartBake(*gas_cooker_, [order = bread_ref] {
+                boost::intrusive_ptr{order, false}->OnBreadBakingStarted();
+            });
+        } catch (...) {
+            intrusive_ptr_release(bread_ref);
+            throw;
+        }
+        Order* const sausage_ref = order.detach();
+        try {
+            sausage->StartFry(*gas_cooker_, [order = sausage_ref] {
+                boost::intrusive_ptr{order, false}->OnSausageFryingStarted();
+            });
+        } catch (...) {
+            intrusive_ptr_release(sausage_ref);
+            throw;
+        }
+    }
+
+    // Увеличивает счётчик ссылок на заказ и возвращает указатель на него
+    static Order* AddRef(const boost::intrusive_ptr<Order>& order) noexcept {
+        return boost::intrusive_ptr{order}.detach();
+    }
+
+    /*
+     * Состояние заказа: ингредиенты, таймеры их приготовления и обработчик заказа.
+     * Асинхронные операции заказа владеют им через boost::intrusive_ptr или через сырой
+     * указатель, которому передана ссылка на заказ.
+     * Когда уничтожается последняя ссылка на заказ, он возвращается в пул и используется
+     * повторно для одного из следующих заказов.
+     */
+    class Order {
+    public:
+        Order(OrderPool& pool, TimerWheel& timer_wheel)
+            : pool_{pool}
+            , bread_timer_{timer_wheel}
+            , sausage_timer_{timer_wheel} {
+        }
+
+        Order(const Order&) = delete;
+        Order& operator=(const Order&) = delete;
+
+        void Reset(int hotdog_id, BreadPtr bread, SausagePtr sausage,
+                   HotDogHandler handler) noexcept {
+            hotdog_id_ = hotdog_id;
+            bread_ = std::move(bread);
+            sausage_ = std::move(sausage);
+            handler_ = std::move(handler);
+            pending_ingredients_.store(2, std::memory_order_relaxed);
+        }
+
+        void OnBreadBakingStarted() {
+            bread_timer_.ExpiresAfter(HotDog::MIN_BREAD_COOK_DURATION);
+            intrusive_ptr_add_ref(this);
+            bread_timer_.AsyncWait([this](sys::error_code ec) {
+                const boost::intrusive_ptr self{this, false};
+                if (!ec) {
+                    bread_->StopBaking();
+                    OnIngredientCooked();
+                }
+            });
+        }
+
+        void OnSausageFryingStarted() {
+            sausage_timer_.ExpiresAfter(HotDog::MIN_SAUSAGE_COOK_DURATION);
+            intrusive_ptr_add_ref(this);
+            sausage_timer_.AsyncWait([this](sys::error_code ec) {
+                const boost::intrusive_ptr self{this, false};
+                if (!ec) {
+                    sausage_->StopFry();
+                    OnIngredientCooked();
+                }
+            });
+        }
+
+        // Освобождает ингредиенты и обработчик перед возвратом заказа в пул
+        void Clear() noexcept {
+            bread_.reset();
+            sausage_.reset();
+            handler_ = nullptr;
+        }
+
+        friend void intrusive_ptr_add_ref(Order* order) noexcept {
+            order->ref_count_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        friend void intrusive_ptr_release(Order* order) noexcept {
+            if (order->ref_count_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                order->pool_.Recycle(order);
+            }
+        }
+
+    private:
+        friend class OrderPool;
+
+        void OnIngredientCooked() {
+            // Хот-дог собирает поток, который завершил приготовление последнего ингредиента
+            if (pending_ingredients_.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+                return;
+            }
+            auto result = [this]() -> Result<HotDog> {
+                // Забракованные заказы частые, поэтому о них сообщает код ошибки, а не
+                // исключение, требующее выделения памяти
+                if (const std::error_code error = HotDog::CheckIngredients(*sausage_, *bread_)) {
+                    return Result<HotDog>{error};
+                }
+                try {
+                    return HotDog{hotdog_id_, std::move(sausage_), std::move(bread_)};
+                } catch (...) {
+                    return Result<HotDog>::FromCurrentException();
+                }
+            }();
+            auto handler = std::move(handler_);
+            handler(std::move(result));
+        }
+
+        OrderPool& pool_;
+        std::atomic_int ref_count_{0};
+        // Количество ингредиентов, приготовление которых ещё не завершено
+        std::atomic_int pending_ingredients_{0};
+        int hotdog_id_ = 0;
+        BreadPtr bread_;
+        SausagePtr sausage_;
+        WheelTimer bread_timer_;
+        WheelTimer sausage_timer_;
+        HotDogHandler handler_;
+        // Следующий свободный заказ в пуле
+        Order* next_free_ = nullptr;
+    };
+
+    // Пул заказов. Завершённые заказы хранятся в односвязном списке и используются повторно
+    class OrderPool {
+    public:
+        explicit OrderPool(TimerWheel& timer_wheel)
+            : timer_wheel_{timer_wheel} {
+        }
+
+        OrderPool(const OrderPool&) = delete;
+        OrderPool& operator=(const OrderPool&) = delete;
+
+        ~OrderPool() {
+            assert(active_count_ == 0);
+            while (free_list_) {
+                delete std::exchange(free_list_, free_list_->next_free_);
+            }
+        }
+
+        boost::intrusive_ptr<Order> Acquire() {
+            std::unique_lock lock{mutex_};
+            if (free_list_) {
+                ++active_count_;
+                return boost::intrusive_ptr{std::exchange(free_list_, free_list_->next_free_)};
+            }
+            lock.unlock();
+
+            boost::intrusive_ptr order{new Order(*this, timer_wheel_)};
+            lock.lock();
+            ++active_count_;
+            ++allocated_count_;
+            return order;
+        }
+
+        void Recycle(Order* order) noexcept {
+            order->Clear();
+            std::lock_guard lock{mutex_};
+            order->next_free_ = free_list_;
+            free_list_ = order;
+            --active_count_;
+        }
+
+        size_t GetActiveCount() const {
+            std::lock_guard lock{mutex_};
+            return active_count_;
+        }
+
+        size_t GetAllocatedCount() const {
+            std::lock_guard lock{mutex_};
+            return allocated_count_;
+        }
+
+    private:
+        TimerWheel& timer_wheel_;
+        mutable std::mutex mutex_;
+        Order* free_list_ = nullptr;
+        size_t active_count_ = 0;
+        size_t allocated_count_ = 0;
+    };
+
     net::io_context& io_;
     // Используется для создания ингредиентов хот-дога
     Store store_;
@@ -113,4 +332,8 @@ private:
     // enable_shared_from_this.
     std::shared_ptr<GasCooker> gas_cooker_ = std::make_shared<GasCooker>(io_);
     std::atomic_int next_id_{ 0 }; // счётчик хот-догов
+    // Таймеры приготовления всех ингредиентов обслуживаются одним колесом таймеров
+    TimerWheel timer_wheel_{io_};
+    // Пул состояний заказов. Разрушается раньше колеса таймеров, которое используют заказы
+    OrderPool orders_{timer_wheel_};
 };
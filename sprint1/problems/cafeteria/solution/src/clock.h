@@ -1,5 +1,8 @@
 #pragma once
 #include <chrono>
 
-using Clock = std::chrono::high_resolution_clock;
+#include "virtual_clock.h"
+
+// Монотонные часы, которые в потоке с VirtualClock показывают модельное время
+using Clock = SteadyClock;
 using Milliseconds = std::chrono::milliseconds;
\ No newline at end of file
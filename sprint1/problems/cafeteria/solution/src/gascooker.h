@@ -4,10 +4,12 @@
 #endif
 
 #include <boost/asio/io_context.hpp>
-#include <boost/asio/strand.hpp>
+#include <boost/asio/post.hpp>
+#include <atomic>
 #include <cassert>
-#include <deque>
+#include <functional>
 #include <memory>
+#include <thread>
 
 namespace net = boost::asio;
 namespace sys = boost::system;
@@ -18,6 +20,12 @@ namespace sys = boost::system;
 освобождать (метод ReleaseBurner).
 Если свободных горелок нет, то запрос на занимание горелки ставится в очередь.
 Методы класса можно вызывать из разных потоков.
+
+Плита работает как счётный семафор без блокировок. Счётчик available_ хранит количество
+свободных горелок за вычетом ожидающих запросов. Если горелка свободна, её занятие стоит
+одной атомарной операции и не выделяет память. Иначе для запроса выделяется узел, который
+помещается в интрузивную очередь ожидания (много писателей, один читатель), и его извлекает
+поток, освобождающий горелку.
 */
 class GasCooker : public std::enable_shared_from_this<GasCooker> {
 public:
@@ -25,73 +33,154 @@ public:
 
     GasCooker(net::io_context& io, int num_burners = 8)
         : io_{io}
-        , number_of_burners_{num_burners} {
+        , number_of_burners_{num_burners}
+        , available_{num_burners} {
+        if (num_burners <= 0) {
+            throw std::invalid_argument("Number of burners must be positive");
+        }
     }
 
     GasCooker(const GasCooker&) = delete;
     GasCooker& operator=(const GasCooker&) = delete;
 
     ~GasCooker() {
-        assert(burners_in_use_ == 0);
+        assert(available_ == number_of_burners_);
+        // Очередь должна быть пуста, но на случай аварийного завершения освобождаем её узлы
+        while (Waiter* waiter = waiters_.Pop()) {
+            delete waiter;
+        }
     }
 
     // Используется для того, чтобы занять горелку. handler будет вызван в момент, когда горелка
     // занята
     // Этот метод можно вызывать параллельно с вызовом других методов
     void UseBurner(Handler handler) {
-        // Выполняем работу внутри strand, чтобы изменение состояния горелки выполнялось
-        // последовательно
-        net::dispatch(strand_,
-                      // За счёт захвата self в лямбда-функции, время жизни GasCooker будет продлено
-                      // до её вызова
-                      [handler = std::move(handler), self = shared_from_this(), this]() mutable {
-                          assert(strand_.running_in_this_thread());
-                          assert(burners_in_use_ >= 0 && burners_in_use_ <= number_of_burners_);
-
-                          // Есть свободные горелки?
-                          if (burners_in_use_ < number_of_burners_) {
-                              // Занимаем горелку
-                              ++burners_in_use_;
-                              // Асинхронно уведомляем обработчик о том, что горелка занята.
-                              // Используется асинхронный вызов, так как handler может
-                              // выполняться долго, а strand лучше освободить
-                              net::post(io_, std::move(handler));
-                          } else {  // Все горелки заняты
-                              // Ставим обработчик в хвост очереди
-                              pending_handlers_.emplace_back(std::move(handler));
-                          }
-
-                          // Проверка инвариантов класса
-                          assert(burners_in_use_ > 0 && burners_in_use_ <= number_of_burners_);
-                      });
+        // Пока есть свободная горелка, занимаем её, не выделяя память
+        int available = available_.load(std::memory_order_relaxed);
+        while (available > 0) {
+            if (available_.compare_exchange_weak(available, available - 1,
+                                                 std::memory_order_acq_rel)) {
+                return PostHandler(std::move(handler));
+            }
+        }
+
+        // Узел выделяется до изменения счётчика. Если бы выделение памяти выбросило исключение
+        // после того, как счётчик учёл ожидающий запрос, освобождающий горелку поток
+        // бесконечно ждал бы узел, который никогда не появится в очереди
+        auto waiter = std::make_unique<Waiter>(std::move(handler));
+        // Если до уменьшения счётчика горелка успела освободиться, она теперь наша
+        if (available_.fetch_sub(1, std::memory_order_acq_rel) > 0) {
+            return PostHandler(std::move(waiter->handler));
+        }
+        // Все горелки заняты. Горелку передаст обработчику поток, который её освободит
+        waiters_.Push(waiter.release());
     }
 
     void ReleaseBurner() {
-        // Освобождение выполняем также последовательно
-        net::dispatch(strand_, [this, self = shared_from_this()] {
-            assert(strand_.running_in_this_thread());
-            assert(burners_in_use_ > 0 && burners_in_use_ <= number_of_burners_);
-
-            // Есть ли ожидающие обработчики?
-            if (!pending_handlers_.empty()) {
-                // Выполняем асинхронно обработчик первый обработчик
-                net::post(io_, std::move(pending_handlers_.front()));
-                // И удаляем его из очереди ожидания
-                pending_handlers_.pop_front();
-            } else {
-                // Освобождаем горелку
-                --burners_in_use_;
-            }
-        });
+        // Если до увеличения счётчика он был неотрицательным, ожидающих запросов нет
+        if (available_.fetch_add(1, std::memory_order_acq_rel) >= 0) {
+            return;
+        }
+        // Горелку нужно передать ожидающему запросу. Извлекать запросы из очереди может только
+        // один поток, поэтому передачи накапливаются в handoffs_, а обрабатывает их поток,
+        // увеличивший счётчик с нуля
+        if (handoffs_.fetch_add(1, std::memory_order_acq_rel) > 0) {
+            return;
+        }
+        do {
+            net::post(io_, TakeWaiter());
+        } while (handoffs_.fetch_sub(1, std::memory_order_acq_rel) > 1);
     }
 
 private:
-    using Strand = net::strand<net::io_context::executor_type>;
+    // Асинхронно уведомляет обработчик о том, что горелка занята.
+    // Используется асинхронный вызов, так как handler может выполняться долго
+    void PostHandler(Handler&& handler) {
+        try {
+            net::post(io_, std::move(handler));
+        } catch (...) {
+            // Горелка уже занята, но обработчик о ней не узнает, поэтому возвращаем её
+            ReleaseBurner();
+            throw;
+        }
+    }
+
+    // Запрос на занимание горелки, ожидающий в очереди
+    struct Waiter {
+        explicit Waiter(Handler h)
+            : handler{std::move(h)} {
+        }
+
+        Handler handler;
+        std::atomic<Waiter*> next{nullptr};
+    };
+
+    /*
+     * Интрузивная очередь Вьюкова: добавлять элементы могут несколько потоков одновременно,
+     * извлекать - только один. Push выполняет один атомарный обмен и не блокируется.
+     */
+    class WaiterQueue {
+    public:
+        void Push(Waiter* waiter) noexcept {
+            waiter->next.store(nullptr, std::memory_order_relaxed);
+            Waiter* prev = head_.exchange(waiter, std::memory_order_acq_rel);
+            prev->next.store(waiter, std::memory_order_release);
+        }
+
+        // Возвращает nullptr, если очередь пуста или добавление элемента ещё не завершено
+        Waiter* Pop() noexcept {
+            Waiter* tail = tail_;
+            Waiter* next = tail->next.load(std::memory_order_acquire);
+            if (tail == &stub_) {
+                if (!next) {
+                    return nullptr;
+                }
+                tail_ = tail = next;
+                next = next->next.load(std::memory_order_acquire);
+            }
+            if (next) {
+                tail_ = next;
+                return tail;
+            }
+            if (tail != head_.load(std::memory_order_acquire)) {
+                return nullptr;
+            }
+            // В очереди остался один элемент. Чтобы его извлечь, за ним должен быть другой узел
+            Push(&stub_);
+            next = tail->next.load(std::memory_order_acquire);
+            if (next) {
+                tail_ = next;
+                return tail;
+            }
+            return nullptr;
+        }
+
+    private:
+        Waiter stub_{nullptr};
+        std::atomic<Waiter*> head_{&stub_};
+        Waiter* tail_ = &stub_;
+    };
+
+    // Извлекает обработчик ожидающего запроса. Счётчик горелок гарантирует, что запрос
+    // существует, но поток, который его добавляет, мог ещё не завершить Push
+    Handler TakeWaiter() {
+        Waiter* waiter = waiters_.Pop();
+        while (!waiter) {
+            std::this_thread::yield();
+            waiter = waiters_.Pop();
+        }
+        Handler handler = std::move(waiter->handler);
+        delete waiter;
+        return handler;
+    }
+
     net::io_context& io_;
-    Strand strand_{net::make_strand(io_)};
     int number_of_burners_;
-    int burners_in_use_ = 0;
-    std::deque<Handler> pending_handlers_;
+    // Количество свободных горелок. Отрицательное значение - число ожидающих запросов
+    std::atomic_int available_;
+    // Количество горелок, которые нужно передать ожидающим запросам
+    std::atomic_int handoffs_{0};
+    WaiterQueue waiters_;
 };
 
 // RAII-класс для автоматического освобождения газовой плиты
@@ -0,0 +1,98 @@
+#ifdef _WIN32
+#include <sdkddkver.h>
+#endif
+
+#include <atomic>
+#include <charconv>
+#include <iostream>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "clock.h"
+#include "gascooker.h"
+
+using namespace std::literals;
+
+namespace {
+
+template <typename Fn>
+void RunWorkers(unsigned n, const Fn& fn) {
+    n = std::max(1u, n);
+    std::vector<std::jthread> workers;
+    workers.reserve(n - 1);
+    // Запускаем n-1 рабочих потоков, выполняющих функцию fn
+    while (--n) {
+        workers.emplace_back(fn);
+    }
+    fn();
+}
+
+unsigned ParseArg(int argc, const char* argv[], int index, unsigned default_value) {
+    if (argc <= index) {
+        return default_value;
+    }
+    const std::string_view arg = argv[index];
+    unsigned value = 0;
+    const auto [end, ec] = std::from_chars(arg.data(), arg.data() + arg.size(), value);
+    if (ec != std::errc{} || end != arg.data() + arg.size() || value == 0) {
+        throw std::invalid_argument("Invalid argument: "s + std::string(arg));
+    }
+    return value;
+}
+
+/*
+ * Каждый заказ занимает две горелки (для хлеба и для сосиски) и сразу же их освобождает.
+ * Время приготовления не моделируется, поэтому измеряется только пропускная способность
+ * плиты при одновременных заказах из нескольких потоков.
+ */
+void RunBenchmark(unsigned num_threads, unsigned num_orders) {
+    net::io_context io{static_cast<int>(num_threads)};
+    auto cooker = std::make_shared<GasCooker>(io);
+
+    std::atomic_uint cooked_ingredients{0};
+    auto cook = [&cooker, &cooked_ingredients] {
+        cooker->UseBurner([&cooker, &cooked_ingredients] {
+            cooked_ingredients.fetch_add(1, std::memory_order_relaxed);
+            cooker->ReleaseBurner();
+        });
+    };
+
+    for (unsigned i = 0; i < num_orders; ++i) {
+        net::post(io, [&cook] {
+            cook();
+            cook();
+        });
+    }
+
+    const auto start_time = Clock::now();
+    RunWorkers(num_threads, [&io] {
+        io.run();
+    });
+    const auto duration = std::chrono::duration<double>(Clock::now() - start_time).count();
+
+    if (cooked_ingredients != num_orders * 2) {
+        throw std::logic_error("Not all orders have been completed");
+    }
+    std::cout << "Threads: "sv << num_threads << ", orders: "sv << num_orders << ", time: "sv
+              << duration << "s, orders/s: "sv << static_cast<std::uint64_t>(num_orders / duration)
+              << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, const char* argv[]) {
+    try {
+        // gascooker_benchmark [<orders> [<threads>]]
+        const unsigned num_orders = ParseArg(argc, argv, 1, 1'000'000);
+        const unsigned max_threads =
+            ParseArg(argc, argv, 2, std::max(1u, std::thread::hardware_concurrency()));
+        for (unsigned num_threads = 1; num_threads < max_threads; num_threads *= 2) {
+            RunBenchmark(num_threads, num_orders);
+        }
+        RunBenchmark(max_threads, num_orders);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+}
@@ -3,10 +3,47 @@
 #include <functional>
 #include <optional>
 #include <stdexcept>
+#include <string>
+#include <system_error>
 
 #include "gascooker.h"
 #include "ingredients.h"
 
+// Причины, по которым хот-дог не может быть приготовлен
+enum class HotDogError {
+    INVALID_SAUSAGE_COOK_DURATION = 1,
+    INVALID_BREAD_COOK_DURATION,
+};
+
+// Категория кодов ошибок HotDogError
+inline const std::error_category& GetHotDogErrorCategory() noexcept {
+    class HotDogErrorCategory : public std::error_category {
+    public:
+        const char* name() const noexcept override {
+            return "hot_dog";
+        }
+
+        std::string message(int error) const override {
+            switch (static_cast<HotDogError>(error)) {
+                case HotDogError::INVALID_SAUSAGE_COOK_DURATION:
+                    return "Invalid sausage cook duration";
+                case HotDogError::INVALID_BREAD_COOK_DURATION:
+                    return "Invalid bread cook duration";
+            }
+            return "Unknown hot dog error";
+        }
+    };
+    static const HotDogErrorCategory category;
+    return category;
+}
+
+inline std::error_code make_error_code(HotDogError error) noexcept {
+    return {static_cast<int>(error), GetHotDogErrorCategory()};
+}
+
+template <>
+struct std::is_error_code_enum<HotDogError> : std::true_type {};
+
 /*
 Класс Хот-дог.
 */
@@ -22,19 +59,29 @@ public:
     constexpr static Clock::duration MIN_BREAD_COOK_DURATION = Milliseconds{1000};
     constexpr static Clock::duration MAX_BREAD_COOK_DURATION = Milliseconds{1500};
 
-    HotDog(int id, std::shared_ptr<Sausage> sausage, std::shared_ptr<Bread> bread)
+    HotDog(int id, SausagePtr sausage, BreadPtr bread)
         : id_{id}
         , sausage_{std::move(sausage)}
         , bread_{std::move(bread)} {
-        if (sausage_->GetCookDuration() < MIN_SAUSAGE_COOK_DURATION
-            || sausage_->GetCookDuration() > MAX_SAUSAGE_COOK_DURATION) {
-            throw std::invalid_argument("Invalid sausage cook duration");
+        if (const std::error_code error = CheckIngredients(*sausage_, *bread_)) {
+            throw std::invalid_argument(error.message());
+        }
+    }
+
+    // Проверяет время приготовления ингредиентов без выбрасывания исключений.
+    // Возвращает пустой код, если из ингредиентов можно собрать хот-дог.
+    // Ингредиенты должны быть приготовлены
+    static std::error_code CheckIngredients(const Sausage& sausage, const Bread& bread) {
+        if (sausage.GetCookDuration() < MIN_SAUSAGE_COOK_DURATION
+            || sausage.GetCookDuration() > MAX_SAUSAGE_COOK_DURATION) {
+            return HotDogError::INVALID_SAUSAGE_COOK_DURATION;
         }
 
-        if (bread_->GetBakingDuration() < MIN_BREAD_COOK_DURATION
-            || bread_->GetBakingDuration() > MAX_BREAD_COOK_DURATION) {
-            throw std::invalid_argument("Invalid sausage cook duration");
+        if (bread.GetBakingDuration() < MIN_BREAD_COOK_DURATION
+            || bread.GetBakingDuration() > MAX_BREAD_COOK_DURATION) {
+            return HotDogError::INVALID_BREAD_COOK_DURATION;
         }
+        return {};
     }
 
     int GetId() const noexcept {
@@ -51,6 +98,6 @@ public:
 
 private:
     int id_;
-    std::shared_ptr<Sausage> sausage_;
-    std::shared_ptr<Bread> bread_;
+    SausagePtr sausage_;
+    BreadPtr bread_;
 };
@@ -0,0 +1,160 @@
+#ifdef _WIN32
+#include <sdkddkver.h>
+#endif
+
+#include <charconv>
+#include <condition_variable>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "allocation_counter.h"
+#include "ingredients.h"
+
+using namespace std::literals;
+
+namespace {
+
+unsigned ParseArg(int argc, const char* argv[], int index, unsigned default_value) {
+    if (argc <= index) {
+        return default_value;
+    }
+    const std::string_view arg = argv[index];
+    unsigned value = 0;
+    const auto [end, ec] = std::from_chars(arg.data(), arg.data() + arg.size(), value);
+    if (ec != std::errc{} || end != arg.data() + arg.size() || value == 0) {
+        throw std::invalid_argument("Invalid argument: "s + std::string(arg));
+    }
+    return value;
+}
+
+// Прежний способ получения ингредиентов: std::make_shared для каждого ингредиента
+struct SharedIngredients {
+    using Pair = std::pair<std::shared_ptr<Bread>, std::shared_ptr<Sausage>>;
+
+    Pair Make(int id) const {
+        return {std::make_shared<Bread>(id), std::make_shared<Sausage>(id + 1)};
+    }
+};
+
+// Ингредиенты из пулов Store
+struct PooledIngredients {
+    using Pair = std::pair<BreadPtr, SausagePtr>;
+
+    Pair Make(int id) const {
+        return {store.GetBread(id), store.GetSausage(id + 1)};
+    }
+
+    Store store;
+};
+
+void PrintStats(std::string_view name, std::string_view scenario, unsigned num_hot_dogs,
+                std::chrono::steady_clock::duration duration, std::uint64_t allocations) {
+    std::cout << name << ", "sv << scenario << ": "sv
+              << std::chrono::duration<double, std::nano>(duration).count() / num_hot_dogs
+              << " ns/hot dog, allocations per hot dog: "sv
+              << static_cast<double>(allocations) / num_hot_dogs << std::endl;
+}
+
+/*
+ * Получает ингредиенты для num_hot_dogs хот-догов в одном потоке. Одновременно существуют
+ * ингредиенты in_flight хот-догов: получение новых ингредиентов уничтожает самые старые.
+ */
+template <typename Ingredients>
+void RunSameThread(std::string_view name, const Ingredients& ingredients, unsigned num_hot_dogs,
+                   unsigned in_flight) {
+    std::vector<typename Ingredients::Pair> ring(in_flight);
+    const auto allocations_before = GetAllocationCount();
+    const auto start_time = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i < num_hot_dogs; ++i) {
+        ring[i % in_flight] = ingredients.Make(static_cast<int>(i * 2));
+    }
+    ring.clear();
+    PrintStats(name, "same thread"sv, num_hot_dogs, std::chrono::steady_clock::now() - start_time,
+               GetAllocationCount() - allocations_before);
+}
+
+/*
+ * Ингредиенты получает один поток, а уничтожает другой. Ингредиенты передаются пачками по
+ * batch_size хот-догов, как если бы хот-доги собирались и съедались в разных потоках.
+ */
+template <typename Ingredients>
+void RunCrossThread(std::string_view name, const Ingredients& ingredients, unsigned num_hot_dogs,
+                    unsigned batch_size) {
+    using Batch = std::vector<typename Ingredients::Pair>;
+    // Ограничивает количество переданных, но ещё не уничтоженных пачек
+    constexpr size_t MAX_READY_BATCHES = 4;
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<Batch> ready;
+    bool done = false;
+
+    const auto allocations_before = GetAllocationCount();
+    const auto start_time = std::chrono::steady_clock::now();
+    std::jthread consumer{[&] {
+        std::vector<Batch> batches;
+        std::unique_lock lock{mutex};
+        while (true) {
+            cv.wait(lock, [&] {
+                return done || !ready.empty();
+            });
+            batches.swap(ready);
+            const bool stop = done;
+            lock.unlock();
+            cv.notify_one();
+            // Ингредиенты уничтожаются в потоке-потребителе
+            batches.clear();
+            if (stop) {
+                return;
+            }
+            lock.lock();
+        }
+    }};
+
+    Batch batch;
+    for (unsigned i = 0; i < num_hot_dogs; ++i) {
+        batch.push_back(ingredients.Make(static_cast<int>(i * 2)));
+        if (batch.size() == batch_size || i + 1 == num_hot_dogs) {
+            {
+                std::unique_lock lock{mutex};
+                cv.wait(lock, [&] {
+                    return ready.size() < MAX_READY_BATCHES;
+                });
+                ready.push_back(std::move(batch));
+                done = i + 1 == num_hot_dogs;
+            }
+            cv.notify_one();
+            batch = Batch{};
+            batch.reserve(batch_size);
+        }
+    }
+    consumer.join();
+    PrintStats(name, "cross thread"sv, num_hot_dogs, std::chrono::steady_clock::now() - start_time,
+               GetAllocationCount() - allocations_before);
+}
+
+}  // namespace
+
+int main(int argc, const char* argv[]) {
+    try {
+        // ingredient_benchmark [<hot dogs> [<hot dogs in flight>]]
+        const unsigned num_hot_dogs = ParseArg(argc, argv, 1, 1'000'000);
+        const unsigned in_flight = ParseArg(argc, argv, 2, 1'000);
+
+        const SharedIngredients shared;
+        const PooledIngredients pooled;
+        RunSameThread("make_shared"sv, shared, num_hot_dogs, in_flight);
+        RunSameThread("Store pool"sv, pooled, num_hot_dogs, in_flight);
+        RunCrossThread("make_shared"sv, shared, num_hot_dogs, in_flight);
+        RunCrossThread("Store pool"sv, pooled, num_hot_dogs, in_flight);
+
+        std::cout << "Pool capacity: bread: "sv << SlabPool<Bread>::GetCapacity()
+                  << ", sausages: "sv << SlabPool<Sausage>::GetCapacity() << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+}
@@ -1,15 +1,18 @@
 #pragma once
+#include <boost/smart_ptr/intrusive_ptr.hpp>
 #include <functional>
 #include <optional>
 
 #include "clock.h"
 #include "gascooker.h"
+#include "slab_pool.h"
 
 /*
 Класс "Сосиска".
-Позволяет себя обжаривать на газовой плите
+Позволяет себя обжаривать на газовой плите.
+Сосиски размещаются в пуле и удерживаются через boost::intrusive_ptr
 */
-class Sausage : public std::enable_shared_from_this<Sausage> {
+class Sausage final : public PooledObject<Sausage> {
 public:
     using Handler = std::function<void()>;
 
@@ -35,8 +38,8 @@ public:
         gas_cooker_lock_ = GasCookerLock{cooker.shared_from_this()};
 
         // Занимаем горелку для начала обжаривания.
-        // Чтобы продлить жизнь текущего объекта, захватываем shared_ptr в лямбде
-        cooker.UseBurner([self = shared_from_this(), handler = std::move(handler)] {
+        // Чтобы продлить жизнь текущего объекта, захватываем intrusive_ptr в лямбде
+        cooker.UseBurner([self = boost::intrusive_ptr{this}, handler = std::move(handler)] {
             // Запоминаем время фактического начала обжаривания
             self->frying_start_time_ = Clock::now();
             handler();
@@ -75,7 +78,7 @@ private:
 };
 
 // Класс "Хлеб". Ведёт себя аналогично классу "Сосиска"
-class Bread : public std::enable_shared_from_this<Bread> {
+class Bread final : public PooledObject<Bread> {
 public:
     using Handler = std::function<void()>;
 
@@ -106,8 +109,8 @@ public:
         gas_cooker_lock_ = GasCookerLock{ cooker.shared_from_this() };
 
         // Занимаем горелку для начала обжаривания.
-        // Чтобы продлить жизнь текущего объекта, захватываем shared_ptr в лямбде
-        cooker.UseBurner([self = shared_from_this(), handler = std::move(handler)] {
+        // Чтобы продлить жизнь текущего объекта, захватываем intrusive_ptr в лямбде
+        cooker.UseBurner([self = boost::intrusive_ptr{this}, handler = std::move(handler)] {
             // Запоминаем время фактического начала обжаривания
             self->bake_start_time_ = Clock::now();
             handler();
@@ -159,15 +162,31 @@ private:
     std::optional<Clock::time_point> bake_end_time_;
 };
 
-// Склад ингредиентов (возвращает ингредиенты с уникальным id)
+using BreadPtr = boost::intrusive_ptr<Bread>;
+using SausagePtr = boost::intrusive_ptr<Sausage>;
+
+/*
+Склад ингредиентов (возвращает ингредиенты с уникальным id).
+Ингредиенты берутся из пулов SlabPool<Bread> и SlabPool<Sausage> и возвращаются в них, когда
+уничтожается последняя ссылка на ингредиент, например, вместе с хот-догом.
+*/
 class Store {
 public:
-    std::shared_ptr<Bread> GetBread() {
-        return std::make_shared<Bread>(++next_id_);
+    BreadPtr GetBread() {
+        return GetBread(++next_id_);
+    }
+
+    SausagePtr GetSausage() {
+        return GetSausage(++next_id_);
+    }
+
+    // Возвращают ингредиент с заданным id. Эти методы можно вызывать из разных потоков
+    BreadPtr GetBread(int id) const {
+        return BreadPtr{new Bread(id)};
     }
 
-    std::shared_ptr<Sausage> GetSausage() {
-        return std::make_shared<Sausage>(++next_id_);
+    SausagePtr GetSausage(int id) const {
+        return SausagePtr{new Sausage(id)};
     }
 
 private:
@@ -100,6 +100,9 @@ std::vector<HotDog> PrepareHotDogs(int num_orders, unsigned num_threads) {
         io.run();
     });
 
+    // Все заказы выполнены, поэтому состояния всех заказов должны вернуться в пул
+    assert(cafeteria.GetActiveOrderCount() == 0);
+
     return hotdogs;
 }
 
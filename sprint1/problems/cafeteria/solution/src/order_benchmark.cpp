@@ -0,0 +1,97 @@
+#ifdef _WIN32
+#include <sdkddkver.h>
+#endif
+
+#include <atomic>
+#include <charconv>
+#include <cstdlib>
+#include <iostream>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "allocation_counter.h"
+#include "cafeteria.h"
+
+using namespace std::literals;
+
+namespace {
+
+template <typename Fn>
+void RunWorkers(unsigned n, const Fn& fn) {
+    n = std::max(1u, n);
+    std::vector<std::jthread> workers;
+    workers.reserve(n - 1);
+    // Запускаем n-1 рабочих потоков, выполняющих функцию fn
+    while (--n) {
+        workers.emplace_back(fn);
+    }
+    fn();
+}
+
+unsigned ParseArg(int argc, const char* argv[], int index, unsigned default_value) {
+    if (argc <= index) {
+        return default_value;
+    }
+    const std::string_view arg = argv[index];
+    unsigned value = 0;
+    const auto [end, ec] = std::from_chars(arg.data(), arg.data() + arg.size(), value);
+    if (ec != std::errc{} || end != arg.data() + arg.size() || value == 0) {
+        throw std::invalid_argument("Invalid argument: "s + std::string(arg));
+    }
+    return value;
+}
+
+/*
+ * Выполняет несколько раундов по num_orders заказов в одном кафетерии и выводит количество
+ * выделений памяти на заказ. В первом раунде заполняются пулы, поэтому выделений больше.
+ * Время приготовления ингредиентов не сокращается, поэтому раунд длится несколько секунд.
+ */
+void RunBenchmark(unsigned num_threads, unsigned num_orders, unsigned num_rounds) {
+    net::io_context io{static_cast<int>(num_threads)};
+    Cafeteria cafeteria{io};
+
+    for (unsigned round = 1; round <= num_rounds; ++round) {
+        std::atomic_uint cooked{0};
+        const auto allocations_before = GetAllocationCount();
+        for (unsigned i = 0; i < num_orders; ++i) {
+            net::post(io, [&cafeteria, &cooked] {
+                cafeteria.OrderHotDog([&cooked](Result<HotDog> result) {
+                    if (result.HasValue()) {
+                        cooked.fetch_add(1, std::memory_order_relaxed);
+                    }
+                });
+            });
+        }
+
+        io.restart();
+        RunWorkers(num_threads, [&io] {
+            io.run();
+        });
+        const auto allocations = GetAllocationCount() - allocations_before;
+
+        // Проверка утечек: все заказы должны вернуться в пул
+        if (cooked != num_orders || cafeteria.GetActiveOrderCount() != 0) {
+            throw std::logic_error("Not all orders have been completed");
+        }
+        std::cout << "Round "sv << round << ": orders: "sv << num_orders
+                  << ", allocations per order: "sv << static_cast<double>(allocations) / num_orders
+                  << ", order states allocated: "sv << cafeteria.GetAllocatedOrderCount()
+                  << std::endl;
+    }
+}
+
+}  // namespace
+
+int main(int argc, const char* argv[]) {
+    try {
+        // order_benchmark [<orders per round> [<rounds> [<threads>]]]
+        const unsigned num_orders = ParseArg(argc, argv, 1, 16);
+        const unsigned num_rounds = ParseArg(argc, argv, 2, 3);
+        const unsigned num_threads = ParseArg(argc, argv, 3, 4);
+        RunBenchmark(num_threads, num_orders, num_rounds);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+}
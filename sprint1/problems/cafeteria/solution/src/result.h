@@ -1,9 +1,15 @@
 #pragma once
 #include <stdexcept>
+#include <system_error>
 #include <type_traits>
 #include <variant>
 
-// Вспомогательный класс Result, способный хранить либо значение, либо исключение
+/*
+Вспомогательный класс Result, способный хранить либо значение, либо ошибку.
+Ошибка хранится как исключение (std::exception_ptr) или как код ошибки (std::error_code).
+Код ошибки не требует выделения памяти, поэтому его стоит использовать для ожидаемых отказов,
+которые могут происходить часто. Интерфейс для работы со значением аналогичен std::expected.
+*/
 template <typename ValueType>
 class Result {
 public:
@@ -33,6 +39,26 @@ public:
         }
     }
 
+    /*
+     * Конструирует результат, хранящий код ошибки.
+     * Способ использования:
+     *
+     * Result<тип> result{std::make_error_code(std::errc::timed_out)};
+     */
+    explicit Result(std::error_code error)
+        : state_{error} {
+        if (!error) {
+            throw std::invalid_argument("Error code must not be empty");
+        }
+    }
+
+    // Конструирует результат, хранящий код ошибки из перечисления кодов ошибок
+    template <typename ErrorCodeEnum>
+        requires std::is_error_code_enum_v<ErrorCodeEnum>
+    Result(ErrorCodeEnum error)
+        : Result{std::error_code{make_error_code(error)}} {
+    }
+
     /*
      * Создаёт результат, который хранит ссылку на текущее выброшенное исключение
      * Способ использования:
@@ -51,30 +77,87 @@ public:
         return std::holds_alternative<ValueType>(state_);
     }
 
-    // Если внутри Result хранится исключение, то возвращает указатель на него
+    explicit operator bool() const noexcept {
+        return HasValue();
+    }
+
+    // Сообщает, хранится ли ошибка в виде кода ошибки
+    bool HasErrorCode() const noexcept {
+        return std::holds_alternative<std::error_code>(state_);
+    }
+
+    // Возвращает код ошибки. Если Result не хранит код ошибки, возвращает пустой код
+    std::error_code GetErrorCode() const noexcept {
+        const auto error = std::get_if<std::error_code>(&state_);
+        return error ? *error : std::error_code{};
+    }
+
+    // Если внутри Result хранится ошибка, то возвращает указатель на исключение. Код ошибки
+    // преобразуется в исключение std::system_error. Если хранится значение, выбрасывает
+    // std::bad_variant_access
     std::exception_ptr GetError() const {
+        if (auto error = std::get_if<std::error_code>(&state_)) {
+            return std::make_exception_ptr(std::system_error{*error});
+        }
         return std::get<std::exception_ptr>(state_);
     }
 
-    // Если внутри содержится исключение, то выбрасывает его. Иначе не делает ничего.
+    // Если внутри содержится ошибка, то выбрасывает её. Иначе не делает ничего.
+    // Код ошибки выбрасывается как std::system_error
     void ThrowIfHoldsError() const {
         if (auto e = std::get_if<std::exception_ptr>(&state_)) {
             std::rethrow_exception(*e);
         }
+        if (auto error = std::get_if<std::error_code>(&state_)) {
+            throw std::system_error{*error};
+        }
     }
 
-    // Возвращает ссылку на хранящееся значение. Если Result хранит исключение, выбрасывает
+    // Возвращает ссылку на хранящееся значение. Если Result хранит ошибку, выбрасывает
     // std::bad_variant_access
     const ValueType& GetValue() const& {
         return std::get<ValueType>(state_);
     }
 
-    // Возвращает rvalue-ссылку на хранящееся значение. Если Result хранит исключение, выбрасывает
+    ValueType& GetValue() & {
+        return std::get<ValueType>(state_);
+    }
+
+    // Возвращает rvalue-ссылку на хранящееся значение. Если Result хранит ошибку, выбрасывает
     // std::bad_variant_access
     ValueType&& GetValue() && {
         return std::get<ValueType>(std::move(state_));
     }
 
+    // Возвращает хранящееся значение либо default_value, если Result хранит ошибку
+    template <typename U>
+    ValueType ValueOr(U&& default_value) const& {
+        return HasValue() ? GetValue() : static_cast<ValueType>(std::forward<U>(default_value));
+    }
+
+    template <typename U>
+    ValueType ValueOr(U&& default_value) && {
+        return HasValue() ? std::move(*this).GetValue()
+                          : static_cast<ValueType>(std::forward<U>(default_value));
+    }
+
+    // Доступ к значению без проверки. Result должен хранить значение
+    const ValueType& operator*() const& noexcept {
+        return *std::get_if<ValueType>(&state_);
+    }
+
+    ValueType& operator*() & noexcept {
+        return *std::get_if<ValueType>(&state_);
+    }
+
+    const ValueType* operator->() const noexcept {
+        return std::get_if<ValueType>(&state_);
+    }
+
+    ValueType* operator->() noexcept {
+        return std::get_if<ValueType>(&state_);
+    }
+
 private:
-    std::variant<ValueType, std::exception_ptr> state_;
+    std::variant<ValueType, std::exception_ptr, std::error_code> state_;
 };
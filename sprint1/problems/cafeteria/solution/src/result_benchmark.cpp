@@ -0,0 +1,124 @@
+#ifdef _WIN32
+#include <sdkddkver.h>
+#endif
+
+#include <charconv>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <string_view>
+
+#include "allocation_counter.h"
+#include "hotdog.h"
+#include "result.h"
+#include "virtual_clock.h"
+
+using namespace std::literals;
+
+namespace {
+
+unsigned ParseArg(int argc, const char* argv[], int index, unsigned default_value) {
+    if (argc <= index) {
+        return default_value;
+    }
+    const std::string_view arg = argv[index];
+    unsigned value = 0;
+    const auto [end, ec] = std::from_chars(arg.data(), arg.data() + arg.size(), value);
+    if (ec != std::errc{} || end != arg.data() + arg.size() || value == 0) {
+        throw std::invalid_argument("Invalid argument: "s + std::string(arg));
+    }
+    return value;
+}
+
+// Готовит хот-дог в модельном времени, чтобы не ждать приготовления ингредиентов
+HotDog MakeHotDog() {
+    VirtualClock clock;
+    net::io_context io;
+    auto cooker = std::make_shared<GasCooker>(io);
+    const Store store;
+    auto bread = store.GetBread(1);
+    auto sausage = store.GetSausage(2);
+    bread->StartBake(*cooker, [] {});
+    sausage->StartFry(*cooker, [] {});
+    clock.Run(io);
+    clock.Advance(HotDog::MIN_SAUSAGE_COOK_DURATION);
+    bread->StopBaking();
+    sausage->StopFry();
+    return HotDog{3, std::move(sausage), std::move(bread)};
+}
+
+/*
+ * Передаёт num_results результатов через обработчик, как это делает Cafeteria. Каждый второй
+ * результат содержит ошибку, созданную make_error. Если inspect_error равен true, обработчик
+ * определяет причину ошибки, иначе только проверяет наличие значения.
+ */
+template <typename MakeError>
+void RunBenchmark(std::string_view name, const HotDog& hot_dog, unsigned num_results,
+                  bool inspect_error, const MakeError& make_error) {
+    unsigned cooked = 0;
+    unsigned sausage_errors = 0;
+    const std::function<void(Result<HotDog>)> handler = [&, inspect_error](
+                                                            Result<HotDog> result) {
+        if (result) {
+            ++cooked;
+            return;
+        }
+        if (!inspect_error) {
+            return;
+        }
+        if (result.HasErrorCode()) {
+            sausage_errors +=
+                result.GetErrorCode() == HotDogError::INVALID_SAUSAGE_COOK_DURATION;
+            return;
+        }
+        try {
+            result.ThrowIfHoldsError();
+        } catch (const std::invalid_argument&) {
+            ++sausage_errors;
+        }
+    };
+
+    const auto allocations_before = GetAllocationCount();
+    const auto start_time = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i < num_results; ++i) {
+        if (i % 2 == 0) {
+            handler(hot_dog);
+        } else {
+            handler(make_error());
+        }
+    }
+    const std::chrono::duration<double, std::nano> duration =
+        std::chrono::steady_clock::now() - start_time;
+    const auto allocations = GetAllocationCount() - allocations_before;
+
+    const unsigned num_errors = num_results - num_results / 2 - num_results % 2;
+    if (cooked != num_results - num_errors || sausage_errors != (inspect_error ? num_errors : 0)) {
+        throw std::logic_error("Results have been lost");
+    }
+    std::cout << name << (inspect_error ? ", inspect error"sv : ", check value"sv) << ": "sv
+              << duration.count() / num_results << " ns/result, allocations per error: "sv
+              << static_cast<double>(allocations) / num_errors << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, const char* argv[]) {
+    try {
+        // result_benchmark [<results>]
+        const unsigned num_results = ParseArg(argc, argv, 1, 1'000'000);
+        const HotDog hot_dog = MakeHotDog();
+
+        for (const bool inspect_error : {false, true}) {
+            RunBenchmark("exception_ptr"sv, hot_dog, num_results, inspect_error, [] {
+                return Result<HotDog>{std::make_exception_ptr(
+                    std::invalid_argument{"Invalid sausage cook duration"})};
+            });
+            RunBenchmark("error_code"sv, hot_dog, num_results, inspect_error, [] {
+                return Result<HotDog>{HotDogError::INVALID_SAUSAGE_COOK_DURATION};
+            });
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,120 @@
+#ifdef _WIN32
+#include <sdkddkver.h>
+#endif
+
+#include <algorithm>
+#include <charconv>
+#include <cstdlib>
+#include <iostream>
+#include <string_view>
+#include <vector>
+
+#include "cafeteria.h"
+
+using namespace std::literals;
+
+namespace {
+
+// Количество горелок газовой плиты кафетерия
+constexpr int NUM_BURNERS = 8;
+
+unsigned ParseArg(int argc, const char* argv[], int index, unsigned default_value) {
+    if (argc <= index) {
+        return default_value;
+    }
+    const std::string_view arg = argv[index];
+    unsigned value = 0;
+    const auto [end, ec] = std::from_chars(arg.data(), arg.data() + arg.size(), value);
+    if (ec != std::errc{} || end != arg.data() + arg.size()) {
+        throw std::invalid_argument("Invalid argument: "s + std::string(arg));
+    }
+    return value;
+}
+
+double AsSeconds(Clock::duration d) {
+    return std::chrono::duration<double>(d).count();
+}
+
+/*
+ * Выполняет num_orders заказов в модельном времени. Заказы поступают с интервалом
+ * order_interval. Выводит модельную и реальную длительность, время выполнения заказов и
+ * загрузку горелок. Загрузка больше 1 означает, что одновременно использовалось больше
+ * горелок, чем есть у плиты.
+ */
+void RunSimulation(unsigned num_orders, Milliseconds order_interval) {
+    VirtualClock clock;
+    net::io_context io{1};
+    Cafeteria cafeteria{io};
+
+    struct OrderStats {
+        unsigned cooked = 0;
+        unsigned rejected = 0;
+        // Суммарное время использования горелок
+        Clock::duration burner_time{};
+        std::vector<Clock::duration> latencies;
+    } stats;
+    stats.latencies.reserve(num_orders);
+
+    const auto start_time = Clock::now();
+    for (unsigned i = 0; i < num_orders; ++i) {
+        const auto order_time = start_time + order_interval * i;
+        clock.Schedule(order_time, [&cafeteria, &stats, order_time] {
+            cafeteria.OrderHotDog([&stats, order_time](Result<HotDog> result) {
+                stats.latencies.push_back(Clock::now() - order_time);
+                if (!result.HasValue()) {
+                    ++stats.rejected;
+                    return;
+                }
+                const HotDog& hot_dog = result.GetValue();
+                stats.burner_time += hot_dog.GetBread().GetBakingDuration()
+                                   + hot_dog.GetSausage().GetCookDuration();
+                ++stats.cooked;
+            });
+        });
+    }
+
+    const auto wall_start = std::chrono::steady_clock::now();
+    clock.Run(io);
+    const auto wall_duration = std::chrono::steady_clock::now() - wall_start;
+    const auto duration = Clock::now() - start_time;
+
+    if (stats.latencies.size() != num_orders || cafeteria.GetActiveOrderCount() != 0) {
+        throw std::logic_error("Not all orders have been completed");
+    }
+    const double utilization =
+        duration.count() > 0 ? AsSeconds(stats.burner_time) / AsSeconds(duration) / NUM_BURNERS
+                             : 0;
+    if (utilization > 1) {
+        throw std::logic_error("Burner limit has been exceeded");
+    }
+
+    std::cout << "Orders: "sv << num_orders << ", cooked: "sv << stats.cooked
+              << ", rejected: "sv << stats.rejected << std::endl;
+    std::cout << "Simulated time: "sv << AsSeconds(duration) << "s, wall time: "sv
+              << AsSeconds(wall_duration) << "s, burner utilization: "sv << utilization
+              << std::endl;
+    if (!stats.latencies.empty()) {
+        auto& latencies = stats.latencies;
+        std::sort(latencies.begin(), latencies.end());
+        const auto percentile = [&latencies](double p) {
+            return AsSeconds(latencies[static_cast<size_t>(p * (latencies.size() - 1))]);
+        };
+        std::cout << "Order latency: min "sv << percentile(0) << "s, p50 "sv << percentile(0.5)
+                  << "s, p99 "sv << percentile(0.99) << "s, max "sv << percentile(1) << 's'
+                  << std::endl;
+    }
+}
+
+}  // namespace
+
+int main(int argc, const char* argv[]) {
+    try {
+        // cafeteria_simulation [<orders> [<order interval, ms>]]
+        const unsigned num_orders = ParseArg(argc, argv, 1, 10'000);
+        const Milliseconds order_interval{ParseArg(argc, argv, 2, 0)};
+        RunSimulation(num_orders, order_interval);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+}
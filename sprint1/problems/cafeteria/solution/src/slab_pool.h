@@ -0,0 +1,164 @@
+#pragma once
+#include <boost/smart_ptr/intrusive_ref_counter.hpp>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+/*
+Пул объектов типа T.
+Память выделяется блоками (slab) по BATCH_SIZE объектов и не возвращается системе до
+завершения программы. Освобождённый объект помещается в список свободных объектов потока,
+который его освободил, и повторно используется этим потоком без синхронизации.
+Если в списке потока накопилось 2 * BATCH_SIZE объектов, BATCH_SIZE из них переносятся в общий
+список пачек, откуда их забирают потоки с пустым списком. Поэтому объекты, которые создаются в
+одном потоке, а уничтожаются в другом, тоже используются повторно.
+Методы класса можно вызывать из разных потоков.
+*/
+template <typename T>
+class SlabPool {
+public:
+    static constexpr size_t BATCH_SIZE = 64;
+
+    static void* Allocate() {
+        LocalCache& cache = cache_;
+        if (!cache.head) {
+            Refill(cache);
+        }
+        --cache.count;
+        return std::exchange(cache.head, cache.head->next);
+    }
+
+    static void Deallocate(void* ptr) noexcept {
+        LocalCache& cache = cache_;
+        // Поток, который только освобождает созданные другими потоками объекты, тоже должен
+        // вернуть их в общий список при завершении
+        if (!cache.releaser_registered) [[unlikely]] {
+            RegisterReleaser(cache);
+        }
+        cache.head = ::new (ptr) Node{.next = cache.head};
+        if (++cache.count < BATCH_SIZE * 2) {
+            return;
+        }
+        // Отделяем от списка потока первые BATCH_SIZE объектов
+        Node* last = cache.head;
+        for (size_t i = 1; i < BATCH_SIZE; ++i) {
+            last = last->next;
+        }
+        Node* batch = std::exchange(cache.head, last->next);
+        last->next = nullptr;
+        cache.count -= BATCH_SIZE;
+        GetShared().PutBatch(batch, BATCH_SIZE);
+    }
+
+    // Количество объектов во всех выделенных блоках, включая свободные
+    static size_t GetCapacity() {
+        Shared& shared = GetShared();
+        std::lock_guard lock{shared.mutex};
+        return shared.slabs.size() * BATCH_SIZE;
+    }
+
+private:
+    union Node {
+        Node* next;
+        alignas(T) std::byte storage[sizeof(T)];
+    };
+
+    struct Shared {
+        std::mutex mutex;
+        // Пачки свободных объектов: начало списка и его длина
+        std::vector<std::pair<Node*, size_t>> batches;
+        std::vector<std::unique_ptr<Node[]>> slabs;
+
+        std::pair<Node*, size_t> TakeBatch() {
+            std::lock_guard lock{mutex};
+            if (!batches.empty()) {
+                const auto batch = batches.back();
+                batches.pop_back();
+                return batch;
+            }
+            auto& slab = slabs.emplace_back(std::make_unique<Node[]>(BATCH_SIZE));
+            for (size_t i = 0; i + 1 < BATCH_SIZE; ++i) {
+                slab[i].next = &slab[i + 1];
+            }
+            slab[BATCH_SIZE - 1].next = nullptr;
+            return {slab.get(), BATCH_SIZE};
+        }
+
+        void PutBatch(Node* head, size_t count) noexcept {
+            std::lock_guard lock{mutex};
+            try {
+                batches.emplace_back(head, count);
+            } catch (...) {
+                // Не удалось сохранить пачку. Её объекты больше не будут использоваться
+            }
+        }
+    };
+
+    // Список свободных объектов потока. Тривиально разрушаемый объект thread_local доступен
+    // без проверки инициализации, поэтому возврат списка при завершении потока выполняет
+    // отдельный объект CacheReleaser
+    struct LocalCache {
+        Node* head = nullptr;
+        size_t count = 0;
+        bool releaser_registered = false;
+    };
+
+    struct CacheReleaser {
+        ~CacheReleaser() {
+            LocalCache& cache = cache_;
+            if (cache.head) {
+                GetShared().PutBatch(std::exchange(cache.head, nullptr), cache.count);
+                cache.count = 0;
+            }
+        }
+    };
+
+    // Регистрирует возврат списка в общий при завершении потока. Вызывается при первом
+    // обращении потока к списку, будь то создание или освобождение объекта
+    static void RegisterReleaser(LocalCache& cache) noexcept {
+        static thread_local CacheReleaser releaser;
+        cache.releaser_registered = true;
+    }
+
+    static void Refill(LocalCache& cache) {
+        if (!cache.releaser_registered) {
+            RegisterReleaser(cache);
+        }
+        std::tie(cache.head, cache.count) = GetShared().TakeBatch();
+    }
+
+    // Общее состояние не разрушается, так как объекты могут освобождаться при завершении
+    // программы после разрушения статических объектов
+    static Shared& GetShared() {
+        static Shared* const shared = new Shared;
+        return *shared;
+    }
+
+    static constinit inline thread_local LocalCache cache_;
+};
+
+/*
+Базовый класс объектов, размещаемых в SlabPool. Содержит потокобезопасный счётчик ссылок для
+boost::intrusive_ptr: когда уничтожается последняя ссылка, объект возвращается в пул.
+Наследники должны быть объявлены как final, так как пул хранит объекты размера sizeof(T).
+*/
+template <typename T>
+class PooledObject : public boost::intrusive_ref_counter<T, boost::thread_safe_counter> {
+public:
+    static void* operator new(std::size_t size) {
+        assert(size == sizeof(T));
+        return SlabPool<T>::Allocate();
+    }
+
+    static void operator delete(void* ptr) noexcept {
+        SlabPool<T>::Deallocate(ptr);
+    }
+
+protected:
+    PooledObject() = default;
+    ~PooledObject() = default;
+};
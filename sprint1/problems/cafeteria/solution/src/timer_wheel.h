@@ -0,0 +1,369 @@
+#pragma once
+#ifdef _WIN32
+#include <sdkddkver.h>
+#endif
+
+#include <boost/asio/error.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+
+#include "virtual_clock.h"
+
+class WheelTimer;
+
+/*
+Иерархическое колесо таймеров.
+Обслуживает произвольное количество таймеров WheelTimer с помощью одного
+boost::asio::steady_timer. Время делится на тики длительностью resolution. Колесо состоит
+из LEVELS уровней по SLOTS ячеек. Ячейка уровня 0 соответствует одному тику, ячейка уровня 1 -
+SLOTS тикам и т.д. Таймер помещается в ячейку того уровня, на котором его время срабатывания
+отличается от текущего. Когда время доходит до ячейки верхнего уровня, её таймеры
+перераспределяются по нижним уровням. Таймеры, которые не помещаются в колесо, хранятся в
+отдельном списке и перераспределяются при каждом полном обороте колеса.
+Постановка и отмена таймера выполняются за O(1) и не выделяют память.
+
+Таймер никогда не срабатывает раньше заданного времени, но может сработать позже на время
+до resolution. Обработчики таймеров вызываются через net::post в потоках, вызывающих
+io_context::run. Методы класса можно вызывать из разных потоков.
+
+Колесо, созданное в потоке с VirtualClock, работает в модельном времени: вместо timer_
+оно планирует событие VirtualClock, а io_context выполняется методом VirtualClock::Run.
+*/
+class TimerWheel {
+public:
+    using Clock = SteadyClock;
+
+    static constexpr unsigned SLOT_BITS = 6;
+    static constexpr unsigned SLOTS = 1u << SLOT_BITS;
+    static constexpr unsigned LEVELS = 4;
+
+    explicit TimerWheel(boost::asio::io_context& io,
+                        Clock::duration resolution = std::chrono::milliseconds{1})
+        : io_{io}
+        , timer_{io}
+        , resolution_{resolution} {
+        if (resolution <= Clock::duration::zero()) {
+            throw std::invalid_argument("Timer wheel resolution must be positive");
+        }
+    }
+
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+
+    ~TimerWheel() {
+        // Таймеры должны быть уничтожены или отменены раньше колеса
+        assert(pending_count_ == 0);
+        if (virtual_event_) {
+            virtual_clock_->Cancel(*virtual_event_);
+        }
+    }
+
+    boost::asio::io_context& GetIoContext() const noexcept {
+        return io_;
+    }
+
+    // Количество таймеров, ожидающих срабатывания
+    size_t GetPendingCount() const {
+        std::lock_guard lock{mutex_};
+        return pending_count_;
+    }
+
+private:
+    friend class WheelTimer;
+
+    // Узел интрузивного двусвязного кольцевого списка
+    struct Hook {
+        Hook* prev = this;
+        Hook* next = this;
+
+        bool IsEmpty() const noexcept {
+            return next == this;
+        }
+
+        void PushBack(Hook* node) noexcept {
+            node->prev = prev;
+            node->next = this;
+            prev->next = node;
+            prev = node;
+        }
+
+        void Unlink() noexcept {
+            prev->next = next;
+            next->prev = prev;
+            prev = next = this;
+        }
+    };
+
+    using Tick = std::uint64_t;
+
+    Tick GetTickAtOrAfter(Clock::time_point time) const noexcept {
+        if (time <= start_) {
+            return 0;
+        }
+        return static_cast<Tick>((time - start_ + resolution_ - Clock::duration{1}) / resolution_);
+    }
+
+    Tick GetTickBefore(Clock::time_point time) const noexcept {
+        return time <= start_ ? 0 : static_cast<Tick>((time - start_) / resolution_);
+    }
+
+    // Методы ниже вызываются при захваченном mutex_
+    void Insert(WheelTimer& timer) noexcept;
+    void Remove(WheelTimer& timer) noexcept;
+    void Link(WheelTimer& timer) noexcept;
+    void Advance(Tick now_tick);
+    void Expire(Hook& slot);
+    void Arm();
+
+    void OnTimer(boost::system::error_code ec);
+
+    boost::asio::io_context& io_;
+    mutable std::mutex mutex_;
+    boost::asio::steady_timer timer_;
+    // Модельное время потока, создавшего колесо, и запланированное в нём срабатывание
+    VirtualClock* const virtual_clock_ = VirtualClock::GetCurrent();
+    std::optional<VirtualClock::EventId> virtual_event_;
+    const Clock::duration resolution_;
+    const Clock::time_point start_ = Clock::now();
+
+    Tick current_tick_ = 0;
+    std::array<std::array<Hook, SLOTS>, LEVELS> slots_;
+    // Битовые маски непустых ячеек каждого уровня
+    std::array<std::uint64_t, LEVELS> occupied_{};
+    static_assert(SLOTS <= 64);
+    // Таймеры, срабатывающие позже, чем через полный оборот колеса
+    Hook overflow_;
+    size_t pending_count_ = 0;
+
+    // Тик, на который взведён timer_
+    bool armed_ = false;
+    Tick armed_tick_ = 0;
+};
+
+/*
+Таймер, обслуживаемый колесом таймеров. Интерфейс аналогичен boost::asio::steady_timer,
+но одновременно может ожидаться только одно срабатывание таймера.
+При отмене или уничтожении таймера обработчик вызывается с ошибкой
+boost::asio::error::operation_aborted.
+*/
+class WheelTimer : private TimerWheel::Hook {
+public:
+    using Clock = TimerWheel::Clock;
+    using Handler = std::function<void(boost::system::error_code ec)>;
+
+    explicit WheelTimer(TimerWheel& wheel) noexcept
+        : wheel_{wheel} {
+    }
+
+    WheelTimer(TimerWheel& wheel, Clock::duration expiry_time)
+        : wheel_{wheel}
+        , expiry_{Clock::now() + expiry_time} {
+    }
+
+    WheelTimer(const WheelTimer&) = delete;
+    WheelTimer& operator=(const WheelTimer&) = delete;
+
+    ~WheelTimer() {
+        Cancel();
+    }
+
+    // Задаёт время срабатывания. Ожидание, если оно было начато, отменяется.
+    // Возвращает количество отменённых ожиданий
+    size_t ExpiresAt(Clock::time_point expiry) {
+        std::lock_guard lock{wheel_.mutex_};
+        const size_t cancelled = CancelLocked();
+        expiry_ = expiry;
+        return cancelled;
+    }
+
+    size_t ExpiresAfter(Clock::duration expiry_time) {
+        return ExpiresAt(Clock::now() + expiry_time);
+    }
+
+    Clock::time_point GetExpiry() const {
+        std::lock_guard lock{wheel_.mutex_};
+        return expiry_;
+    }
+
+    // Начинает ожидание срабатывания таймера
+    void AsyncWait(Handler handler) {
+        std::lock_guard lock{wheel_.mutex_};
+        if (handler_) {
+            throw std::logic_error("Timer is already being waited");
+        }
+        handler_ = std::move(handler);
+        wheel_.Insert(*this);
+    }
+
+    // Отменяет ожидание. Возвращает количество отменённых ожиданий
+    size_t Cancel() {
+        std::lock_guard lock{wheel_.mutex_};
+        return CancelLocked();
+    }
+
+private:
+    friend class TimerWheel;
+
+    size_t CancelLocked() {
+        if (!handler_) {
+            return 0;
+        }
+        wheel_.Remove(*this);
+        Complete(boost::asio::error::operation_aborted);
+        return 1;
+    }
+
+    void Complete(boost::system::error_code ec) {
+        boost::asio::post(wheel_.io_, [handler = std::move(handler_), ec] {
+            handler(ec);
+        });
+        handler_ = nullptr;
+    }
+
+    TimerWheel& wheel_;
+    Clock::time_point expiry_ = Clock::now();
+    TimerWheel::Tick expiry_tick_ = 0;
+    Handler handler_;
+    // Уровень и ячейка колеса, в которой находится таймер. Уровень LEVELS означает
+    // список таймеров, не поместившихся в колесо
+    std::uint8_t level_ = 0;
+    std::uint8_t slot_ = 0;
+};
+
+inline void TimerWheel::Insert(WheelTimer& timer) noexcept {
+    // Таймер срабатывает не раньше следующего тика, так как текущий тик уже обработан
+    timer.expiry_tick_ = std::max(GetTickAtOrAfter(timer.expiry_), current_tick_ + 1);
+    Link(timer);
+    ++pending_count_;
+    Arm();
+}
+
+inline void TimerWheel::Link(WheelTimer& timer) noexcept {
+    const Tick diff = timer.expiry_tick_ ^ current_tick_;
+    if (diff >> (SLOT_BITS * LEVELS)) {
+        timer.level_ = LEVELS;
+        overflow_.PushBack(&timer);
+        return;
+    }
+    const unsigned level = diff ? (std::bit_width(diff) - 1) / SLOT_BITS : 0;
+    const unsigned slot = (timer.expiry_tick_ >> (SLOT_BITS * level)) & (SLOTS - 1);
+    timer.level_ = static_cast<std::uint8_t>(level);
+    timer.slot_ = static_cast<std::uint8_t>(slot);
+    slots_[level][slot].PushBack(&timer);
+    occupied_[level] |= std::uint64_t{1} << slot;
+}
+
+inline void TimerWheel::Remove(WheelTimer& timer) noexcept {
+    timer.Unlink();
+    if (timer.level_ < LEVELS && slots_[timer.level_][timer.slot_].IsEmpty()) {
+        occupied_[timer.level_] &= ~(std::uint64_t{1} << timer.slot_);
+    }
+    --pending_count_;
+}
+
+inline void TimerWheel::Advance(Tick now_tick) {
+    while (current_tick_ < now_tick) {
+        if (pending_count_ == 0) {
+            // Пустое колесо можно сразу перевести на текущий тик
+            current_tick_ = now_tick;
+            break;
+        }
+        ++current_tick_;
+
+        // При переходе через границу ячейки верхнего уровня её таймеры
+        // перераспределяются по нижним уровням
+        for (unsigned level = 1; level <= LEVELS; ++level) {
+            if (current_tick_ & ((Tick{1} << (SLOT_BITS * level)) - 1)) {
+                break;
+            }
+            Hook& list = level < LEVELS
+                             ? slots_[level][(current_tick_ >> (SLOT_BITS * level)) & (SLOTS - 1)]
+                             : overflow_;
+            Hook cascaded;
+            while (!list.IsEmpty()) {
+                Hook* node = list.next;
+                node->Unlink();
+                cascaded.PushBack(node);
+            }
+            if (level < LEVELS) {
+                occupied_[level] &= ~(std::uint64_t{1} << ((current_tick_ >> (SLOT_BITS * level))
+                                                           & (SLOTS - 1)));
+            }
+            while (!cascaded.IsEmpty()) {
+                Hook* node = cascaded.next;
+                node->Unlink();
+                Link(static_cast<WheelTimer&>(*node));
+            }
+        }
+
+        Expire(slots_[0][current_tick_ & (SLOTS - 1)]);
+        occupied_[0] &= ~(std::uint64_t{1} << (current_tick_ & (SLOTS - 1)));
+    }
+}
+
+inline void TimerWheel::Expire(Hook& slot) {
+    while (!slot.IsEmpty()) {
+        auto& timer = static_cast<WheelTimer&>(*slot.next);
+        assert(timer.expiry_tick_ == current_tick_);
+        timer.Unlink();
+        --pending_count_;
+        timer.Complete({});
+    }
+}
+
+inline void TimerWheel::Arm() {
+    if (pending_count_ == 0) {
+        return;
+    }
+    // Ближайшее событие - срабатывание таймера уровня 0 или переход к следующей ячейке уровня 1
+    const unsigned index = current_tick_ & (SLOTS - 1);
+    const std::uint64_t later_slots =
+        index + 1 < 64 ? occupied_[0] & (~std::uint64_t{0} << (index + 1)) : 0;
+    const Tick next_tick = later_slots ? (current_tick_ - index) + std::countr_zero(later_slots)
+                                       : (current_tick_ | (SLOTS - 1)) + 1;
+    if (armed_ && armed_tick_ <= next_tick) {
+        return;
+    }
+    armed_ = true;
+    armed_tick_ = next_tick;
+    const Clock::time_point expiry = start_ + next_tick * resolution_;
+    if (virtual_clock_) {
+        // Как и перевзведение timer_, перепланирование отменяет прежнее событие
+        if (virtual_event_) {
+            virtual_clock_->Cancel(*virtual_event_);
+        }
+        virtual_event_ = virtual_clock_->Schedule(expiry, [this] {
+            OnTimer({});
+        });
+        return;
+    }
+    timer_.expires_at(std::chrono::steady_clock::time_point{expiry.time_since_epoch()});
+    timer_.async_wait([this](boost::system::error_code ec) {
+        OnTimer(ec);
+    });
+}
+
+inline void TimerWheel::OnTimer(boost::system::error_code ec) {
+    if (ec == boost::asio::error::operation_aborted) {
+        // Таймер был перевзведён на более раннее время
+        return;
+    }
+    std::lock_guard lock{mutex_};
+    virtual_event_.reset();
+    const Tick now_tick = GetTickBefore(Clock::now());
+    if (now_tick >= armed_tick_) {
+        armed_ = false;
+    }
+    Advance(now_tick);
+    Arm();
+}
@@ -0,0 +1,151 @@
+#ifdef _WIN32
+#include <sdkddkver.h>
+#endif
+
+#include <boost/asio/steady_timer.hpp>
+#include <charconv>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string_view>
+#include <vector>
+
+#include "timer_wheel.h"
+
+namespace net = boost::asio;
+namespace sys = boost::system;
+using namespace std::literals;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+unsigned ParseArg(int argc, const char* argv[], int index, unsigned default_value) {
+    if (argc <= index) {
+        return default_value;
+    }
+    const std::string_view arg = argv[index];
+    unsigned value = 0;
+    const auto [end, ec] = std::from_chars(arg.data(), arg.data() + arg.size(), value);
+    if (ec != std::errc{} || end != arg.data() + arg.size() || value == 0) {
+        throw std::invalid_argument("Invalid argument: "s + std::string(arg));
+    }
+    return value;
+}
+
+struct BenchmarkStats {
+    // Количество сработавших и отменённых таймеров
+    size_t fired = 0;
+    size_t cancelled = 0;
+    // Количество таймеров, сработавших раньше времени
+    size_t early = 0;
+    // Наибольшее опоздание срабатывания таймера
+    Clock::duration max_lateness{};
+};
+
+double AsNanoseconds(Clock::duration d, size_t count) {
+    return std::chrono::duration<double, std::nano>(d).count() / count;
+}
+
+/*
+ * Ставит num_timers таймеров со случайной длительностью приготовления ингредиентов
+ * (от 1 до 2 секунд), отменяет каждый четвёртый и дожидается срабатывания остальных.
+ * Timer - тип таймера, MakeTimer создаёт таймер, Arm и Cancel взводят и отменяют его.
+ */
+template <typename Timer, typename MakeTimer, typename Arm, typename Cancel>
+void RunBenchmark(std::string_view name, net::io_context& io, unsigned num_timers,
+                  MakeTimer make_timer, Arm arm, Cancel cancel) {
+    std::vector<std::unique_ptr<Timer>> timers;
+    timers.reserve(num_timers);
+    for (unsigned i = 0; i < num_timers; ++i) {
+        timers.push_back(make_timer());
+    }
+
+    std::mt19937 random_engine{42};
+    std::uniform_int_distribution<int> delay_ms{1000, 2000};
+    BenchmarkStats stats;
+
+    const auto arm_start = Clock::now();
+    for (auto& timer : timers) {
+        const auto expiry = Clock::now() + std::chrono::milliseconds{delay_ms(random_engine)};
+        arm(*timer, expiry, [&stats, expiry](sys::error_code ec) {
+            if (ec) {
+                ++stats.cancelled;
+                return;
+            }
+            ++stats.fired;
+            const auto now = Clock::now();
+            if (now < expiry) {
+                ++stats.early;
+            }
+            stats.max_lateness = std::max(stats.max_lateness, now - expiry);
+        });
+    }
+    const auto arm_duration = Clock::now() - arm_start;
+
+    const auto cancel_start = Clock::now();
+    for (size_t i = 0; i < timers.size(); i += 4) {
+        cancel(*timers[i]);
+    }
+    const auto cancel_duration = Clock::now() - cancel_start;
+
+    const auto run_start = Clock::now();
+    io.run();
+    io.restart();
+    const auto run_duration = Clock::now() - run_start;
+
+    if (stats.fired + stats.cancelled != num_timers) {
+        throw std::logic_error("Not all timers have completed");
+    }
+    if (stats.early != 0) {
+        throw std::logic_error("Some timers have fired too early");
+    }
+    std::cout << name << ": timers: "sv << num_timers << ", arm: "sv
+              << AsNanoseconds(arm_duration, num_timers) << " ns/timer, cancel: "sv
+              << AsNanoseconds(cancel_duration, stats.cancelled) << " ns/timer, run: "sv
+              << std::chrono::duration<double>(run_duration).count() << "s, max lateness: "sv
+              << std::chrono::duration<double, std::milli>(stats.max_lateness).count() << "ms"sv
+              << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, const char* argv[]) {
+    try {
+        // timer_wheel_benchmark [<timers>]
+        const unsigned num_timers = ParseArg(argc, argv, 1, 1'000'000);
+        net::io_context io{1};
+
+        using WheelTimerHandler = WheelTimer::Handler;
+        TimerWheel wheel{io};
+        RunBenchmark<WheelTimer>(
+            "TimerWheel"sv, io, num_timers,
+            [&wheel] {
+                return std::make_unique<WheelTimer>(wheel);
+            },
+            [](WheelTimer& timer, Clock::time_point expiry, WheelTimerHandler handler) {
+                // Без VirtualClock часы колеса совпадают с steady_clock
+                timer.ExpiresAt(TimerWheel::Clock::time_point{expiry.time_since_epoch()});
+                timer.AsyncWait(std::move(handler));
+            },
+            [](WheelTimer& timer) {
+                timer.Cancel();
+            });
+
+        RunBenchmark<net::steady_timer>(
+            "steady_timer"sv, io, num_timers,
+            [&io] {
+                return std::make_unique<net::steady_timer>(io);
+            },
+            [](net::steady_timer& timer, Clock::time_point expiry, WheelTimerHandler handler) {
+                timer.expires_at(expiry);
+                timer.async_wait(std::move(handler));
+            },
+            [](net::steady_timer& timer) {
+                timer.cancel();
+            });
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,125 @@
+#pragma once
+#ifdef _WIN32
+#include <sdkddkver.h>
+#endif
+
+#include <boost/asio/io_context.hpp>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <stdexcept>
+#include <utility>
+
+class VirtualClock;
+
+/*
+Монотонные часы, заменяющие std::chrono::steady_clock.
+Показывают время steady_clock, а в потоке, где существует объект VirtualClock, - его
+модельное время.
+*/
+struct SteadyClock {
+    using duration = std::chrono::steady_clock::duration;
+    using rep = duration::rep;
+    using period = duration::period;
+    using time_point = std::chrono::time_point<SteadyClock>;
+    static constexpr bool is_steady = true;
+
+    static time_point now() noexcept;
+};
+
+/*
+Модельное время для ускоренного воспроизведения асинхронных сценариев.
+Объект устанавливает себя источником времени SteadyClock в потоке, где он создан. Колёса
+таймеров, созданные в этом потоке, планируют своё срабатывание через VirtualClock, а не через
+boost::asio::steady_timer.
+Метод Run выполняет готовые обработчики io_context, не меняя модельного времени. Когда готовых
+обработчиков не остаётся, время перескакивает к ближайшему запланированному событию. Таймеры
+срабатывают в порядке модельного времени так быстро, как позволяет процессор, а длительности,
+измеренные по SteadyClock, совпадают с заданными.
+Объект используется только в создавшем его потоке и должен быть уничтожен после объектов,
+запланировавших в нём события.
+*/
+class VirtualClock {
+public:
+    using Handler = std::function<void()>;
+    // Время события и порядковый номер, упорядочивающий события с одинаковым временем
+    using EventId = std::pair<SteadyClock::time_point, std::uint64_t>;
+
+    explicit VirtualClock(SteadyClock::time_point start_time = {}) noexcept
+        : now_{start_time}
+        , previous_{std::exchange(current_, this)} {
+    }
+
+    VirtualClock(const VirtualClock&) = delete;
+    VirtualClock& operator=(const VirtualClock&) = delete;
+
+    ~VirtualClock() {
+        current_ = previous_;
+    }
+
+    // Возвращает модельное время текущего потока либо nullptr, если время в потоке реальное
+    static VirtualClock* GetCurrent() noexcept {
+        return current_;
+    }
+
+    SteadyClock::time_point Now() const noexcept {
+        return now_;
+    }
+
+    // Переводит часы вперёд. Так моделируется обработчик, занимающий поток на время duration
+    void Advance(SteadyClock::duration duration) {
+        if (duration < SteadyClock::duration::zero()) {
+            throw std::invalid_argument("Virtual time can't go backwards");
+        }
+        now_ += duration;
+    }
+
+    // Планирует вызов handler в момент time. Событие, время которого уже наступило,
+    // выполняется после обработчиков, готовых к выполнению
+    EventId Schedule(SteadyClock::time_point time, Handler handler) {
+        EventId id{time, next_sequence_++};
+        events_.emplace(id, std::move(handler));
+        return id;
+    }
+
+    // Отменяет запланированное событие. Возвращает false, если событие уже произошло
+    bool Cancel(const EventId& id) {
+        return events_.erase(id) != 0;
+    }
+
+    size_t GetPendingCount() const noexcept {
+        return events_.size();
+    }
+
+    // Выполняет обработчики io и запланированные события, пока они есть.
+    // Возвращает количество выполненных обработчиков io
+    size_t Run(boost::asio::io_context& io) {
+        size_t count = 0;
+        while (true) {
+            io.restart();
+            count += io.poll();
+            if (events_.empty()) {
+                return count;
+            }
+            auto event = events_.extract(events_.begin());
+            now_ = std::max(now_, event.key().first);
+            event.mapped()();
+        }
+    }
+
+private:
+    SteadyClock::time_point now_;
+    std::uint64_t next_sequence_ = 0;
+    std::map<EventId, Handler> events_;
+    VirtualClock* const previous_;
+
+    static inline thread_local VirtualClock* current_ = nullptr;
+};
+
+inline SteadyClock::time_point SteadyClock::now() noexcept {
+    if (const VirtualClock* clock = VirtualClock::GetCurrent()) {
+        return clock->Now();
+    }
+    return time_point{std::chrono::steady_clock::now().time_since_epoch()};
+}
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+
+/*
+Кодек IMA ADPCM для 8-битного беззнакового монозвука.
+Каждый отсчёт кодируется 4 битами, поэтому поток сжимается вдвое. Кодек хранит состояние
+(предсказанное значение и индекс шага), и декодер должен начинать с того же состояния, что
+и кодер. Чтобы потеря пакета не нарушала декодирование последующих, состояние на начало
+пакета передаётся в его заголовке.
+*/
+namespace adpcm {
+
+struct State {
+    std::int16_t predictor = 0;
+    std::uint8_t step_index = 0;
+};
+
+// Размер закодированных данных для sample_count отсчётов
+constexpr size_t GetEncodedSize(size_t sample_count) noexcept {
+    return (sample_count + 1) / 2;
+}
+
+namespace detail {
+
+constexpr std::array<std::int16_t, 89> STEP_TABLE = {
+    7,     8,     9,     10,    11,    12,    13,    14,    16,    17,    19,    21,    23,
+    25,    28,    31,    34,    37,    41,    45,    50,    55,    60,    66,    73,    80,
+    88,    97,    107,   118,   130,   143,   157,   173,   190,   209,   230,   253,   279,
+    307,   337,   371,   408,   449,   494,   544,   598,   658,   724,   796,   876,   963,
+    1060,  1166,  1282,  1411,  1552,  1707,  1878,  2066,  2272,  2499,  2749,  3024,  3327,
+    3660,  4026,  4428,  4871,  5358,  5894,  6484,  7132,  7845,  8630,  9493,  10442, 11487,
+    12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767};
+
+constexpr std::array<int, 16> INDEX_TABLE = {-1, -1, -1, -1, 2, 4, 6, 8,
+                                             -1, -1, -1, -1, 2, 4, 6, 8};
+
+// Обновляет состояние по 4-битному коду так же, как это делает декодер
+inline void Apply(State& state, std::uint8_t code) noexcept {
+    const int step = STEP_TABLE[state.step_index];
+    int diff = step >> 3;
+    if (code & 4) {
+        diff += step;
+    }
+    if (code & 2) {
+        diff += step >> 1;
+    }
+    if (code & 1) {
+        diff += step >> 2;
+    }
+    const int predictor = (code & 8) ? state.predictor - diff : state.predictor + diff;
+    state.predictor = static_cast<std::int16_t>(std::clamp(predictor, -32768, 32767));
+    state.step_index =
+        static_cast<std::uint8_t>(std::clamp(state.step_index + INDEX_TABLE[code], 0, 88));
+}
+
+inline std::uint8_t EncodeSample(State& state, std::uint8_t sample) noexcept {
+    const int value = (static_cast<int>(sample) - 128) * 256;
+    int diff = value - state.predictor;
+    std::uint8_t code = 0;
+    if (diff < 0) {
+        code = 8;
+        diff = -diff;
+    }
+    int step = STEP_TABLE[state.step_index];
+    if (diff >= step) {
+        code |= 4;
+        diff -= step;
+    }
+    step >>= 1;
+    if (diff >= step) {
+        code |= 2;
+        diff -= step;
+    }
+    step >>= 1;
+    if (diff >= step) {
+        code |= 1;
+    }
+    Apply(state, code);
+    return code;
+}
+
+inline std::uint8_t DecodeSample(State& state, std::uint8_t code) noexcept {
+    Apply(state, code);
+    return static_cast<std::uint8_t>((state.predictor >> 8) + 128);
+}
+
+}  // namespace detail
+
+// Кодирует отсчёты samples в out, начиная с состояния state, которое обновляется.
+// Размер out должен быть не меньше GetEncodedSize(samples.size())
+inline void Encode(std::span<const std::uint8_t> samples, State& state,
+                   std::span<std::uint8_t> out) {
+    if (out.size() < GetEncodedSize(samples.size())) {
+        throw std::invalid_argument("ADPCM output buffer is too small");
+    }
+    for (size_t i = 0; i < samples.size(); ++i) {
+        const std::uint8_t code = detail::EncodeSample(state, samples[i]);
+        // Младшие 4 бита байта содержат чётный отсчёт, старшие - нечётный
+        if (i % 2 == 0) {
+            out[i / 2] = code;
+        } else {
+            out[i / 2] |= static_cast<std::uint8_t>(code << 4);
+        }
+    }
+}
+
+// Декодирует samples.size() отсчётов из in, начиная с состояния state, которое обновляется
+inline void Decode(std::span<const std::uint8_t> in, State& state,
+                   std::span<std::uint8_t> samples) {
+    if (in.size() < GetEncodedSize(samples.size())) {
+        throw std::invalid_argument("ADPCM input is too short");
+    }
+    for (size_t i = 0; i < samples.size(); ++i) {
+        const std::uint8_t code = (i % 2 == 0) ? (in[i / 2] & 0x0F) : (in[i / 2] >> 4);
+        samples[i] = detail::DecodeSample(state, code);
+    }
+}
+
+}  // namespace adpcm
@@ -0,0 +1,275 @@
+#pragma once
+
+#define MINIAUDIO_IMPLEMENTATION
+#include <miniaudio.h>
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <stdexcept>
+#include <vector>
+
+#include "ring_buffer.h"
+
+// Частота дискретизации записи и воспроизведения
+constexpr ma_uint32 SAMPLE_RATE = 44100;
+
+/*
+Записывает звук с устройства захвата.
+Запись выполняется либо фрагментом фиксированной длины (Record), либо непрерывно в кольцевой
+буфер (StartStreaming), из которого данные забирает другой поток.
+Если передан context, устройство создаётся в нём, что позволяет выбрать backend miniaudio.
+*/
+class Recorder {
+    static void Callback(ma_device* pDevice, void* pOutput, const void* pInput,
+                         ma_uint32 frameCount) {
+        Recorder* recorder = reinterpret_cast<Recorder*>(pDevice->pUserData);
+
+        if (recorder->stream_) {
+            recorder->StreamBuffer(pInput, frameCount);
+        } else {
+            recorder->SaveBuffer(pInput, frameCount);
+        }
+    }
+
+    void SaveBuffer(const void* pInput, ma_uint32 frameCount) {
+        size_t size = std::min(static_cast<size_t>(frameCount * frame_size_),
+                               buffer_.size() - current_off_);
+
+        std::copy_n(reinterpret_cast<const char*>(pInput), size, buffer_.data() + current_off_);
+
+        current_off_ += size;
+    }
+
+    // Вызывается в потоке реального времени, поэтому не блокируется и не выделяет память.
+    // Кадры, не поместившиеся в буфер, отбрасываются
+    void StreamBuffer(const void* pInput, ma_uint32 frameCount) {
+        const size_t size = static_cast<size_t>(frameCount) * frame_size_;
+        const size_t available = stream_->GetWriteAvailable() / frame_size_ * frame_size_;
+        const size_t written =
+            stream_->Write(reinterpret_cast<const char*>(pInput), std::min(size, available));
+
+        streamed_frames_.fetch_add(written / frame_size_, std::memory_order_relaxed);
+        if (written < size) {
+            overrun_frames_.fetch_add((size - written) / frame_size_, std::memory_order_relaxed);
+        }
+    }
+
+public:
+    Recorder(ma_format format, int channels, ma_context* context = nullptr) {
+        ma_device_config device_config;
+
+        device_config = ma_device_config_init(ma_device_type_capture);
+        device_config.capture.pDeviceID = NULL;
+        device_config.capture.format = format;
+        device_config.capture.channels = channels;
+        device_config.sampleRate = SAMPLE_RATE;
+        device_config.dataCallback = Callback;
+        device_config.pUserData = this;
+
+        frame_size_ = ma_get_bytes_per_frame(format, channels);
+        init_result_ = ma_device_init(context, &device_config, &device_);
+    }
+
+    ~Recorder() {
+        ma_device_uninit(&device_);
+    }
+
+    struct RecordingResult {
+        std::vector<char> data;
+        size_t frames;
+    };
+
+    template <typename Rep, typename Period>
+    RecordingResult Record(size_t max_frames, std::chrono::duration<Rep, Period> dur) {
+        current_off_ = 0;
+
+        buffer_.resize(max_frames * frame_size_);
+
+        ma_device_start(&device_);
+        std::this_thread::sleep_for(dur);
+        ma_device_stop(&device_);
+
+        return {std::move(buffer_), current_off_ / frame_size_};
+    }
+
+    // Запускает непрерывную запись в буфер buffer, который должен существовать до вызова
+    // StopStreaming. Выбрасывает std::runtime_error, если устройство не удалось запустить
+    void StartStreaming(SpscRingBuffer& buffer) {
+        if (init_result_ != MA_SUCCESS) {
+            throw std::runtime_error("Capture device is not initialized");
+        }
+        streamed_frames_ = 0;
+        overrun_frames_ = 0;
+        stream_ = &buffer;
+        if (ma_device_start(&device_) != MA_SUCCESS) {
+            stream_ = nullptr;
+            throw std::runtime_error("Failed to start capture device");
+        }
+    }
+
+    // Останавливает непрерывную запись. После возврата функция обратного вызова не
+    // обращается к буферу
+    void StopStreaming() {
+        ma_device_stop(&device_);
+        stream_ = nullptr;
+    }
+
+    // Количество кадров, записанных в буфер с начала непрерывной записи
+    size_t GetStreamedFrames() const {
+        return streamed_frames_.load(std::memory_order_relaxed);
+    }
+
+    // Количество кадров, отброшенных из-за переполнения буфера
+    size_t GetOverrunFrames() const {
+        return overrun_frames_.load(std::memory_order_relaxed);
+    }
+
+    int GetFrameSize() const {
+        return frame_size_;
+    }
+
+private:
+    ma_device device_;
+    ma_result init_result_;
+    int frame_size_;
+
+    std::vector<char> buffer_;
+
+    size_t current_off_;
+
+    // Буфер непрерывной записи. Изменяется только при остановленном устройстве
+    SpscRingBuffer* stream_ = nullptr;
+    std::atomic_size_t streamed_frames_{0};
+    std::atomic_size_t overrun_frames_{0};
+};
+
+/*
+Воспроизводит звук на устройстве вывода.
+Воспроизводится либо готовый фрагмент (PlayBuffer), либо непрерывный поток из кольцевого
+буфера (StartStreaming), который заполняет другой поток.
+*/
+class Player {
+    static void Callback(ma_device* pDevice, void* pOutput, const void* pInput,
+                         ma_uint32 frameCount) {
+        Player* player = reinterpret_cast<Player*>(pDevice->pUserData);
+
+        if (player->stream_) {
+            player->StreamBuffer(pOutput, frameCount);
+        } else {
+            player->FillBuffer(pOutput, frameCount);
+        }
+    }
+
+    void FillBuffer(void* pOutput, ma_uint32 frameCount) {
+        size_t size = std::min(static_cast<size_t>(frameCount * frame_size_),
+                               max_frame_ * frame_size_ - current_off_);
+
+        std::copy_n(current_buffer_ + current_off_, size, reinterpret_cast<char*>(pOutput));
+
+        current_off_ += size;
+    }
+
+    // Вызывается в потоке реального времени. Если данных в буфере недостаточно, недостающие
+    // кадры заполняются тишиной
+    void StreamBuffer(void* pOutput, ma_uint32 frameCount) {
+        const size_t size = static_cast<size_t>(frameCount) * frame_size_;
+        const size_t available = stream_->GetReadAvailable() / frame_size_ * frame_size_;
+        char* output = reinterpret_cast<char*>(pOutput);
+        const size_t read = stream_->Read(output, std::min(size, available));
+
+        streamed_frames_.fetch_add(read / frame_size_, std::memory_order_relaxed);
+        if (read < size) {
+            const ma_uint32 missing_frames = static_cast<ma_uint32>((size - read) / frame_size_);
+            ma_silence_pcm_frames(output + read, missing_frames, format_, channels_);
+            underrun_frames_.fetch_add(missing_frames, std::memory_order_relaxed);
+        }
+    }
+
+public:
+    Player(ma_format format, int channels, ma_context* context = nullptr)
+        : format_{format}
+        , channels_{static_cast<ma_uint32>(channels)} {
+        ma_device_config device_config;
+
+        device_config = ma_device_config_init(ma_device_type_playback);
+        device_config.playback.pDeviceID = NULL;
+        device_config.playback.format = format;
+        device_config.playback.channels = channels;
+        device_config.sampleRate = SAMPLE_RATE;
+        device_config.dataCallback = Callback;
+        device_config.pUserData = this;
+
+        frame_size_ = ma_get_bytes_per_frame(format, channels);
+        init_result_ = ma_device_init(context, &device_config, &device_);
+    }
+
+    ~Player() {
+        ma_device_uninit(&device_);
+    }
+
+    template <typename Rep, typename Period>
+    void PlayBuffer(const char* data, size_t frames, std::chrono::duration<Rep, Period> dur) {
+        current_buffer_ = data;
+        current_off_ = 0;
+        max_frame_ = frames;
+
+        ma_device_start(&device_);
+        std::this_thread::sleep_for(dur);
+        ma_device_stop(&device_);
+    }
+
+    // Запускает непрерывное воспроизведение из буфера buffer, который должен существовать
+    // до вызова StopStreaming. Выбрасывает std::runtime_error, если устройство не удалось
+    // запустить
+    void StartStreaming(SpscRingBuffer& buffer) {
+        if (init_result_ != MA_SUCCESS) {
+            throw std::runtime_error("Playback device is not initialized");
+        }
+        streamed_frames_ = 0;
+        underrun_frames_ = 0;
+        stream_ = &buffer;
+        if (ma_device_start(&device_) != MA_SUCCESS) {
+            stream_ = nullptr;
+            throw std::runtime_error("Failed to start playback device");
+        }
+    }
+
+    // Останавливает непрерывное воспроизведение. После возврата функция обратного вызова не
+    // обращается к буферу
+    void StopStreaming() {
+        ma_device_stop(&device_);
+        stream_ = nullptr;
+    }
+
+    // Количество кадров, прочитанных из буфера с начала непрерывного воспроизведения
+    size_t GetStreamedFrames() const {
+        return streamed_frames_.load(std::memory_order_relaxed);
+    }
+
+    // Количество кадров тишины, выведенных из-за нехватки данных в буфере
+    size_t GetUnderrunFrames() const {
+        return underrun_frames_.load(std::memory_order_relaxed);
+    }
+
+    int GetFrameSize() const {
+        return frame_size_;
+    }
+
+private:
+    ma_device device_;
+    ma_result init_result_;
+    int frame_size_;
+    ma_format format_;
+    ma_uint32 channels_;
+
+    const char* current_buffer_;
+    size_t current_off_;
+    size_t max_frame_;
+
+    // Буфер непрерывного воспроизведения. Изменяется только при остановленном устройстве
+    SpscRingBuffer* stream_ = nullptr;
+    std::atomic_size_t streamed_frames_{0};
+    std::atomic_size_t underrun_frames_{0};
+};
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "radio_protocol.h"
+
+/*
+Буфер компенсации джиттера на стороне приёмника.
+Датаграммы приходят с переменной задержкой и могут теряться или переставляться. Буфер
+раскладывает пакеты по порядковым номерам и начинает воспроизведение, только накопив
+delay_packets пакетов, что даёт запас на неравномерную доставку. Далее воспроизведение
+идёт строго по порядку номеров: пакет, не пришедший к моменту воспроизведения, заменяется
+тишиной, а пришедший позднее отбрасывается.
+Методы класса можно вызывать из разных потоков.
+*/
+class JitterBuffer {
+public:
+    struct Stats {
+        // Принятые пакеты
+        std::uint64_t received = 0;
+        // Пакеты, пришедшие после того, как их время воспроизведения прошло
+        std::uint64_t late = 0;
+        std::uint64_t duplicates = 0;
+        // Пакеты, вместо которых была воспроизведена тишина
+        std::uint64_t concealed = 0;
+        // Количество перезапусков воспроизведения из-за разрыва в нумерации пакетов
+        std::uint64_t resets = 0;
+    };
+
+    // Результат извлечения пакета
+    struct PopResult {
+        // Порядковый номер воспроизводимого пакета
+        std::uint32_t sequence = 0;
+        // Пакет не пришёл и заменён тишиной
+        bool concealed = false;
+    };
+
+    JitterBuffer(size_t capacity_packets, size_t delay_packets)
+        : slots_(capacity_packets)
+        , delay_packets_{delay_packets} {
+        if (delay_packets == 0 || delay_packets > capacity_packets) {
+            throw std::invalid_argument("Jitter buffer delay must be in [1, capacity]");
+        }
+    }
+
+    void Push(const radio::Packet& packet) {
+        std::lock_guard lock{mutex_};
+        ++stats_.received;
+
+        if (!has_position_) {
+            has_position_ = true;
+            next_sequence_ = packet.sequence;
+        }
+        auto offset = static_cast<std::int32_t>(packet.sequence - next_sequence_);
+        // Пакет с номером, далеко отстоящим от ожидаемого, означает, что передатчик начал
+        // поток заново. Воспроизведение начинается с этого пакета
+        if (offset < -static_cast<std::int32_t>(slots_.size())
+            || offset >= static_cast<std::int32_t>(slots_.size())) {
+            Reset(packet.sequence);
+            offset = 0;
+        }
+        if (offset < 0) {
+            if (playing_) {
+                ++stats_.late;
+                return;
+            }
+            // Воспроизведение ещё не началось, поэтому можно начать с более раннего пакета,
+            // если для него хватает места
+            if (buffered_ > 0 && GetLastSequence() - packet.sequence >= slots_.size()) {
+                ++stats_.late;
+                return;
+            }
+            next_sequence_ = packet.sequence;
+        }
+
+        Slot& slot = slots_[packet.sequence % slots_.size()];
+        if (slot.filled) {
+            ++stats_.duplicates;
+            return;
+        }
+        slot.filled = true;
+        slot.packet = packet;
+        ++buffered_;
+    }
+
+    // Извлекает очередной пакет и записывает его кадры в frames (FRAMES_PER_PACKET кадров).
+    // Пока буфер не накопил нужное количество пакетов, возвращает nullopt и ничего не пишет
+    std::optional<PopResult> Pop(std::span<std::uint8_t, radio::FRAMES_PER_PACKET> frames) {
+        std::lock_guard lock{mutex_};
+        if (!playing_) {
+            if (buffered_ < delay_packets_) {
+                return std::nullopt;
+            }
+            playing_ = true;
+        }
+
+        PopResult result{next_sequence_, false};
+        Slot& slot = slots_[next_sequence_ % slots_.size()];
+        if (slot.filled && slot.packet.sequence == next_sequence_) {
+            const auto count = slot.packet.frame_count;
+            std::copy_n(slot.packet.frames.begin(), count, frames.begin());
+            std::fill(frames.begin() + count, frames.end(), radio::SILENCE);
+            slot.filled = false;
+            --buffered_;
+        } else {
+            std::fill(frames.begin(), frames.end(), radio::SILENCE);
+            result.concealed = true;
+            ++stats_.concealed;
+        }
+        ++next_sequence_;
+        return result;
+    }
+
+    Stats GetStats() const {
+        std::lock_guard lock{mutex_};
+        return stats_;
+    }
+
+private:
+    struct Slot {
+        bool filled = false;
+        radio::Packet packet;
+    };
+
+    void Reset(std::uint32_t sequence) {
+        for (auto& slot : slots_) {
+            slot.filled = false;
+        }
+        buffered_ = 0;
+        playing_ = false;
+        next_sequence_ = sequence;
+        ++stats_.resets;
+    }
+
+    // Наибольший номер пакета, находящегося в буфере
+    std::uint32_t GetLastSequence() const {
+        std::uint32_t last = next_sequence_;
+        for (const auto& slot : slots_) {
+            if (slot.filled && static_cast<std::int32_t>(slot.packet.sequence - last) > 0) {
+                last = slot.packet.sequence;
+            }
+        }
+        return last;
+    }
+
+    mutable std::mutex mutex_;
+    std::vector<Slot> slots_;
+    const size_t delay_packets_;
+    // Номер пакета, который будет воспроизведён следующим
+    std::uint32_t next_sequence_ = 0;
+    bool has_position_ = false;
+    bool playing_ = false;
+    size_t buffered_ = 0;
+    Stats stats_;
+};
@@ -0,0 +1,201 @@
+// Boost.Asio подключается раньше miniaudio, чтобы winsock2.h предшествовал windows.h
+#include "udp_radio.h"
+#include "audio.h"
+#include <array>
+#include <iostream>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <thread>
+
+using namespace std::literals;
+
+namespace {
+
+// Ёмкость буферов непрерывного режима, около 0.37 с звука при 44.1 кГц и 1 байте на кадр
+constexpr size_t STREAM_BUFFER_SIZE = 16384;
+
+/*
+ * Непрерывно записывает звук и сразу воспроизводит его, пока пользователь не нажмёт Enter.
+ * Отдельный поток забирает записанные данные из буфера записи и передаёт их в буфер
+ * воспроизведения.
+ * Рабочие потоки завершаются по запросу остановки std::jthread, поэтому, если устройство
+ * не удалось запустить, деструктор jthread останавливает поток и не зависает в join.
+ */
+void RunStreaming(Recorder& recorder, Player& player) {
+    SpscRingBuffer capture_buffer{STREAM_BUFFER_SIZE};
+    SpscRingBuffer playback_buffer{STREAM_BUFFER_SIZE};
+
+    std::jthread consumer{[&](std::stop_token stop) {
+        std::array<char, 1024> chunk;
+        while (!stop.stop_requested()) {
+            const size_t size = capture_buffer.Read(
+                chunk.data(), std::min(chunk.size(), playback_buffer.GetWriteAvailable()));
+            playback_buffer.Write(chunk.data(), size);
+            if (size == 0) {
+                std::this_thread::sleep_for(1ms);
+            }
+        }
+    }};
+
+    recorder.StartStreaming(capture_buffer);
+    try {
+        player.StartStreaming(playback_buffer);
+    } catch (...) {
+        // Запись обращается к capture_buffer, поэтому её нужно остановить до его разрушения
+        recorder.StopStreaming();
+        throw;
+    }
+
+    std::cout << "Streaming. Press Enter to stop..." << std::endl;
+    std::string str;
+    std::getline(std::cin, str);
+
+    recorder.StopStreaming();
+    player.StopStreaming();
+    consumer.request_stop();
+    consumer.join();
+
+    std::cout << "Streaming done. Recorded frames: " << recorder.GetStreamedFrames()
+              << ", overrun frames: " << recorder.GetOverrunFrames()
+              << ", underrun frames: " << player.GetUnderrunFrames() << std::endl;
+}
+
+// Параметры сетевого режима: буфер джиттера вмещает 1 с звука, воспроизведение
+// начинается после накопления 60 мс
+constexpr size_t JITTER_BUFFER_PACKETS = 50;
+constexpr size_t JITTER_DELAY_PACKETS = 3;
+// Буфер воспроизведения сетевого режима должен вмещать не меньше двух пакетов
+constexpr size_t NETWORK_PLAYBACK_BUFFER_SIZE = 4096;
+
+/*
+ * Непрерывно записывает звук и передаёт его на сервер server датаграммами UDP, пока
+ * пользователь не нажмёт Enter.
+ */
+void RunClient(Recorder& recorder, const radio::udp::endpoint& server) {
+    radio::net::io_context io;
+    radio::Sender sender{io, server};
+    SpscRingBuffer capture_buffer{STREAM_BUFFER_SIZE};
+
+    std::jthread sender_thread{[&](std::stop_token stop) {
+        std::array<std::uint8_t, radio::FRAMES_PER_PACKET> frames;
+        while (!stop.stop_requested()) {
+            if (capture_buffer.GetReadAvailable() < frames.size()) {
+                std::this_thread::sleep_for(2ms);
+                continue;
+            }
+            capture_buffer.Read(reinterpret_cast<char*>(frames.data()), frames.size());
+            sender.Send(frames);
+        }
+    }};
+
+    recorder.StartStreaming(capture_buffer);
+    std::cout << "Streaming to " << server << ". Press Enter to stop..." << std::endl;
+    std::string str;
+    std::getline(std::cin, str);
+
+    recorder.StopStreaming();
+    sender_thread.request_stop();
+    sender_thread.join();
+
+    std::cout << "Packets sent: " << sender.GetNextSequence() << ", bytes sent: "
+              << sender.GetSentBytes() << ", send errors: " << sender.GetSendErrors()
+              << ", overrun frames: " << recorder.GetOverrunFrames() << std::endl;
+}
+
+/*
+ * Принимает звук на порту port и воспроизводит его, пока пользователь не нажмёт Enter.
+ */
+void RunServer(Player& player, unsigned short port) {
+    radio::net::io_context io;
+    JitterBuffer jitter_buffer{JITTER_BUFFER_PACKETS, JITTER_DELAY_PACKETS};
+    radio::Receiver receiver{io, radio::udp::endpoint{radio::udp::v4(), port}, jitter_buffer};
+    SpscRingBuffer playback_buffer{NETWORK_PLAYBACK_BUFFER_SIZE};
+
+    receiver.Start();
+    std::jthread io_thread{[&io](std::stop_token stop) {
+        // Запрос остановки прерывает ожидание датаграмм
+        std::stop_callback stop_io{stop, [&io] {
+            io.stop();
+        }};
+        io.run();
+    }};
+
+    // Пакеты извлекаются из буфера джиттера в темпе, который задаёт устройство
+    // воспроизведения. Очередной пакет передаётся, когда в буфере воспроизведения остаётся
+    // меньше пакета: иначе буфер воспроизведения заполнился бы сразу несколькими пакетами,
+    // а запас буфера джиттера на задержку датаграмм был бы израсходован
+    std::jthread pump_thread{[&](std::stop_token stop) {
+        std::array<std::uint8_t, radio::FRAMES_PER_PACKET> frames;
+        while (!stop.stop_requested()) {
+            while (playback_buffer.GetCapacity() - playback_buffer.GetWriteAvailable()
+                       < frames.size()
+                   && jitter_buffer.Pop(frames)) {
+                playback_buffer.Write(reinterpret_cast<const char*>(frames.data()),
+                                      frames.size());
+            }
+            std::this_thread::sleep_for(5ms);
+        }
+    }};
+
+    player.StartStreaming(playback_buffer);
+    std::cout << "Listening on port " << port << ". Press Enter to stop..." << std::endl;
+    std::string str;
+    std::getline(std::cin, str);
+
+    player.StopStreaming();
+    pump_thread.request_stop();
+    pump_thread.join();
+    io_thread.request_stop();
+    io_thread.join();
+
+    const auto stats = jitter_buffer.GetStats();
+    std::cout << "Packets received: " << stats.received << ", late: " << stats.late
+              << ", concealed: " << stats.concealed << ", malformed: "
+              << receiver.GetMalformedCount() << ", underrun frames: "
+              << player.GetUnderrunFrames() << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    Recorder recorder(ma_format_u8, 1);
+    Player player(ma_format_u8, 1);
+
+    // radio --stream включает непрерывный режим вместо записи фрагментов,
+    // radio client <ip> <port> передаёт звук на сервер, radio server <port> принимает его
+    try {
+        if (argc == 2 && argv[1] == "--stream"sv) {
+            RunStreaming(recorder, player);
+            return 0;
+        }
+        if (argc == 4 && argv[1] == "client"sv) {
+            const radio::udp::endpoint server{radio::net::ip::make_address(argv[2]),
+                                              static_cast<unsigned short>(std::stoi(argv[3]))};
+            RunClient(recorder, server);
+            return 0;
+        }
+        if (argc == 3 && argv[1] == "server"sv) {
+            RunServer(player, static_cast<unsigned short>(std::stoi(argv[2])));
+            return 0;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    while (true) {
+        std::string str;
+
+        std::cout << "Press Enter to record message..." << std::endl;
+        std::getline(std::cin, str);
+
+        auto rec_result = recorder.Record(65000, 1.5s);
+        std::cout << "Recording done" << std::endl;
+
+        player.PlayBuffer(rec_result.data.data(), rec_result.frames, 1.5s);
+        std::cout << "Playing done" << std::endl;
+    }
+
+    return 0;
+}
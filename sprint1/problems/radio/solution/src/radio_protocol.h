@@ -0,0 +1,85 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+
+#include "adpcm.h"
+
+/*
+Формат датаграмм радио.
+Звук передаётся пакетами по FRAMES_PER_PACKET кадров (20 мс при 44.1 кГц), сжатыми кодеком
+IMA ADPCM. Каждый пакет помещается в одну датаграмму и декодируется независимо от других.
+Заголовок (little-endian):
+  sequence    4 байта - порядковый номер пакета
+  frame_count 2 байта - количество кадров в пакете
+  predictor   2 байта - состояние кодека на начало пакета
+  step_index  1 байт
+  reserved    1 байт
+*/
+namespace radio {
+
+constexpr size_t FRAMES_PER_PACKET = 882;
+constexpr size_t HEADER_SIZE = 10;
+constexpr size_t MAX_PACKET_SIZE = HEADER_SIZE + adpcm::GetEncodedSize(FRAMES_PER_PACKET);
+// Значение отсчёта, соответствующее тишине в формате u8
+constexpr std::uint8_t SILENCE = 0x80;
+
+// Декодированный пакет
+struct Packet {
+    std::uint32_t sequence = 0;
+    std::uint16_t frame_count = 0;
+    std::array<std::uint8_t, FRAMES_PER_PACKET> frames;
+};
+
+// Сжимает кадры frames (не более FRAMES_PER_PACKET) в датаграмму out и возвращает её размер.
+// state - состояние кодека, продолжающееся от пакета к пакету
+inline size_t EncodePacket(std::uint32_t sequence, std::span<const std::uint8_t> frames,
+                           adpcm::State& state, std::span<std::uint8_t, MAX_PACKET_SIZE> out) {
+    if (frames.size() > FRAMES_PER_PACKET) {
+        throw std::invalid_argument("Too many frames for a packet");
+    }
+    const auto frame_count = static_cast<std::uint16_t>(frames.size());
+    const auto predictor = static_cast<std::uint16_t>(state.predictor);
+    out[0] = static_cast<std::uint8_t>(sequence);
+    out[1] = static_cast<std::uint8_t>(sequence >> 8);
+    out[2] = static_cast<std::uint8_t>(sequence >> 16);
+    out[3] = static_cast<std::uint8_t>(sequence >> 24);
+    out[4] = static_cast<std::uint8_t>(frame_count);
+    out[5] = static_cast<std::uint8_t>(frame_count >> 8);
+    out[6] = static_cast<std::uint8_t>(predictor);
+    out[7] = static_cast<std::uint8_t>(predictor >> 8);
+    out[8] = state.step_index;
+    out[9] = 0;
+
+    adpcm::Encode(frames, state, out.subspan(HEADER_SIZE));
+    return HEADER_SIZE + adpcm::GetEncodedSize(frames.size());
+}
+
+// Декодирует датаграмму data в packet. Возвращает false, если датаграмма повреждена
+inline bool DecodePacket(std::span<const std::uint8_t> data, Packet& packet) {
+    if (data.size() < HEADER_SIZE) {
+        return false;
+    }
+    const std::uint16_t frame_count = static_cast<std::uint16_t>(data[4] | (data[5] << 8));
+    adpcm::State state;
+    state.predictor = static_cast<std::int16_t>(data[6] | (data[7] << 8));
+    state.step_index = data[8];
+    if (frame_count > FRAMES_PER_PACKET || state.step_index > 88
+        || data.size() != HEADER_SIZE + adpcm::GetEncodedSize(frame_count)) {
+        return false;
+    }
+
+    packet.sequence = static_cast<std::uint32_t>(data[0])
+                    | (static_cast<std::uint32_t>(data[1]) << 8)
+                    | (static_cast<std::uint32_t>(data[2]) << 16)
+                    | (static_cast<std::uint32_t>(data[3]) << 24);
+    packet.frame_count = frame_count;
+    adpcm::Decode(data.subspan(HEADER_SIZE), state,
+                  std::span{packet.frames}.first(frame_count));
+    return true;
+}
+
+}  // namespace radio
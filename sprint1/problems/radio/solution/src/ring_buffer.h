@@ -0,0 +1,88 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+/*
+Кольцевой буфер байтов без блокировок для одного писателя и одного читателя.
+Используется для передачи звука между функцией обратного вызова аудиоустройства, которую
+miniaudio вызывает в потоке реального времени, и обычным потоком приложения. Ни запись, ни
+чтение не блокируются и не выделяют память, поэтому их можно вызывать из потока
+реального времени.
+Позиции записи и чтения только возрастают, а индекс в буфере получается маской, поэтому
+ёмкость буфера - степень двойки.
+*/
+class SpscRingBuffer {
+public:
+    // Ёмкость буфера округляется вверх до степени двойки
+    explicit SpscRingBuffer(size_t capacity)
+        : buffer_(std::bit_ceil(capacity))
+        , mask_{buffer_.size() - 1} {
+        if (capacity == 0) {
+            throw std::invalid_argument("Ring buffer capacity must be positive");
+        }
+    }
+
+    SpscRingBuffer(const SpscRingBuffer&) = delete;
+    SpscRingBuffer& operator=(const SpscRingBuffer&) = delete;
+
+    size_t GetCapacity() const noexcept {
+        return buffer_.size();
+    }
+
+    // Количество байтов, которые можно записать. Вызывается писателем
+    size_t GetWriteAvailable() const noexcept {
+        const size_t write_pos = write_pos_.load(std::memory_order_relaxed);
+        return buffer_.size() - (write_pos - read_pos_.load(std::memory_order_acquire));
+    }
+
+    // Количество байтов, которые можно прочитать. Вызывается читателем
+    size_t GetReadAvailable() const noexcept {
+        const size_t read_pos = read_pos_.load(std::memory_order_relaxed);
+        return write_pos_.load(std::memory_order_acquire) - read_pos;
+    }
+
+    // Записывает не более size байтов и возвращает количество записанных. Вызывается писателем
+    size_t Write(const char* data, size_t size) noexcept {
+        const size_t write_pos = write_pos_.load(std::memory_order_relaxed);
+        const size_t read_pos = read_pos_.load(std::memory_order_acquire);
+        size = std::min(size, buffer_.size() - (write_pos - read_pos));
+
+        const size_t offset = write_pos & mask_;
+        const size_t first_part = std::min(size, buffer_.size() - offset);
+        std::copy_n(data, first_part, buffer_.data() + offset);
+        std::copy_n(data + first_part, size - first_part, buffer_.data());
+
+        write_pos_.store(write_pos + size, std::memory_order_release);
+        return size;
+    }
+
+    // Читает не более size байтов и возвращает количество прочитанных. Вызывается читателем
+    size_t Read(char* data, size_t size) noexcept {
+        const size_t read_pos = read_pos_.load(std::memory_order_relaxed);
+        const size_t write_pos = write_pos_.load(std::memory_order_acquire);
+        size = std::min(size, write_pos - read_pos);
+
+        const size_t offset = read_pos & mask_;
+        const size_t first_part = std::min(size, buffer_.size() - offset);
+        std::copy_n(buffer_.data() + offset, first_part, data);
+        std::copy_n(buffer_.data(), size - first_part, data + first_part);
+
+        read_pos_.store(read_pos + size, std::memory_order_release);
+        return size;
+    }
+
+private:
+    // Позиции писателя и читателя лежат в разных строках кэша, чтобы потоки не мешали
+    // друг другу
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+
+    std::vector<char> buffer_;
+    const size_t mask_;
+    alignas(CACHE_LINE_SIZE) std::atomic_size_t write_pos_{0};
+    alignas(CACHE_LINE_SIZE) std::atomic_size_t read_pos_{0};
+};
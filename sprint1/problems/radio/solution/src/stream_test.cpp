@@ -0,0 +1,169 @@
+#include "audio.h"
+
+#include <array>
+#include <charconv>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+
+using namespace std::literals;
+
+namespace {
+
+unsigned ParseArg(int argc, const char* argv[], int index, unsigned default_value) {
+    if (argc <= index) {
+        return default_value;
+    }
+    const std::string_view arg = argv[index];
+    unsigned value = 0;
+    const auto [end, ec] = std::from_chars(arg.data(), arg.data() + arg.size(), value);
+    if (ec != std::errc{} || end != arg.data() + arg.size() || value == 0) {
+        throw std::invalid_argument("Invalid argument: "s + std::string(arg));
+    }
+    return value;
+}
+
+/*
+ * Писатель передаёт читателю через кольцевой буфер последовательность байтов порциями
+ * случайного размера, а читатель проверяет, что байты приходят без пропусков и в том же
+ * порядке.
+ */
+bool TestRingBufferOrdering(size_t total_bytes) {
+    SpscRingBuffer buffer{4096};
+
+    std::jthread writer{[&buffer, total_bytes] {
+        std::mt19937 random_engine{1};
+        std::uniform_int_distribution<size_t> chunk_size{1, 3000};
+        std::vector<char> chunk;
+        std::uint8_t next_value = 0;
+        for (size_t sent = 0; sent < total_bytes;) {
+            chunk.resize(std::min(chunk_size(random_engine), total_bytes - sent));
+            for (auto& c : chunk) {
+                c = static_cast<char>(next_value++);
+            }
+            for (size_t offset = 0; offset < chunk.size();) {
+                const size_t written =
+                    buffer.Write(chunk.data() + offset, chunk.size() - offset);
+                if (written == 0) {
+                    std::this_thread::yield();
+                }
+                offset += written;
+            }
+            sent += chunk.size();
+        }
+    }};
+
+    std::mt19937 random_engine{2};
+    std::uniform_int_distribution<size_t> chunk_size{1, 3000};
+    std::vector<char> chunk;
+    std::uint8_t expected_value = 0;
+    bool ok = true;
+    // Буфер вычитывается до конца даже после ошибки, иначе писатель не сможет завершиться
+    for (size_t received = 0; received < total_bytes;) {
+        chunk.resize(chunk_size(random_engine));
+        const size_t size = buffer.Read(chunk.data(), chunk.size());
+        if (size == 0) {
+            std::this_thread::yield();
+        }
+        for (size_t i = 0; i < size; ++i) {
+            if (static_cast<std::uint8_t>(chunk[i]) != expected_value++ && ok) {
+                std::cout << "Ring buffer: unexpected byte at offset "sv << received + i
+                          << std::endl;
+                ok = false;
+            }
+        }
+        received += size;
+    }
+    if (ok) {
+        std::cout << "Ring buffer: "sv << total_bytes << " bytes transferred in order"sv
+                  << std::endl;
+    }
+    return ok;
+}
+
+/*
+ * Непрерывно записывает и воспроизводит звук через null backend miniaudio, который вызывает
+ * функции обратного вызова в реальном темпе без звукового оборудования. Отдельный поток
+ * перекладывает данные из буфера записи в буфер воспроизведения, как это делает
+ * приложение. Проверяется, что при 44.1 кГц буфер записи не переполняется, а объём
+ * записанных данных соответствует длительности теста.
+ */
+bool TestNullBackendStreaming(std::chrono::seconds duration) {
+    ma_backend backends[] = {ma_backend_null};
+    ma_context context;
+    if (ma_context_init(backends, 1, NULL, &context) != MA_SUCCESS) {
+        throw std::runtime_error("Failed to initialize miniaudio null backend");
+    }
+
+    bool ok = true;
+    {
+        Recorder recorder{ma_format_u8, 1, &context};
+        Player player{ma_format_u8, 1, &context};
+        // Каждый буфер вмещает около 0.37 с звука
+        SpscRingBuffer capture_buffer{16384};
+        SpscRingBuffer playback_buffer{16384};
+
+        std::atomic_bool stop{false};
+        std::jthread consumer{[&] {
+            std::array<char, 1024> chunk;
+            while (!stop.load(std::memory_order_relaxed)) {
+                const size_t size = capture_buffer.Read(
+                    chunk.data(), std::min(chunk.size(), playback_buffer.GetWriteAvailable()));
+                playback_buffer.Write(chunk.data(), size);
+                if (size == 0) {
+                    std::this_thread::sleep_for(1ms);
+                }
+            }
+        }};
+
+        recorder.StartStreaming(capture_buffer);
+        player.StartStreaming(playback_buffer);
+        std::this_thread::sleep_for(duration);
+        recorder.StopStreaming();
+        player.StopStreaming();
+        stop = true;
+        consumer.join();
+
+        const double expected_frames = static_cast<double>(SAMPLE_RATE) * duration.count();
+        const size_t recorded_frames = recorder.GetStreamedFrames();
+        std::cout << "Null backend: recorded frames: "sv << recorded_frames
+                  << " (expected about "sv << expected_frames << "), played frames: "sv
+                  << player.GetStreamedFrames() << ", overrun frames: "sv
+                  << recorder.GetOverrunFrames() << ", underrun frames: "sv
+                  << player.GetUnderrunFrames() << std::endl;
+
+        if (recorder.GetOverrunFrames() != 0) {
+            std::cout << "Capture buffer has overrun"sv << std::endl;
+            ok = false;
+        }
+        // Устройство запускается и останавливается не мгновенно, поэтому допускается
+        // расхождение в 10%
+        if (recorded_frames < expected_frames * 0.9 || recorded_frames > expected_frames * 1.1) {
+            std::cout << "Recorded frame count does not match 44.1 kHz"sv << std::endl;
+            ok = false;
+        }
+    }
+
+    ma_context_uninit(&context);
+    return ok;
+}
+
+}  // namespace
+
+int main(int argc, const char* argv[]) {
+    try {
+        // radio_stream_test [<seconds>]
+        const auto duration = std::chrono::seconds{ParseArg(argc, argv, 1, 3)};
+        const bool ring_buffer_ok = TestRingBufferOrdering(64 * 1024 * 1024);
+        const bool streaming_ok = TestNullBackendStreaming(duration);
+        if (!ring_buffer_ok || !streaming_ok) {
+            return EXIT_FAILURE;
+        }
+        std::cout << "OK"sv << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,258 @@
+#include "udp_radio.h"
+
+#include <boost/asio/steady_timer.hpp>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <numbers>
+#include <random>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+using namespace std::literals;
+using namespace radio;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr unsigned SAMPLE_RATE = 44100;
+constexpr auto PACKET_DURATION = std::chrono::microseconds{
+    FRAMES_PER_PACKET * 1'000'000 / SAMPLE_RATE};
+constexpr size_t JITTER_BUFFER_PACKETS = 50;
+constexpr size_t JITTER_DELAY_PACKETS = 3;
+
+unsigned ParseArg(int argc, const char* argv[], int index, unsigned default_value) {
+    if (argc <= index) {
+        return default_value;
+    }
+    const std::string_view arg = argv[index];
+    unsigned value = 0;
+    const auto [end, ec] = std::from_chars(arg.data(), arg.data() + arg.size(), value);
+    if (ec != std::errc{} || end != arg.data() + arg.size()) {
+        throw std::invalid_argument("Invalid argument: "s + std::string(arg));
+    }
+    return value;
+}
+
+// Отсчёт тестового сигнала: синусоида 440 Гц
+std::uint8_t GetSample(size_t frame) {
+    const double phase = 2 * std::numbers::pi * 440.0 * static_cast<double>(frame) / SAMPLE_RATE;
+    return static_cast<std::uint8_t>(std::lround(128 + 100 * std::sin(phase)));
+}
+
+/*
+Посредник между передатчиком и приёмником, имитирующий сеть: отбрасывает датаграммы с
+вероятностью loss_probability и задерживает остальные на случайное время до max_jitter,
+из-за чего датаграммы могут приходить не по порядку.
+*/
+class ImpairedLink {
+public:
+    ImpairedLink(net::io_context& io, const udp::endpoint& destination, double loss_probability,
+                 std::chrono::milliseconds max_jitter, unsigned seed)
+        : io_{io}
+        , socket_{io, udp::endpoint{net::ip::address_v4::loopback(), 0}}
+        , destination_{destination}
+        , loss_{loss_probability}
+        , jitter_{0, static_cast<int>(max_jitter.count() * 1000)}
+        , random_engine_{seed} {
+    }
+
+    udp::endpoint GetLocalEndpoint() const {
+        return socket_.local_endpoint();
+    }
+
+    void Start() {
+        Receive();
+    }
+
+    std::uint64_t GetDroppedCount() const {
+        return dropped_;
+    }
+
+private:
+    void Receive() {
+        socket_.async_receive_from(net::buffer(datagram_), sender_,
+                                   [this](sys::error_code ec, size_t size) {
+                                       if (ec) {
+                                           return;
+                                       }
+                                       Forward(size);
+                                       Receive();
+                                   });
+    }
+
+    void Forward(size_t size) {
+        if (loss_(random_engine_)) {
+            ++dropped_;
+            return;
+        }
+        auto data = std::make_shared<std::vector<std::uint8_t>>(datagram_.begin(),
+                                                                datagram_.begin() + size);
+        auto timer = std::make_shared<net::steady_timer>(
+            io_, std::chrono::microseconds{jitter_(random_engine_)});
+        timer->async_wait([this, data, timer](sys::error_code ec) {
+            if (!ec) {
+                sys::error_code ignored;
+                socket_.send_to(net::buffer(*data), destination_, 0, ignored);
+            }
+        });
+    }
+
+    net::io_context& io_;
+    udp::socket socket_;
+    udp::endpoint sender_;
+    udp::endpoint destination_;
+    std::bernoulli_distribution loss_;
+    std::uniform_int_distribution<int> jitter_;
+    std::mt19937 random_engine_;
+    std::array<std::uint8_t, MAX_PACKET_SIZE> datagram_;
+    std::uint64_t dropped_ = 0;
+};
+
+struct PlayoutStats {
+    size_t played = 0;
+    size_t concealed = 0;
+    Clock::duration total_latency{};
+    Clock::duration max_latency{};
+    double signal_energy = 0;
+    double noise_energy = 0;
+};
+
+/*
+ * Передаёт num_packets пакетов тестового сигнала в реальном темпе через ImpairedLink и
+ * воспроизводит их с тем же темпом из буфера джиттера. Задержка измеряется от момента, когда
+ * пакет был бы полностью записан, до момента его воспроизведения.
+ */
+bool RunLoopbackTest(size_t num_packets, double loss_probability,
+                     std::chrono::milliseconds max_jitter, unsigned seed) {
+    net::io_context io;
+    JitterBuffer jitter_buffer{JITTER_BUFFER_PACKETS, JITTER_DELAY_PACKETS};
+    Receiver receiver{io, udp::endpoint{net::ip::address_v4::loopback(), 0}, jitter_buffer};
+    ImpairedLink link{io, receiver.GetLocalEndpoint(), loss_probability, max_jitter, seed};
+    Sender sender{io, link.GetLocalEndpoint()};
+
+    receiver.Start();
+    link.Start();
+    auto work = net::make_work_guard(io);
+    std::jthread io_thread{[&io] {
+        io.run();
+    }};
+
+    // Моменты записи пакетов. Заполняются передатчиком до отправки пакета
+    std::vector<std::atomic<Clock::rep>> capture_times(num_packets);
+    const auto start_time = Clock::now();
+
+    std::jthread sender_thread{[&] {
+        std::array<std::uint8_t, FRAMES_PER_PACKET> frames;
+        for (size_t packet = 0; packet < num_packets; ++packet) {
+            std::this_thread::sleep_until(start_time + PACKET_DURATION * (packet + 1));
+            for (size_t i = 0; i < frames.size(); ++i) {
+                frames[i] = GetSample(packet * FRAMES_PER_PACKET + i);
+            }
+            capture_times[packet].store(Clock::now().time_since_epoch().count(),
+                                        std::memory_order_release);
+            sender.Send(frames);
+        }
+    }};
+
+    // Воспроизведение идёт с темпом звукового устройства: один пакет за PACKET_DURATION
+    PlayoutStats stats;
+    std::array<std::uint8_t, FRAMES_PER_PACKET> frames;
+    const auto deadline = start_time + PACKET_DURATION * num_packets + 2s;
+    auto tick = start_time;
+    for (std::uint32_t last_sequence = 0; last_sequence + 1 < num_packets;) {
+        tick += PACKET_DURATION;
+        if (tick > deadline) {
+            break;
+        }
+        std::this_thread::sleep_until(tick);
+        const auto result = jitter_buffer.Pop(frames);
+        if (!result) {
+            continue;
+        }
+        last_sequence = result->sequence;
+        if (result->concealed) {
+            ++stats.concealed;
+            continue;
+        }
+        ++stats.played;
+        const auto now = Clock::now();
+        const Clock::time_point capture_time{Clock::duration{
+            capture_times[result->sequence].load(std::memory_order_acquire)}};
+        stats.total_latency += now - capture_time;
+        stats.max_latency = std::max(stats.max_latency, now - capture_time);
+        for (size_t i = 0; i < frames.size(); ++i) {
+            const double original = GetSample(result->sequence * FRAMES_PER_PACKET + i);
+            stats.signal_energy += (original - 128) * (original - 128);
+            stats.noise_energy += (frames[i] - original) * (frames[i] - original);
+        }
+    }
+
+    sender_thread.join();
+    work.reset();
+    io.stop();
+    io_thread.join();
+
+    const auto buffer_stats = jitter_buffer.GetStats();
+    const double loss_rate = static_cast<double>(link.GetDroppedCount()) / num_packets;
+    const double concealed_rate = static_cast<double>(stats.concealed) / num_packets;
+    const double snr = 10 * std::log10(stats.signal_energy / std::max(stats.noise_energy, 1.0));
+    const double seconds = std::chrono::duration<double>(PACKET_DURATION * num_packets).count();
+    auto to_ms = [](Clock::duration d) {
+        return std::chrono::duration<double, std::milli>(d).count();
+    };
+
+    std::cout << "Packets: "sv << num_packets << ", dropped by link: "sv << link.GetDroppedCount()
+              << ", played: "sv << stats.played << ", concealed: "sv << stats.concealed
+              << ", late: "sv << buffer_stats.late << std::endl;
+    std::cout << "Latency: average "sv
+              << (stats.played ? to_ms(stats.total_latency) / stats.played : 0.0)
+              << " ms, max "sv << to_ms(stats.max_latency) << " ms"sv << std::endl;
+    std::cout << "Bandwidth: "sv << sender.GetSentBytes() / seconds << " bytes/s (raw u8: "sv
+              << SAMPLE_RATE << " bytes/s), SNR: "sv << snr << " dB"sv << std::endl;
+
+    bool ok = true;
+    if (stats.played + stats.concealed + 1 < num_packets) {
+        std::cout << "Not all packets have been played"sv << std::endl;
+        ok = false;
+    }
+    // Пакеты, задержанные не дольше буфера джиттера, не должны теряться
+    if (concealed_rate > loss_rate + 0.02) {
+        std::cout << "Too many packets have been concealed"sv << std::endl;
+        ok = false;
+    }
+    if (stats.played != 0 && snr < 20) {
+        std::cout << "Codec quality is too low"sv << std::endl;
+        ok = false;
+    }
+    return ok;
+}
+
+}  // namespace
+
+int main(int argc, const char* argv[]) {
+    try {
+        // radio_udp_loopback_test [<seconds> [<loss percent> [<max jitter ms> [<seed>]]]]
+        const unsigned seconds = ParseArg(argc, argv, 1, 5);
+        const unsigned loss_percent = ParseArg(argc, argv, 2, 5);
+        const auto max_jitter = std::chrono::milliseconds{ParseArg(argc, argv, 3, 30)};
+        const unsigned seed = ParseArg(argc, argv, 4, 42);
+        if (seconds == 0 || loss_percent > 100) {
+            throw std::invalid_argument("Invalid test duration or loss percent");
+        }
+
+        const size_t num_packets = seconds * SAMPLE_RATE / FRAMES_PER_PACKET;
+        if (!RunLoopbackTest(num_packets, loss_percent / 100.0, max_jitter, seed)) {
+            return EXIT_FAILURE;
+        }
+        std::cout << "OK"sv << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/udp.hpp>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <span>
+
+#include "jitter_buffer.h"
+#include "radio_protocol.h"
+
+namespace radio {
+
+namespace net = boost::asio;
+namespace sys = boost::system;
+using net::ip::udp;
+
+/*
+Передатчик радио. Сжимает кадры и отправляет их датаграммами с последовательными номерами.
+*/
+class Sender {
+public:
+    Sender(net::io_context& io, const udp::endpoint& destination)
+        : socket_{io, udp::v4()}
+        , destination_{destination} {
+    }
+
+    // Отправляет пакет из frames (не более FRAMES_PER_PACKET кадров). Ошибки отправки не
+    // прерывают передачу: потерянный пакет приёмник заменит тишиной
+    void Send(std::span<const std::uint8_t> frames) {
+        const size_t size = EncodePacket(next_sequence_++, frames, codec_state_, datagram_);
+        sys::error_code ec;
+        socket_.send_to(net::buffer(datagram_.data(), size), destination_, 0, ec);
+        if (ec) {
+            ++send_errors_;
+        } else {
+            sent_bytes_ += size;
+        }
+    }
+
+    // Номер следующего отправляемого пакета
+    std::uint32_t GetNextSequence() const {
+        return next_sequence_;
+    }
+
+    std::uint64_t GetSentBytes() const {
+        return sent_bytes_;
+    }
+
+    std::uint64_t GetSendErrors() const {
+        return send_errors_;
+    }
+
+private:
+    udp::socket socket_;
+    udp::endpoint destination_;
+    adpcm::State codec_state_;
+    std::uint32_t next_sequence_ = 0;
+    std::array<std::uint8_t, MAX_PACKET_SIZE> datagram_;
+    std::uint64_t sent_bytes_ = 0;
+    std::uint64_t send_errors_ = 0;
+};
+
+/*
+Приёмник радио. Асинхронно принимает датаграммы, декодирует их и помещает в буфер
+компенсации джиттера. Обработчики выполняются в потоке, вызывающем io_context::run.
+*/
+class Receiver {
+public:
+    Receiver(net::io_context& io, const udp::endpoint& endpoint, JitterBuffer& jitter_buffer)
+        : socket_{io, endpoint}
+        , jitter_buffer_{jitter_buffer} {
+    }
+
+    void Start() {
+        Receive();
+    }
+
+    udp::endpoint GetLocalEndpoint() const {
+        return socket_.local_endpoint();
+    }
+
+    // Количество отброшенных повреждённых датаграмм
+    std::uint64_t GetMalformedCount() const {
+        return malformed_.load(std::memory_order_relaxed);
+    }
+
+private:
+    void Receive() {
+        socket_.async_receive_from(net::buffer(datagram_), sender_,
+                                   [this](sys::error_code ec, size_t size) {
+                                       OnReceive(ec, size);
+                                   });
+    }
+
+    void OnReceive(sys::error_code ec, size_t size) {
+        if (ec == net::error::operation_aborted) {
+            return;
+        }
+        if (!ec) {
+            if (DecodePacket(std::span{datagram_}.first(size), packet_)) {
+                jitter_buffer_.Push(packet_);
+            } else {
+                malformed_.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        Receive();
+    }
+
+    udp::socket socket_;
+    udp::endpoint sender_;
+    JitterBuffer& jitter_buffer_;
+    // Датаграмма большего размера будет обрезана и отброшена как повреждённая
+    std::array<std::uint8_t, MAX_PACKET_SIZE + 1> datagram_;
+    Packet packet_;
+    std::atomic_uint64_t malformed_{0};
+};
+
+}  // namespace radio
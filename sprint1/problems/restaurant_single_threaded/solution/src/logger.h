@@ -0,0 +1,126 @@
+#pragma once
+
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include "virtual_clock.h"
+
+/*
+Буферизованный асинхронный приёмник журнала.
+Потоки, пишущие в журнал, только дописывают строки в буфер под мьютексом. Отдельный поток
+периодически забирает накопленный буфер, подменяя его пустым, и записывает в поток вывода.
+Буферы переиспользуются, поэтому в установившемся режиме запись не выделяет память.
+Методы класса можно вызывать из разных потоков.
+*/
+class AsyncLogSink {
+public:
+    // Размер буфера, при достижении которого поток записи будится, не дожидаясь интервала
+    static constexpr size_t FLUSH_THRESHOLD = 64 * 1024;
+
+    explicit AsyncLogSink(std::ostream& out,
+                          std::chrono::milliseconds flush_interval = std::chrono::milliseconds{50})
+        : out_{out}
+        , flush_interval_{flush_interval} {
+        buffer_.reserve(FLUSH_THRESHOLD * 2);
+        thread_ = std::jthread{[this] {
+            Run();
+        }};
+    }
+
+    AsyncLogSink(const AsyncLogSink&) = delete;
+    AsyncLogSink& operator=(const AsyncLogSink&) = delete;
+
+    // Записывает оставшиеся в буфере строки и завершает поток записи
+    ~AsyncLogSink() {
+        {
+            std::lock_guard lock{mutex_};
+            stop_ = true;
+        }
+        cv_.notify_one();
+        thread_.join();
+    }
+
+    void Write(std::string_view text) {
+        bool notify = false;
+        {
+            std::lock_guard lock{mutex_};
+            buffer_.append(text);
+            notify = buffer_.size() >= FLUSH_THRESHOLD;
+        }
+        if (notify) {
+            cv_.notify_one();
+        }
+    }
+
+private:
+    void Run() {
+        std::string buffer;
+        buffer.reserve(FLUSH_THRESHOLD * 2);
+        std::unique_lock lock{mutex_};
+        while (true) {
+            cv_.wait_for(lock, flush_interval_, [this] {
+                return stop_ || buffer_.size() >= FLUSH_THRESHOLD;
+            });
+            const bool stop = stop_;
+            buffer_.swap(buffer);
+
+            lock.unlock();
+            if (!buffer.empty()) {
+                out_.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+                out_.flush();
+                buffer.clear();
+            }
+            if (stop) {
+                return;
+            }
+            lock.lock();
+        }
+    }
+
+    std::ostream& out_;
+    const std::chrono::milliseconds flush_interval_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::string buffer_;
+    bool stop_ = false;
+    std::jthread thread_;
+};
+
+// Журнал объекта с заданным идентификатором. Выводит сообщения в AsyncLogSink
+class Logger {
+public:
+    Logger(AsyncLogSink& sink, std::string id)
+        : sink_{sink}
+        , id_(std::move(id)) {
+    }
+
+    void LogMessage(std::string_view message) const {
+        using namespace std::chrono;
+
+        // Строка формируется в буфере потока, чтобы не выделять память на каждое сообщение
+        thread_local std::string line;
+        line.clear();
+        line.append(id_).append("> [");
+
+        char seconds[32];
+        const auto [end, _] =
+            std::to_chars(std::begin(seconds), std::end(seconds),
+                          duration<double>(SteadyClock::now() - start_time_).count(),
+                          std::chars_format::general, 6);
+        line.append(seconds, end).append("s] ").append(message).push_back('\n');
+
+        sink_.Write(line);
+    }
+
+private:
+    AsyncLogSink& sink_;
+    std::string id_;
+    // В потоке с VirtualClock журнал показывает модельное время
+    SteadyClock::time_point start_time_{SteadyClock::now()};
+};
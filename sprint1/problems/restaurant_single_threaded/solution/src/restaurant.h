@@ -0,0 +1,260 @@
+#pragma once
+#ifdef WIN32
+#include <sdkddkver.h>
+#endif
+
+#include <boost/asio.hpp>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory> // Содержит классы std::shared_ptr и std::enable_shared_from_this
+#include <ostream>
+
+#include "logger.h"
+#include "timer_wheel.h"
+
+namespace net = boost::asio;
+namespace sys = boost::system;
+using namespace std::chrono;
+using namespace std::literals;
+// Таймеры всех заказов обслуживаются одним колесом таймеров ресторана
+using Timer = WheelTimer;
+
+class Hamburger {
+public:
+    [[nodiscard]] bool IsCutletRoasted() const {
+        return cutlet_roasted_;
+    }
+    void SetCutletRoasted() {
+        if (IsCutletRoasted()) {  // Котлету можно жарить только один раз
+            throw std::logic_error("Cutlet has been roasted already"s);
+        }
+        cutlet_roasted_ = true;
+    }
+
+    [[nodiscard]] bool HasOnion() const {
+        return has_onion_;
+    }
+    // Добавляем лук
+    void AddOnion() {
+        if (IsPacked()) {  // Если гамбургер упакован, класть лук в него нельзя
+            throw std::logic_error("Hamburger has been packed already"s);
+        }
+        AssureCutletRoasted();  // Лук разрешается класть лишь после прожаривания котлеты
+        has_onion_ = true;
+    }
+
+    [[nodiscard]] bool IsPacked() const {
+        return is_packed_;
+    }
+    void Pack() {
+        AssureCutletRoasted();  // Нельзя упаковывать гамбургер, если котлета не прожарена
+        is_packed_ = true;
+    }
+
+private:
+    // Убеждаемся, что котлета прожарена
+    void AssureCutletRoasted() const {
+        if (!cutlet_roasted_) {
+            throw std::logic_error("Bread has not been roasted yet"s);
+        }
+    }
+
+    bool cutlet_roasted_ = false;  // Обжарена ли котлета?
+    bool has_onion_ = false;       // Есть ли лук?
+    bool is_packed_ = false;       // Упакован ли гамбургер?
+};
+
+inline std::ostream& operator<<(std::ostream& os, const Hamburger& h) {
+    return os << "Hamburger: "sv << (h.IsCutletRoasted() ? "roasted cutlet"sv : " raw cutlet"sv)
+              << (h.HasOnion() ? ", onion"sv : ""sv)
+              << (h.IsPacked() ? ", packed"sv : ", not packed"sv);
+}
+
+// Функция, которая будет вызвана по окончании обработки заказа
+using OrderHandler = std::function<void(sys::error_code ec, int id, Hamburger* hamburger)>;
+
+// Длительность этапов приготовления гамбургера
+struct CookingTimes {
+    Timer::Clock::duration roast = 1s;
+    Timer::Clock::duration marinade = 2s;
+    Timer::Clock::duration pack = 500ms;
+};
+
+/*
+Заказ гамбургера. Все обработчики заказа выполняются последовательно в его strand, поэтому
+состояние заказа и гамбургера не требует синхронизации, хотя разные заказы
+выполняются параллельно в нескольких потоках.
+*/
+class Order : public std::enable_shared_from_this<Order> {
+public:
+    Order(net::io_context& io, TimerWheel& timer_wheel, AsyncLogSink& log_sink,
+          const CookingTimes& times, int id, bool with_onion, OrderHandler handler)
+        : strand_{ net::make_strand(io) }
+        , times_{ times }
+        , roast_timer_{ timer_wheel }
+        , marinade_timer_{ timer_wheel }
+        , id_{ id }
+        , with_onion_{ with_onion }
+        , handler_{ std::move(handler) }
+        , logger_{ log_sink, std::to_string(id_) } {
+    }
+
+    // Запускает асинхронное выполнение заказа. Может быть вызван из любого потока
+    void Execute() {
+        net::dispatch(strand_, [self = shared_from_this()] {
+            self->logger_.LogMessage("Order has been started."sv);
+            self->RoastCutlet();
+            if (self->with_onion_) {
+                self->MarinadeOnion();
+            }
+        });
+    }
+
+private:
+    using Strand = net::strand<net::io_context::executor_type>;
+
+    void MarinadeOnion() {
+        logger_.LogMessage("Start marinading onion"sv);
+        marinade_timer_.ExpiresAfter(times_.marinade);
+        // Колесо таймеров вызывает обработчик вне strand, поэтому возвращаемся в него
+        marinade_timer_.AsyncWait([self = shared_from_this()](sys::error_code ec) {
+            net::dispatch(self->strand_, [self, ec] {
+                self->OnOnionMarinaded(ec);
+            });
+        });
+    }
+
+    void RoastCutlet() {
+        logger_.LogMessage("Start roasting cutlet"sv);
+        roast_timer_.ExpiresAfter(times_.roast);
+        roast_timer_.AsyncWait([self = shared_from_this()](sys::error_code ec) {
+            net::dispatch(self->strand_, [self, ec] {
+                self->OnRoasted(ec);
+            });
+        });
+    }
+
+    void OnRoasted(sys::error_code ec) {
+        if (ec) {
+            logger_.LogMessage("Roast error : "s + ec.message());
+        }
+        else {
+            logger_.LogMessage("Cutlet has been roasted."sv);
+            hamburger_.SetCutletRoasted();
+        }
+        CheckReadiness(ec);
+    }
+
+    void OnOnionMarinaded(sys::error_code ec) {
+        if (ec) {
+            logger_.LogMessage("Marinade onion error: "s + ec.message());
+        }
+        else {
+            logger_.LogMessage("Onion has been marinaded."sv);
+            onion_marinaded_ = true;
+        }
+        CheckReadiness(ec);
+    }
+
+    void CheckReadiness(sys::error_code ec) {
+        if (delivered_) {
+            // Выходим, если заказ уже доставлен либо клиента уведомили об ошибке
+            return;
+        }
+        if (ec) {
+            // В случае ошибки уведомляем клиента о невозможности выполнить заказ
+            return Deliver(ec);
+        }
+
+        // Самое время добавить лук
+        if (CanAddOnion()) {
+            logger_.LogMessage("Add onion"sv);
+            hamburger_.AddOnion();
+        }
+
+        // Если все компоненты гамбургера готовы, упаковываем его
+        if (IsReadyToPack()) {
+            Pack();
+        }
+    }
+
+    void Deliver(sys::error_code ec) {
+        // Защита заказа от повторной доставки
+        delivered_ = true;
+        // Доставляем гамбургер в случае успеха либо nullptr, если возникла ошибка
+        handler_(ec, id_, ec ? nullptr : &hamburger_);
+    }
+
+    [[nodiscard]] bool CanAddOnion() const {
+        // Лук можно добавить, если котлета обжарена, лук замаринован, но пока не добавлен
+        return hamburger_.IsCutletRoasted() && onion_marinaded_ && !hamburger_.HasOnion();
+    }
+
+    [[nodiscard]] bool IsReadyToPack() const {
+        // Если котлета обжарена и лук добавлен, как просили, гамбургер можно упаковывать
+        return hamburger_.IsCutletRoasted() && (!with_onion_ || hamburger_.HasOnion());
+    }
+
+    void Pack() {
+        logger_.LogMessage("Packing"sv);
+
+        if (VirtualClock* clock = VirtualClock::GetCurrent()) {
+            // В модельном времени упаковка занимает поток, переводя часы вперёд
+            clock->Advance(times_.pack);
+        } else {
+            // Просто потребляем ресурсы процессора в течение заданного времени
+            auto start = steady_clock::now();
+            while (steady_clock::now() - start < times_.pack) {
+            }
+        }
+
+        hamburger_.Pack();
+        logger_.LogMessage("Packed"sv);
+
+        Deliver({});
+    }
+
+    Strand strand_;
+    CookingTimes times_;
+    Timer roast_timer_;
+    Timer marinade_timer_;
+
+    int id_;
+    bool with_onion_;
+    OrderHandler handler_;
+    Logger logger_;
+
+    Hamburger hamburger_;
+    bool onion_marinaded_ = false;
+    bool delivered_ = false; // Заказ доставлен?
+};
+
+/*
+Ресторан. Заказы выполняются в потоках, вызывающих io_context::run. Обработчик заказа
+вызывается в strand заказа.
+Метод MakeHamburger можно вызывать из разных потоков.
+*/
+class Restaurant {
+public:
+    Restaurant(net::io_context& io, AsyncLogSink& log_sink, CookingTimes times = {})
+        : io_(io)
+        , log_sink_(log_sink)
+        , times_(times) {
+    }
+
+    int MakeHamburger(bool with_onion, OrderHandler handler) {
+        const int order_id = next_order_id_.fetch_add(1, std::memory_order_relaxed) + 1;
+        std::make_shared<Order>(io_, timer_wheel_, log_sink_, times_, order_id, with_onion,
+                                std::move(handler))
+            ->Execute();
+        return order_id;
+    }
+
+private:
+    net::io_context& io_;
+    AsyncLogSink& log_sink_;
+    const CookingTimes times_;
+    TimerWheel timer_wheel_{io_};
+    std::atomic_int next_order_id_ = 0;
+};
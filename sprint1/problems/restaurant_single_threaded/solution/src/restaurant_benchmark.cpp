@@ -0,0 +1,117 @@
+#ifdef WIN32
+#include <sdkddkver.h>
+#endif
+
+#include <charconv>
+#include <iostream>
+#include <streambuf>
+#include <thread>
+#include <vector>
+
+#include "restaurant.h"
+
+namespace {
+
+template <typename Fn>
+void RunWorkers(unsigned n, const Fn& fn) {
+    n = std::max(1u, n);
+    std::vector<std::jthread> workers;
+    workers.reserve(n - 1);
+    // Запускаем n-1 рабочих потоков, выполняющих функцию fn
+    while (--n) {
+        workers.emplace_back(fn);
+    }
+    fn();
+}
+
+unsigned ParseArg(int argc, const char* argv[], int index, unsigned default_value) {
+    if (argc <= index) {
+        return default_value;
+    }
+    const std::string_view arg = argv[index];
+    unsigned value = 0;
+    const auto [end, ec] = std::from_chars(arg.data(), arg.data() + arg.size(), value);
+    if (ec != std::errc{} || end != arg.data() + arg.size() || value == 0) {
+        throw std::invalid_argument("Invalid argument: "s + std::string(arg));
+    }
+    return value;
+}
+
+// Буфер потока, отбрасывающий выводимые данные
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int ch) override {
+        return ch;
+    }
+
+    std::streamsize xsputn(const char*, std::streamsize count) override {
+        return count;
+    }
+};
+
+/*
+ * Выполняет num_orders заказов. Чтобы не держать в памяти все заказы сразу, одновременно
+ * выполняется не больше max_in_flight заказов: завершение заказа запускает следующий.
+ * Длительность этапов приготовления нулевая, поэтому измеряются накладные расходы
+ * ресторана: strand, таймеры и журналирование.
+ */
+void RunBenchmark(unsigned num_threads, unsigned num_orders, unsigned max_in_flight,
+                  bool with_onion) {
+    net::io_context io(static_cast<int>(num_threads));
+    NullBuffer null_buffer;
+    std::ostream null_stream{&null_buffer};
+    AsyncLogSink log_sink{null_stream};
+    Restaurant restaurant{io, log_sink, CookingTimes{0s, 0s, 0s}};
+
+    std::atomic_uint started{0};
+    std::atomic_uint completed{0};
+    std::atomic_uint failed{0};
+
+    std::function<void()> start_order;
+    start_order = [&] {
+        if (started.fetch_add(1, std::memory_order_relaxed) >= num_orders) {
+            return;
+        }
+        restaurant.MakeHamburger(with_onion, [&](sys::error_code ec, int, Hamburger* hamburger) {
+            if (ec || !hamburger->IsPacked() || hamburger->HasOnion() != with_onion) {
+                failed.fetch_add(1, std::memory_order_relaxed);
+            }
+            completed.fetch_add(1, std::memory_order_relaxed);
+            start_order();
+        });
+    };
+    for (unsigned i = 0; i < std::min(max_in_flight, num_orders); ++i) {
+        start_order();
+    }
+
+    const auto start_time = steady_clock::now();
+    RunWorkers(num_threads, [&io] {
+        io.run();
+    });
+    const double seconds = duration<double>(steady_clock::now() - start_time).count();
+
+    if (completed != num_orders || failed != 0) {
+        throw std::logic_error("Some orders have not been completed");
+    }
+    std::cout << (with_onion ? "With onion"sv : "Without onion"sv) << ": threads: "sv
+              << num_threads << ", orders: "sv << num_orders << ", time: "sv << seconds
+              << "s, orders/s: "sv << static_cast<std::uint64_t>(num_orders / seconds)
+              << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, const char* argv[]) {
+    try {
+        // restaurant_benchmark [<orders> [<threads> [<max orders in flight>]]]
+        const unsigned num_orders = ParseArg(argc, argv, 1, 1'000'000);
+        const unsigned num_threads =
+            ParseArg(argc, argv, 2, std::max(1u, std::thread::hardware_concurrency()));
+        const unsigned max_in_flight = ParseArg(argc, argv, 3, 10'000);
+        RunBenchmark(num_threads, num_orders, max_in_flight, false);
+        RunBenchmark(num_threads, num_orders, max_in_flight, true);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+}
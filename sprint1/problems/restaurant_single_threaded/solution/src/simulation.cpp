@@ -0,0 +1,116 @@
+#ifdef WIN32
+#include <sdkddkver.h>
+#endif
+
+#include <algorithm>
+#include <charconv>
+#include <iostream>
+#include <streambuf>
+#include <vector>
+
+#include "restaurant.h"
+
+namespace {
+
+unsigned ParseArg(int argc, const char* argv[], int index, unsigned default_value) {
+    if (argc <= index) {
+        return default_value;
+    }
+    const std::string_view arg = argv[index];
+    unsigned value = 0;
+    const auto [end, ec] = std::from_chars(arg.data(), arg.data() + arg.size(), value);
+    if (ec != std::errc{} || end != arg.data() + arg.size()) {
+        throw std::invalid_argument("Invalid argument: "s + std::string(arg));
+    }
+    return value;
+}
+
+// Буфер потока, отбрасывающий выводимые данные
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int ch) override {
+        return ch;
+    }
+
+    std::streamsize xsputn(const char*, std::streamsize count) override {
+        return count;
+    }
+};
+
+double AsSeconds(SteadyClock::duration d) {
+    return duration<double>(d).count();
+}
+
+/*
+ * Выполняет num_orders заказов со стандартной длительностью этапов в модельном времени.
+ * Заказы поступают с интервалом order_interval, каждый второй заказ - с луком. Заказы
+ * выполняются в одном потоке, поэтому упаковки выполняются последовательно.
+ */
+void RunSimulation(unsigned num_orders, milliseconds order_interval, std::ostream& log) {
+    VirtualClock clock;
+    net::io_context io{1};
+    AsyncLogSink log_sink{log};
+    Restaurant restaurant{io, log_sink};
+
+    // Время выполнения заказов без лука и с луком
+    std::vector<SteadyClock::duration> latencies[2];
+    unsigned failed = 0;
+
+    const auto start_time = SteadyClock::now();
+    for (unsigned i = 0; i < num_orders; ++i) {
+        const auto order_time = start_time + order_interval * i;
+        const bool with_onion = i % 2 != 0;
+        clock.Schedule(order_time, [&, order_time, with_onion] {
+            restaurant.MakeHamburger(with_onion, [&, order_time, with_onion](
+                                                     sys::error_code ec, int, Hamburger* h) {
+                if (ec || !h->IsPacked() || h->HasOnion() != with_onion) {
+                    ++failed;
+                }
+                latencies[with_onion].push_back(SteadyClock::now() - order_time);
+            });
+        });
+    }
+
+    const auto wall_start = steady_clock::now();
+    clock.Run(io);
+    const auto wall_duration = steady_clock::now() - wall_start;
+
+    if (latencies[0].size() + latencies[1].size() != num_orders || failed != 0) {
+        throw std::logic_error("Some orders have not been completed");
+    }
+    std::cout << "Orders: "sv << num_orders << ", simulated time: "sv
+              << AsSeconds(SteadyClock::now() - start_time) << "s, wall time: "sv
+              << AsSeconds(wall_duration) << 's' << std::endl;
+    for (const bool with_onion : {false, true}) {
+        auto& order_latencies = latencies[with_onion];
+        if (order_latencies.empty()) {
+            continue;
+        }
+        std::sort(order_latencies.begin(), order_latencies.end());
+        const auto percentile = [&order_latencies](double p) {
+            return AsSeconds(
+                order_latencies[static_cast<size_t>(p * (order_latencies.size() - 1))]);
+        };
+        std::cout << (with_onion ? "With onion"sv : "Without onion"sv) << " latency: min "sv
+                  << percentile(0) << "s, p50 "sv << percentile(0.5) << "s, p99 "sv
+                  << percentile(0.99) << "s, max "sv << percentile(1) << 's' << std::endl;
+    }
+}
+
+}  // namespace
+
+int main(int argc, const char* argv[]) {
+    try {
+        // restaurant_simulation [<orders> [<order interval, ms> [<print log: 0 or 1>]]]
+        const unsigned num_orders = ParseArg(argc, argv, 1, 10'000);
+        const milliseconds order_interval{ParseArg(argc, argv, 2, 0)};
+        const bool print_log = ParseArg(argc, argv, 3, 0) != 0;
+
+        NullBuffer null_buffer;
+        std::ostream null_stream{&null_buffer};
+        RunSimulation(num_orders, order_interval, print_log ? std::cout : null_stream);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+}
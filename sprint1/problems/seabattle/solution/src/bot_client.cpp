@@ -0,0 +1,179 @@
+#include "bot_client.h"
+
+#include <boost/asio/post.hpp>
+#include <boost/asio/strand.hpp>
+#include <boost/asio/write.hpp>
+
+namespace bot {
+
+using protocol::Message;
+using protocol::MessageType;
+
+BotClient::BotClient(net::io_context& io, const std::vector<std::uint64_t>& fields,
+                     unsigned seed, LoadStats& stats)
+    : socket_{net::make_strand(io)}
+    , fields_{fields}
+    , random_engine_{seed}
+    , stats_{stats} {
+}
+
+void BotClient::Start(const tcp::endpoint& endpoint) {
+    socket_.async_connect(endpoint, [self = shared_from_this()](sys::error_code ec) {
+        self->OnConnect(ec);
+    });
+}
+
+void BotClient::Stop() {
+    net::post(socket_.get_executor(), [self = shared_from_this()] {
+        self->Close();
+    });
+}
+
+void BotClient::OnConnect(sys::error_code ec) {
+    if (ec) {
+        stats_.errors.fetch_add(1, std::memory_order_relaxed);
+        Close();
+        return;
+    }
+    sys::error_code ignored;
+    socket_.set_option(tcp::no_delay{true}, ignored);
+    Join();
+    Read();
+}
+
+void BotClient::Join() {
+    std::uniform_int_distribution<size_t> field_index{0, fields_.size() - 1};
+    Enqueue(Message::Join(fields_[field_index(random_engine_)]));
+}
+
+void BotClient::Shoot() {
+    if (opponent_field_.IsLoser() || my_losses_ == SeabattleField::ship_cells) {
+        return;
+    }
+    const auto [x, y] = shot_selector_.SelectShot(opponent_field_, random_engine_);
+    Enqueue(Message::Shot(static_cast<std::uint8_t>(x), static_cast<std::uint8_t>(y)));
+}
+
+void BotClient::Read() {
+    const auto space = reader_.GetFreeSpace();
+    socket_.async_read_some(net::buffer(space.data(), space.size()),
+                            [self = shared_from_this()](sys::error_code ec, size_t bytes_read) {
+                                self->OnRead(ec, bytes_read);
+                            });
+}
+
+void BotClient::OnRead(sys::error_code ec, size_t bytes_read) {
+    if (ec) {
+        Close();
+        return;
+    }
+    reader_.Commit(bytes_read);
+    try {
+        while (auto message = reader_.Next()) {
+            HandleMessage(*message);
+        }
+    } catch (const std::invalid_argument&) {
+        stats_.errors.fetch_add(1, std::memory_order_relaxed);
+        Close();
+    }
+    if (!closed_) {
+        Read();
+    }
+}
+
+void BotClient::HandleMessage(const Message& message) {
+    using ShotResult = SeabattleField::ShotResult;
+
+    switch (message.GetType()) {
+        case MessageType::MATCHED:
+            opponent_field_ = SeabattleField{};
+            my_losses_ = 0;
+            if (message.data[1]) {
+                Shoot();
+            }
+            return;
+        case MessageType::SHOT_RESULT: {
+            const bool by_opponent = message.data[3] & protocol::SHOT_BY_OPPONENT;
+            const auto result =
+                static_cast<ShotResult>(message.data[3] & ~protocol::SHOT_BY_OPPONENT);
+            if (by_opponent) {
+                // Промах соперника передаёт ход боту
+                if (result == ShotResult::MISS) {
+                    Shoot();
+                } else {
+                    ++my_losses_;
+                }
+            } else {
+                stats_.moves.fetch_add(1, std::memory_order_relaxed);
+                const size_t x = message.data[1];
+                const size_t y = message.data[2];
+                switch (result) {
+                    case ShotResult::MISS:
+                        opponent_field_.MarkMiss(x, y);
+                        break;
+                    case ShotResult::HIT:
+                        opponent_field_.MarkHit(x, y);
+                        // После попадания бот стреляет ещё раз
+                        Shoot();
+                        break;
+                    case ShotResult::KILL:
+                        opponent_field_.MarkKill(x, y);
+                        Shoot();
+                        break;
+                }
+            }
+            return;
+        }
+        case MessageType::GAME_OVER:
+            stats_.games_over.fetch_add(1, std::memory_order_relaxed);
+            Join();
+            return;
+        default:
+            stats_.errors.fetch_add(1, std::memory_order_relaxed);
+            return;
+    }
+}
+
+void BotClient::Enqueue(const Message& message) {
+    if (closed_) {
+        return;
+    }
+    const auto bytes = message.GetBytes();
+    write_queue_.insert(write_queue_.end(), bytes.begin(), bytes.end());
+    if (!writing_) {
+        Write();
+    }
+}
+
+void BotClient::Write() {
+    write_buffer_.swap(write_queue_);
+    writing_ = true;
+    net::async_write(socket_, net::buffer(write_buffer_),
+                     [self = shared_from_this()](sys::error_code ec, size_t bytes_written) {
+                         self->OnWrite(ec, bytes_written);
+                     });
+}
+
+void BotClient::OnWrite(sys::error_code ec, [[maybe_unused]] size_t bytes_written) {
+    writing_ = false;
+    write_buffer_.clear();
+    if (ec) {
+        Close();
+        return;
+    }
+    if (!write_queue_.empty() && !closed_) {
+        Write();
+    }
+}
+
+void BotClient::Close() {
+    if (closed_) {
+        return;
+    }
+    closed_ = true;
+    sys::error_code ec;
+    socket_.shutdown(tcp::socket::shutdown_both, ec);
+    socket_.close(ec);
+}
+
+}  // namespace bot
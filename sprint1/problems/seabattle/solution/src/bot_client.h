@@ -0,0 +1,74 @@
+#pragma once
+#ifdef WIN32
+#include <sdkddkver.h>
+#endif
+
+#include <atomic>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "protocol.h"
+#include "seabattle.h"
+#include "shot_selector.h"
+
+namespace bot {
+
+namespace net = boost::asio;
+namespace sys = boost::system;
+using net::ip::tcp;
+
+// Статистика нагрузочного тестирования
+struct LoadStats {
+    // Количество завершённых партий с точки зрения клиентов (каждая партия учитывается дважды)
+    std::atomic_uint64_t games_over{0};
+    std::atomic_uint64_t moves{0};
+    std::atomic_uint64_t errors{0};
+};
+
+/*
+Клиент-бот для нагрузочного тестирования сервера. Встаёт в очередь со случайным полем из
+заранее сгенерированного набора, выбирает выстрелы по плотности вероятности (ShotSelector)
+и по окончании партии сразу начинает следующую.
+*/
+class BotClient : public std::enable_shared_from_this<BotClient> {
+public:
+    BotClient(net::io_context& io, const std::vector<std::uint64_t>& fields, unsigned seed,
+              LoadStats& stats);
+
+    void Start(const tcp::endpoint& endpoint);
+
+    // Закрывает соединение. Можно вызывать из любого потока
+    void Stop();
+
+private:
+    void OnConnect(sys::error_code ec);
+    void Join();
+    void Shoot();
+    void Read();
+    void OnRead(sys::error_code ec, size_t bytes_read);
+    void HandleMessage(const protocol::Message& message);
+    void Enqueue(const protocol::Message& message);
+    void Write();
+    void OnWrite(sys::error_code ec, size_t bytes_written);
+    void Close();
+
+    tcp::socket socket_;
+    const std::vector<std::uint64_t>& fields_;
+    std::mt19937 random_engine_;
+    LoadStats& stats_;
+    protocol::MessageReader reader_;
+    std::vector<std::uint8_t> write_queue_;
+    std::vector<std::uint8_t> write_buffer_;
+    bool writing_ = false;
+    bool closed_ = false;
+    ShotSelector shot_selector_;
+    // Поле соперника в том виде, в каком его видит бот
+    SeabattleField opponent_field_;
+    // Количество подбитых клеток кораблей бота
+    int my_losses_ = 0;
+};
+
+}  // namespace bot
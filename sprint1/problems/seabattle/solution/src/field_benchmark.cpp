@@ -0,0 +1,65 @@
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+
+#include "seabattle.h"
+
+using namespace std::literals;
+
+namespace {
+
+unsigned ParseArg(int argc, const char* argv[], int index, unsigned default_value) {
+    if (argc <= index) {
+        return default_value;
+    }
+    const std::string_view arg = argv[index];
+    unsigned value = 0;
+    const auto [end, ec] = std::from_chars(arg.data(), arg.data() + arg.size(), value);
+    if (ec != std::errc{} || end != arg.data() + arg.size() || value == 0) {
+        throw std::invalid_argument("Invalid argument: "s + std::string(arg));
+    }
+    return value;
+}
+
+/*
+ * Генерирует num_fields случайных полей и выводит количество полей, генерируемых в секунду.
+ * Каждое поле проверяется: расстановка кораблей должна быть допустимой
+ */
+void RunBenchmark(unsigned num_fields, unsigned seed) {
+    std::mt19937 random_engine{seed};
+    // Накопленное значение масок не даёт компилятору выбросить генерацию полей
+    std::uint64_t checksum = 0;
+
+    const auto start_time = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i < num_fields; ++i) {
+        const auto mask = SeabattleField::GetRandomField(random_engine).GetShipMask();
+        if (!SeabattleField::IsValidShipMask(mask)) {
+            throw std::logic_error("Invalid field has been generated");
+        }
+        checksum ^= mask;
+    }
+    const double seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+
+    std::cout << "Fields: "sv << num_fields << ", time: "sv << seconds << "s, fields/s: "sv
+              << static_cast<std::uint64_t>(num_fields / seconds) << ", checksum: "sv << checksum
+              << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, const char* argv[]) {
+    try {
+        // seabattle_field_benchmark [<fields> [<seed>]]
+        const unsigned num_fields = ParseArg(argc, argv, 1, 1'000'000);
+        const unsigned seed = ParseArg(argc, argv, 2, 42);
+        RunBenchmark(num_fields, seed);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,109 @@
+#ifdef WIN32
+#include <sdkddkver.h>
+#endif
+
+#include <boost/asio/steady_timer.hpp>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "bot_client.h"
+#include "seabattle.h"
+
+namespace {
+
+using namespace bot;
+using namespace std::literals;
+
+// Количество заранее сгенерированных полей. Генерация поля заметно дороже хода, поэтому
+// поля не создаются на каждую партию, чтобы не искажать измерение производительности сервера
+constexpr size_t FIELD_POOL_SIZE = 1024;
+
+// Запускает функцию fn на n потоках, включая текущий
+template <typename Fn>
+void RunWorkers(unsigned n, const Fn& fn) {
+    n = std::max(1u, n);
+    std::vector<std::jthread> workers;
+    workers.reserve(n - 1);
+    // Запускаем n-1 рабочих потоков, выполняющих функцию fn
+    while (--n) {
+        workers.emplace_back(fn);
+    }
+    fn();
+}
+
+}  // namespace
+
+int main(int argc, const char** argv) {
+    if (argc < 3 || argc > 6) {
+        std::cout << "Usage: seabattle_loadtest <ip> <port> [<connections> [<seconds> [<seed>]]]"
+                  << std::endl;
+        return 1;
+    }
+
+    try {
+        const tcp::endpoint endpoint{net::ip::make_address(argv[1]),
+                                     static_cast<unsigned short>(std::stoi(argv[2]))};
+        const int num_connections = argc > 3 ? std::stoi(argv[3]) : 1000;
+        const auto test_duration = std::chrono::seconds{argc > 4 ? std::stoi(argv[4]) : 10};
+        const unsigned seed = argc > 5 ? static_cast<unsigned>(std::stoul(argv[5])) : 42u;
+        if (num_connections < 2 || test_duration.count() <= 0) {
+            throw std::invalid_argument("Invalid number of connections or test duration");
+        }
+
+        std::mt19937 engine{seed};
+        std::vector<std::uint64_t> fields;
+        fields.reserve(FIELD_POOL_SIZE);
+        for (size_t i = 0; i < FIELD_POOL_SIZE; ++i) {
+            fields.push_back(SeabattleField::GetRandomField(engine).GetShipMask());
+        }
+
+        const unsigned num_threads = std::max(1u, std::thread::hardware_concurrency());
+        net::io_context io(static_cast<int>(num_threads));
+        LoadStats stats;
+
+        std::vector<std::shared_ptr<BotClient>> bots;
+        bots.reserve(num_connections);
+        for (int i = 0; i < num_connections; ++i) {
+            bots.push_back(std::make_shared<BotClient>(io, fields, seed + i + 1, stats));
+            bots.back()->Start(endpoint);
+        }
+
+        // Статистика снимается по истечении заданного времени, после чего боты отключаются
+        std::uint64_t games_over = 0;
+        std::uint64_t moves = 0;
+        std::uint64_t errors = 0;
+        std::chrono::duration<double> elapsed{};
+        const auto start_time = std::chrono::steady_clock::now();
+        net::steady_timer timer{io, test_duration};
+        timer.async_wait([&](sys::error_code) {
+            games_over = stats.games_over;
+            moves = stats.moves;
+            errors = stats.errors;
+            elapsed = std::chrono::steady_clock::now() - start_time;
+            for (auto& bot : bots) {
+                bot->Stop();
+            }
+        });
+
+        RunWorkers(num_threads, [&io] {
+            io.run();
+        });
+
+        const double seconds = elapsed.count();
+        // Каждую партию завершают оба её участника
+        const auto games = games_over / 2;
+        std::cout << "Connections: "sv << num_connections << ", time: "sv << seconds
+                  << "s, games: "sv << games << ", games/s: "sv
+                  << static_cast<std::uint64_t>(games / seconds) << ", moves/s: "sv
+                  << static_cast<std::uint64_t>(moves / seconds) << ", errors: "sv << errors
+                  << std::endl;
+        if (errors != 0) {
+            return EXIT_FAILURE;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,36 @@
+#include "protocol.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace protocol {
+
+std::optional<Message> MessageReader::Next() {
+    if (begin_ == end_) {
+        return std::nullopt;
+    }
+    const size_t size = GetMessageSize(buffer_[begin_]);
+    if (size == 0) {
+        throw std::invalid_argument("Unknown message type");
+    }
+    if (end_ - begin_ < size) {
+        return std::nullopt;
+    }
+    Message message;
+    std::copy_n(buffer_.begin() + begin_, size, message.data.begin());
+    begin_ += size;
+    return message;
+}
+
+void MessageReader::Compact() noexcept {
+    if (begin_ == 0) {
+        return;
+    }
+    // Перед чтением из сокета полные сообщения уже извлечены, поэтому сдвигается лишь
+    // недопринятый остаток, который короче MAX_MESSAGE_SIZE
+    std::copy(buffer_.begin() + begin_, buffer_.begin() + end_, buffer_.begin());
+    end_ -= begin_;
+    begin_ = 0;
+}
+
+}  // namespace protocol
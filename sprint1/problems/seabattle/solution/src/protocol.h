@@ -0,0 +1,155 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+
+/*
+Двоичный протокол сервера морского боя.
+Каждое сообщение начинается с байта типа, за которым следуют данные фиксированного для
+этого типа размера. Координаты передаются одним байтом каждая (0..field_size-1).
+
+Клиент -> сервер:
+  JOIN        тип, маска кораблей (8 байт, little-endian) - встать в очередь на игру
+  SHOT        тип, x, y - выстрел
+
+Сервер -> клиент:
+  MATCHED     тип, 1 если первый ход за клиентом, иначе 0
+  SHOT_RESULT тип, x, y, результат (ShotResult) | SHOT_BY_OPPONENT, если стрелял соперник
+  GAME_OVER   тип, 1 если клиент победил, иначе 0
+  ERROR       тип, код ошибки (ErrorCode)
+
+После GAME_OVER клиент может отправить JOIN, чтобы сыграть следующую игру в том же
+соединении.
+*/
+namespace protocol {
+
+enum class MessageType : std::uint8_t {
+    JOIN = 1,
+    SHOT = 2,
+    MATCHED = 3,
+    SHOT_RESULT = 4,
+    GAME_OVER = 5,
+    ERROR = 6,
+};
+
+enum class ErrorCode : std::uint8_t {
+    BAD_MESSAGE = 1,
+    INVALID_FIELD = 2,
+    NOT_YOUR_TURN = 3,
+    INVALID_MOVE = 4,
+};
+
+// Флаг в поле результата SHOT_RESULT: выстрел сделан соперником по полю клиента
+constexpr std::uint8_t SHOT_BY_OPPONENT = 0x80;
+
+// Максимальный размер сообщения
+constexpr size_t MAX_MESSAGE_SIZE = 9;
+
+// Возвращает размер сообщения заданного типа или 0 для неизвестного типа
+constexpr size_t GetMessageSize(std::uint8_t type) noexcept {
+    switch (static_cast<MessageType>(type)) {
+        case MessageType::JOIN:
+            return 9;
+        case MessageType::SHOT:
+            return 3;
+        case MessageType::MATCHED:
+            return 2;
+        case MessageType::SHOT_RESULT:
+            return 4;
+        case MessageType::GAME_OVER:
+            return 2;
+        case MessageType::ERROR:
+            return 2;
+    }
+    return 0;
+}
+
+// Сообщение, размер которого не превышает MAX_MESSAGE_SIZE
+struct Message {
+    std::array<std::uint8_t, MAX_MESSAGE_SIZE> data{};
+
+    MessageType GetType() const noexcept {
+        return static_cast<MessageType>(data[0]);
+    }
+
+    size_t GetSize() const noexcept {
+        return GetMessageSize(data[0]);
+    }
+
+    std::span<const std::uint8_t> GetBytes() const noexcept {
+        return {data.data(), GetSize()};
+    }
+
+    std::uint64_t GetShipMask() const noexcept {
+        std::uint64_t mask = 0;
+        for (size_t i = 0; i < 8; ++i) {
+            mask |= std::uint64_t{data[1 + i]} << (8 * i);
+        }
+        return mask;
+    }
+
+    static Message Join(std::uint64_t ship_mask) noexcept {
+        Message message{{static_cast<std::uint8_t>(MessageType::JOIN)}};
+        for (size_t i = 0; i < 8; ++i) {
+            message.data[1 + i] = static_cast<std::uint8_t>(ship_mask >> (8 * i));
+        }
+        return message;
+    }
+
+    static Message Shot(std::uint8_t x, std::uint8_t y) noexcept {
+        return {{static_cast<std::uint8_t>(MessageType::SHOT), x, y}};
+    }
+
+    static Message Matched(bool my_turn) noexcept {
+        return {{static_cast<std::uint8_t>(MessageType::MATCHED), my_turn}};
+    }
+
+    static Message ShotResult(std::uint8_t x, std::uint8_t y, std::uint8_t result,
+                              bool by_opponent) noexcept {
+        return {{static_cast<std::uint8_t>(MessageType::SHOT_RESULT), x, y,
+                 static_cast<std::uint8_t>(result | (by_opponent ? SHOT_BY_OPPONENT : 0))}};
+    }
+
+    static Message GameOver(bool won) noexcept {
+        return {{static_cast<std::uint8_t>(MessageType::GAME_OVER), won}};
+    }
+
+    static Message Error(ErrorCode code) noexcept {
+        return {{static_cast<std::uint8_t>(MessageType::ERROR), static_cast<std::uint8_t>(code)}};
+    }
+};
+
+/*
+ * Извлекает сообщения из буфера приёма. Данные, поступающие из сокета, дописываются в
+ * буфер, возвращаемый GetFreeSpace, после чего Commit фиксирует их, а Next возвращает
+ * очередное полностью принятое сообщение.
+ */
+class MessageReader {
+public:
+    static constexpr size_t BUFFER_SIZE = 512;
+
+    std::span<std::uint8_t> GetFreeSpace() noexcept {
+        Compact();
+        return {buffer_.data() + end_, buffer_.size() - end_};
+    }
+
+    void Commit(size_t size) noexcept {
+        end_ += size;
+    }
+
+    // Возвращает следующее сообщение, nullopt, если сообщение принято не полностью.
+    // Выбрасывает std::invalid_argument, если тип сообщения неизвестен
+    std::optional<Message> Next();
+
+private:
+    void Compact() noexcept;
+
+    std::array<std::uint8_t, BUFFER_SIZE> buffer_;
+    size_t begin_ = 0;
+    size_t end_ = 0;
+};
+
+}  // namespace protocol
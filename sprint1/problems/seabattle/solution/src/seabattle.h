@@ -0,0 +1,358 @@
+#pragma once
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <optional>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+
+/*
+Поле морского боя хранится в виде битовых досок: для каждого состояния клеток заводится
+64-битная маска, в которой клетке (x, y) соответствует бит x + y * field_size.
+Маски разных состояний не пересекаются, а их объединение покрывает всё поле. Соседние
+клетки находятся сдвигами масок, а количество клеток в состоянии - через popcount.
+*/
+class SeabattleField {
+public:
+    enum class State {
+        UNKNOWN,
+        EMPTY,
+        KILLED,
+        SHIP
+    };
+
+    static const size_t field_size = 8;
+
+    SeabattleField(State default_elem = State::UNKNOWN) {
+        masks_[static_cast<size_t>(default_elem)] = ALL_CELLS;
+    }
+
+    template <class T>
+    static SeabattleField GetRandomField(T&& random_engine) {
+        std::optional<SeabattleField> res;
+        do {
+            res = TryGetRandomField(random_engine);
+        } while (!res);
+
+        return *res;
+    }
+
+    // Размеры кораблей, расставляемых на поле
+    static constexpr std::array ship_sizes = {4, 3, 3, 2, 2, 2, 1, 1, 1, 1};
+
+    // Операции над битовыми масками поля
+
+    using Mask = uint64_t;
+
+    static constexpr Mask ALL_CELLS = ~Mask{0};
+    // Клетки первого и последнего столбцов
+    static constexpr Mask FIRST_COLUMN = 0x0101010101010101;
+    static constexpr Mask LAST_COLUMN = FIRST_COLUMN << (field_size - 1);
+
+    static constexpr Mask CellMask(size_t x, size_t y) {
+        return Mask{1} << (x + y * field_size);
+    }
+
+    // Сдвиги маски на клетку вправо, влево, вниз и вверх. Клетки, вышедшие за пределы поля,
+    // отбрасываются
+    static constexpr Mask ShiftRight(Mask mask) {
+        return (mask & ~LAST_COLUMN) << 1;
+    }
+
+    static constexpr Mask ShiftLeft(Mask mask) {
+        return (mask & ~FIRST_COLUMN) >> 1;
+    }
+
+    static constexpr Mask ShiftDown(Mask mask) {
+        return mask << field_size;
+    }
+
+    static constexpr Mask ShiftUp(Mask mask) {
+        return mask >> field_size;
+    }
+
+    // Добавляет к маске все клетки, соседние с её клетками, в том числе по диагонали
+    static constexpr Mask Dilate(Mask mask) {
+        const Mask row = mask | ShiftRight(mask) | ShiftLeft(mask);
+        return row | ShiftDown(row) | ShiftUp(row);
+    }
+
+    // Клетки, с которых можно начать корабль длины ship_length, уложив его вправо (horizontal)
+    // или вниз по свободным клеткам free
+    static constexpr Mask GetShipStarts(Mask free, int ship_length, bool horizontal) {
+        Mask starts = free;
+        Mask tail = free;
+        for (int i = 1; i < ship_length; ++i) {
+            tail = horizontal ? ShiftLeft(tail) : ShiftUp(tail);
+            starts &= tail;
+        }
+        return starts;
+    }
+
+    // Маска корабля длины ship_length, начинающегося в клетке start
+    static constexpr Mask GetShipCells(Mask start, int ship_length, bool horizontal) {
+        Mask cells = start;
+        for (int i = 1; i < ship_length; ++i) {
+            start = horizontal ? ShiftRight(start) : ShiftDown(start);
+            cells |= start;
+        }
+        return cells;
+    }
+
+    // Возвращает установленный бит маски с порядковым номером index
+    static Mask SelectBit(Mask mask, int index) {
+        for (; index > 0; --index) {
+            mask &= mask - 1;
+        }
+        return mask & -mask;
+    }
+
+private:
+    template<class T>
+    static std::optional<SeabattleField> TryGetRandomField(T&& random_engine) {
+        // Клетки, не занятые кораблями и не соседствующие с ними
+        Mask free = ALL_CELLS;
+        Mask ships = 0;
+
+        using Distr = std::uniform_int_distribution<int>;
+        using Param = Distr::param_type;
+        Distr d;
+
+        for (int length : ship_sizes) {
+            // Выбираем положение корабля равновероятно среди всех допустимых положений.
+            // Однопалубный корабль в обоих направлениях занимает одну и ту же клетку
+            const Mask horizontal_starts = GetShipStarts(free, length, true);
+            const Mask vertical_starts = length > 1 ? GetShipStarts(free, length, false) : 0;
+            const int horizontal_count = std::popcount(horizontal_starts);
+            const int total_count = horizontal_count + std::popcount(vertical_starts);
+            if (total_count == 0) {
+                return std::nullopt;
+            }
+
+            const int index = d(random_engine, Param(0, total_count - 1));
+            const bool horizontal = index < horizontal_count;
+            const Mask start = horizontal
+                ? SelectBit(horizontal_starts, index)
+                : SelectBit(vertical_starts, index - horizontal_count);
+
+            const Mask ship = GetShipCells(start, length, horizontal);
+            ships |= ship;
+            free &= ~Dilate(ship);
+        }
+
+        return FromMasks(ships, ~ships, State::SHIP, State::EMPTY);
+    }
+
+    static SeabattleField FromMasks(Mask first, Mask second, State first_state,
+                                    State second_state) {
+        SeabattleField result;
+        result.masks_ = {};
+        result.masks_[static_cast<size_t>(first_state)] = first;
+        result.masks_[static_cast<size_t>(second_state)] = second;
+        return result;
+    }
+
+    // Возвращает подбитые клетки, образующие вместе с клеткой cell непрерывную линию
+    // по горизонтали (horizontal) или вертикали
+    Mask GetKilledLine(Mask cell, bool horizontal) const {
+        const Mask killed = GetMask(State::KILLED);
+        Mask line = cell;
+        while (true) {
+            const Mask grown = horizontal ? line | ShiftRight(line) | ShiftLeft(line)
+                                          : line | ShiftDown(line) | ShiftUp(line);
+            const Mask next = line | (grown & killed);
+            if (next == line) {
+                return line;
+            }
+            line = next;
+        }
+    }
+
+    // Линия подбитых клеток убита, если её концы не граничат с целыми или неизвестными клетками
+    bool IsKilledLine(Mask line, bool horizontal) const {
+        const Mask ends = horizontal ? ShiftRight(line) | ShiftLeft(line)
+                                     : ShiftDown(line) | ShiftUp(line);
+        return (ends & ~line & (GetMask(State::SHIP) | GetMask(State::UNKNOWN))) == 0;
+    }
+
+    // Помечает пустыми неизвестные клетки вокруг убитого корабля ship
+    void MarkKillSurroundings(Mask ship) {
+        const Mask surroundings = Dilate(ship) & ~ship & GetMask(State::UNKNOWN);
+        masks_[static_cast<size_t>(State::UNKNOWN)] &= ~surroundings;
+        masks_[static_cast<size_t>(State::EMPTY)] |= surroundings;
+    }
+
+public:
+    enum class ShotResult {
+        MISS = 0,
+        HIT  = 1,
+        KILL = 2
+    };
+
+    ShotResult Shoot(size_t x, size_t y) {
+        if (Get(x, y) != State::SHIP) return ShotResult::MISS;
+
+        Set(x, y, State::KILLED);
+
+        return IsKilled(x, y) ? ShotResult::KILL : ShotResult::HIT;
+    }
+
+    void MarkMiss(size_t x, size_t y) {
+        if (Get(x, y) != State::UNKNOWN) {
+            return;
+        }
+        Set(x, y, State::EMPTY);
+    }
+
+    void MarkHit(size_t x, size_t y) {
+        if (Get(x, y) != State::UNKNOWN) {
+            return;
+        }
+        Set(x, y, State::KILLED);
+    }
+
+    void MarkKill(size_t x, size_t y) {
+        if (Get(x, y) != State::UNKNOWN) {
+            return;
+        }
+        MarkHit(x, y);
+        const Mask cell = CellMask(x, y);
+        MarkKillSurroundings(GetKilledLine(cell, true) | GetKilledLine(cell, false));
+    }
+
+    // Количество клеток, занятых кораблями
+    static const int ship_cells = 1 * 4 + 2 * 3 + 3 * 2 + 4 * 1;
+
+    /*
+    Проверяет, что маска задаёт допустимую расстановку: клетки образуют прямые корабли,
+    которые не касаются друг друга даже углами, а размеры кораблей совпадают с ship_sizes.
+    Корабль - это компонента связности клеток с учётом соседства по диагонали, поэтому
+    касающиеся корабли сливаются в одну компоненту, которая не является прямой линией
+    */
+    static bool IsValidShipMask(Mask mask) {
+        if (std::popcount(mask) != ship_cells) {
+            return false;
+        }
+        // Количество кораблей каждой длины, которые ещё не найдены в маске
+        std::array<int, ship_sizes[0] + 1> remaining{};
+        for (int length : ship_sizes) {
+            ++remaining[length];
+        }
+
+        while (mask) {
+            // Младший бит - левая клетка верхней строки корабля. Из неё корабль продолжается
+            // вправо или вниз
+            const Mask start = mask & -mask;
+            Mask ship = start;
+            for (Mask grown = Dilate(ship) & mask; grown != ship; grown = Dilate(ship) & mask) {
+                ship = grown;
+            }
+            const int length = std::popcount(ship);
+            if (length > ship_sizes[0] || remaining[length] == 0
+                || (ship != GetShipCells(start, length, true)
+                    && ship != GetShipCells(start, length, false))) {
+                return false;
+            }
+            --remaining[length];
+            mask &= ~ship;
+        }
+        return true;
+    }
+
+    // Создаёт поле, в котором корабли занимают клетки, соответствующие установленным битам
+    // маски. Клетке (x, y) соответствует бит x + y * field_size.
+    // Если расстановка недопустима, выбрасывает std::invalid_argument
+    static SeabattleField FromShipMask(uint64_t mask) {
+        if (!IsValidShipMask(mask)) {
+            throw std::invalid_argument("Invalid ship placement");
+        }
+        return FromMasks(mask, ~mask, State::SHIP, State::EMPTY);
+    }
+
+    // Возвращает маску клеток, занятых кораблями (в том числе подбитыми)
+    uint64_t GetShipMask() const {
+        return GetMask(State::SHIP) | GetMask(State::KILLED);
+    }
+
+    // Возвращает маску клеток, находящихся в состоянии state
+    uint64_t GetMask(State state) const {
+        return masks_[static_cast<size_t>(state)];
+    }
+
+    State operator()(size_t x, size_t y) const {
+        return Get(x, y);
+    }
+
+    bool IsKilled(size_t x, size_t y) const {
+        const Mask cell = CellMask(x, y);
+        return IsKilledLine(GetKilledLine(cell, true), true)
+            && IsKilledLine(GetKilledLine(cell, false), false);
+    }
+
+    static void PrintDigitLine(std::ostream& out) {
+        out << "  1 2 3 4 5 6 7 8  ";
+    }
+
+    void PrintLine(std::ostream& out, size_t y) const {
+        std::array<char, field_size * 2 - 1> line;
+        for (size_t x = 0; x < field_size; ++x) {
+            line[x * 2] = Repr((*this)(x, y));
+            if (x + 1 < field_size) {
+                line[x * 2 + 1] = ' ';
+            }
+        }
+
+        char line_char = static_cast<char>('A' + y);
+
+        out.put(line_char);
+        out.put(' ');
+        out.write(line.data(), line.size());
+        out.put(' ');
+        out.put(line_char);
+    }
+
+    bool IsLoser() const {
+        return std::popcount(GetMask(State::KILLED)) == ship_cells;
+    }
+
+private:
+    void Set(size_t x, size_t y, State state) {
+        const Mask cell = CellMask(x, y);
+        for (auto& mask : masks_) {
+            mask &= ~cell;
+        }
+        masks_[static_cast<size_t>(state)] |= cell;
+    }
+
+    State Get(size_t x, size_t y) const {
+        const Mask cell = CellMask(x, y);
+        for (size_t i = 0; i < masks_.size(); ++i) {
+            if (masks_[i] & cell) {
+                return static_cast<State>(i);
+            }
+        }
+        assert(false);
+        return State::UNKNOWN;
+    }
+
+    static char Repr(State state) {
+        switch (state) {
+            case State::UNKNOWN:
+                return '?';
+            case State::EMPTY:
+                return '.';
+            case State::SHIP:
+                return 'o';
+            case State::KILLED:
+                return 'x';
+        }
+
+        return '\0';
+    }
+
+private:
+    // Маски клеток в каждом из состояний, индекс соответствует значению State
+    std::array<Mask, 4> masks_{};
+};
@@ -0,0 +1,308 @@
+#include "seabattle_server.h"
+
+#include <boost/asio/dispatch.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/strand.hpp>
+#include <boost/asio/write.hpp>
+#include <iostream>
+
+namespace seabattle_server {
+
+using protocol::ErrorCode;
+using protocol::Message;
+using protocol::MessageType;
+
+Game::Game(std::shared_ptr<Session> first, SeabattleField first_field,
+           std::shared_ptr<Session> second, SeabattleField second_field, ServerStats& stats)
+    : players_{std::move(first), std::move(second)}
+    , fields_{std::move(first_field), std::move(second_field)}
+    , stats_{stats} {
+}
+
+void Game::Start() {
+    std::lock_guard lock{mutex_};
+    for (int player = 0; player < 2; ++player) {
+        if (auto session = players_[player].lock()) {
+            session->OnMatched(shared_from_this(), player, player == turn_);
+        }
+    }
+}
+
+void Game::Shoot(int player, std::uint8_t x, std::uint8_t y) {
+    std::lock_guard lock{mutex_};
+    if (finished_) {
+        // Сессия получит сообщение о завершении партии
+        return;
+    }
+    const auto shooter = players_[player].lock();
+    if (!shooter) {
+        return;
+    }
+    if (turn_ != player) {
+        shooter->Send(Message::Error(ErrorCode::NOT_YOUR_TURN));
+        return;
+    }
+    constexpr size_t field_size = SeabattleField::field_size;
+    if (x >= field_size || y >= field_size) {
+        shooter->Send(Message::Error(ErrorCode::INVALID_MOVE));
+        return;
+    }
+    const std::uint64_t cell = std::uint64_t{1} << (x + y * field_size);
+    if (shots_[player] & cell) {
+        shooter->Send(Message::Error(ErrorCode::INVALID_MOVE));
+        return;
+    }
+    shots_[player] |= cell;
+    stats_.moves.fetch_add(1, std::memory_order_relaxed);
+
+    const int opponent = 1 - player;
+    auto& opponent_field = fields_[opponent];
+    const auto result = opponent_field.Shoot(x, y);
+    const auto result_code = static_cast<std::uint8_t>(result);
+    shooter->Send(Message::ShotResult(x, y, result_code, false));
+    if (auto opponent_session = players_[opponent].lock()) {
+        opponent_session->Send(Message::ShotResult(x, y, result_code, true));
+    }
+
+    if (result == SeabattleField::ShotResult::MISS) {
+        turn_ = opponent;
+    } else if (opponent_field.IsLoser()) {
+        Finish(player);
+    }
+}
+
+void Game::Leave(int player) {
+    std::lock_guard lock{mutex_};
+    if (!finished_) {
+        Finish(1 - player);
+    }
+}
+
+void Game::Finish(int winner) {
+    finished_ = true;
+    stats_.games_finished.fetch_add(1, std::memory_order_relaxed);
+    for (int player = 0; player < 2; ++player) {
+        if (auto session = players_[player].lock()) {
+            session->OnGameOver(player == winner);
+        }
+    }
+}
+
+void Matchmaker::Join(const std::shared_ptr<Session>& session, SeabattleField field) {
+    std::shared_ptr<Game> game;
+    {
+        std::lock_guard lock{mutex_};
+        auto opponent = waiting_.lock();
+        if (!opponent || opponent == session) {
+            waiting_ = session;
+            waiting_field_ = std::move(field);
+            return;
+        }
+        waiting_.reset();
+        game = std::make_shared<Game>(std::move(opponent), std::move(waiting_field_), session,
+                                      std::move(field), stats_);
+    }
+    stats_.games_started.fetch_add(1, std::memory_order_relaxed);
+    game->Start();
+}
+
+void Matchmaker::Leave(const Session* session) {
+    std::lock_guard lock{mutex_};
+    if (waiting_.lock().get() == session) {
+        waiting_.reset();
+    }
+}
+
+Session::Session(tcp::socket socket, Matchmaker& matchmaker)
+    : socket_{std::move(socket)}
+    , matchmaker_{matchmaker} {
+}
+
+void Session::Start() {
+    // Сообщения короткие, поэтому алгоритм Нейгла лишь задерживал бы ответы
+    sys::error_code ec;
+    socket_.set_option(tcp::no_delay{true}, ec);
+    net::dispatch(socket_.get_executor(), [self = shared_from_this()] {
+        self->Read();
+    });
+}
+
+void Session::OnMatched(std::shared_ptr<Game> game, int player, bool my_turn) {
+    net::post(socket_.get_executor(),
+              [self = shared_from_this(), game = std::move(game), player, my_turn]() mutable {
+                  if (self->state_ == State::CLOSED) {
+                      game->Leave(player);
+                      return;
+                  }
+                  self->state_ = State::PLAYING;
+                  self->game_ = std::move(game);
+                  self->player_ = player;
+                  self->Enqueue(Message::Matched(my_turn));
+              });
+}
+
+void Session::OnGameOver(bool won) {
+    net::post(socket_.get_executor(), [self = shared_from_this(), won] {
+        if (self->state_ == State::CLOSED) {
+            return;
+        }
+        self->state_ = State::WAITING_JOIN;
+        self->game_.reset();
+        self->Enqueue(Message::GameOver(won));
+    });
+}
+
+void Session::Send(const Message& message) {
+    net::post(socket_.get_executor(), [self = shared_from_this(), message] {
+        self->Enqueue(message);
+    });
+}
+
+void Session::Read() {
+    const auto space = reader_.GetFreeSpace();
+    socket_.async_read_some(net::buffer(space.data(), space.size()),
+                            [self = shared_from_this()](sys::error_code ec, size_t bytes_read) {
+                                self->OnRead(ec, bytes_read);
+                            });
+}
+
+void Session::OnRead(sys::error_code ec, size_t bytes_read) {
+    if (ec) {
+        Close();
+        return;
+    }
+    reader_.Commit(bytes_read);
+    try {
+        while (state_ != State::CLOSED) {
+            const auto message = reader_.Next();
+            if (!message) {
+                break;
+            }
+            HandleMessage(*message);
+        }
+    } catch (const std::invalid_argument&) {
+        // Граница следующего сообщения неизвестна, поэтому продолжать чтение нельзя
+        Close();
+    }
+    if (state_ != State::CLOSED) {
+        Read();
+    }
+}
+
+void Session::HandleMessage(const Message& message) {
+    switch (message.GetType()) {
+        case MessageType::JOIN:
+            if (state_ != State::WAITING_JOIN) {
+                Enqueue(Message::Error(ErrorCode::BAD_MESSAGE));
+                return;
+            }
+            try {
+                auto field = SeabattleField::FromShipMask(message.GetShipMask());
+                state_ = State::WAITING_OPPONENT;
+                matchmaker_.Join(shared_from_this(), std::move(field));
+            } catch (const std::invalid_argument&) {
+                Enqueue(Message::Error(ErrorCode::INVALID_FIELD));
+            }
+            return;
+        case MessageType::SHOT:
+            if (state_ != State::PLAYING) {
+                Enqueue(Message::Error(ErrorCode::BAD_MESSAGE));
+                return;
+            }
+            game_->Shoot(player_, message.data[1], message.data[2]);
+            return;
+        default:
+            Enqueue(Message::Error(ErrorCode::BAD_MESSAGE));
+            return;
+    }
+}
+
+void Session::Enqueue(const Message& message) {
+    if (state_ == State::CLOSED) {
+        return;
+    }
+    const auto bytes = message.GetBytes();
+    if (write_queue_.size() + bytes.size() > MAX_WRITE_QUEUE_SIZE) {
+        Close();
+        return;
+    }
+    write_queue_.insert(write_queue_.end(), bytes.begin(), bytes.end());
+    if (!writing_) {
+        Write();
+    }
+}
+
+void Session::Write() {
+    // Все накопившиеся сообщения отправляются одной операцией записи
+    write_buffer_.swap(write_queue_);
+    writing_ = true;
+    net::async_write(socket_, net::buffer(write_buffer_),
+                     [self = shared_from_this()](sys::error_code ec, size_t bytes_written) {
+                         self->OnWrite(ec, bytes_written);
+                     });
+}
+
+void Session::OnWrite(sys::error_code ec, [[maybe_unused]] size_t bytes_written) {
+    writing_ = false;
+    write_buffer_.clear();
+    if (ec) {
+        Close();
+        return;
+    }
+    if (!write_queue_.empty() && state_ != State::CLOSED) {
+        Write();
+    }
+}
+
+void Session::Close() {
+    if (state_ == State::CLOSED) {
+        return;
+    }
+    if (state_ == State::WAITING_OPPONENT) {
+        matchmaker_.Leave(this);
+    }
+    state_ = State::CLOSED;
+    if (game_) {
+        game_->Leave(player_);
+        game_.reset();
+    }
+    sys::error_code ec;
+    socket_.shutdown(tcp::socket::shutdown_both, ec);
+    socket_.close(ec);
+}
+
+Listener::Listener(net::io_context& io, const tcp::endpoint& endpoint, Matchmaker& matchmaker)
+    : io_{io}
+    , acceptor_{net::make_strand(io)}
+    , matchmaker_{matchmaker} {
+    acceptor_.open(endpoint.protocol());
+    acceptor_.set_option(net::socket_base::reuse_address(true));
+    acceptor_.bind(endpoint);
+    acceptor_.listen(net::socket_base::max_listen_connections);
+}
+
+void Listener::Run() {
+    Accept();
+}
+
+void Listener::Accept() {
+    // Сокет каждой сессии связан с собственным strand
+    acceptor_.async_accept(net::make_strand(io_),
+                           [self = shared_from_this()](sys::error_code ec, tcp::socket socket) {
+                               self->OnAccept(ec, std::move(socket));
+                           });
+}
+
+void Listener::OnAccept(sys::error_code ec, tcp::socket socket) {
+    if (ec) {
+        if (ec == net::error::operation_aborted) {
+            return;
+        }
+        std::cerr << "Accept error: " << ec.message() << std::endl;
+    } else {
+        std::make_shared<Session>(std::move(socket), matchmaker_)->Start();
+    }
+    Accept();
+}
+
+}  // namespace seabattle_server
@@ -0,0 +1,164 @@
+#pragma once
+#ifdef WIN32
+#include <sdkddkver.h>
+#endif
+
+#include <array>
+#include <atomic>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "protocol.h"
+#include "seabattle.h"
+
+namespace seabattle_server {
+
+namespace net = boost::asio;
+namespace sys = boost::system;
+using net::ip::tcp;
+
+class Session;
+
+// Статистика сервера
+struct ServerStats {
+    std::atomic_uint64_t games_started{0};
+    std::atomic_uint64_t games_finished{0};
+    std::atomic_uint64_t moves{0};
+};
+
+/*
+Партия между двумя игроками. Хранит поля обоих игроков и очерёдность хода и проверяет
+допустимость ходов: игроки лишь сообщают координаты выстрела, а его результат вычисляет
+сервер. Методы класса вызываются из strand-ов обеих сессий, поэтому состояние партии
+защищено мьютексом.
+Партия хранит слабые ссылки на сессии, а сессии владеют партией, поэтому циклических
+ссылок не возникает: партия разрушается, когда обе сессии перестают в ней участвовать.
+*/
+class Game : public std::enable_shared_from_this<Game> {
+public:
+    Game(std::shared_ptr<Session> first, SeabattleField first_field,
+         std::shared_ptr<Session> second, SeabattleField second_field, ServerStats& stats);
+
+    // Оповещает игроков о начале партии. Первым ходит игрок 0
+    void Start();
+
+    // Выстрел игрока player в клетку (x, y) поля соперника
+    void Shoot(int player, std::uint8_t x, std::uint8_t y);
+
+    // Игрок player покинул партию. Если партия не завершена, победа присуждается сопернику
+    void Leave(int player);
+
+private:
+    void Finish(int winner);
+
+    std::mutex mutex_;
+    std::array<std::weak_ptr<Session>, 2> players_;
+    std::array<SeabattleField, 2> fields_;
+    // Клетки поля соперника, по которым игрок уже стрелял
+    std::array<std::uint64_t, 2> shots_{};
+    int turn_ = 0;
+    bool finished_ = false;
+    ServerStats& stats_;
+};
+
+/*
+Подбирает пары игроков. Клиент, приславший JOIN, ожидает, пока к серверу не подключится
+соперник, после чего для пары создаётся партия.
+*/
+class Matchmaker {
+public:
+    explicit Matchmaker(ServerStats& stats)
+        : stats_{stats} {
+    }
+
+    void Join(const std::shared_ptr<Session>& session, SeabattleField field);
+
+    // Убирает сессию из очереди ожидания соперника
+    void Leave(const Session* session);
+
+    ServerStats& GetStats() noexcept {
+        return stats_;
+    }
+
+private:
+    std::mutex mutex_;
+    std::weak_ptr<Session> waiting_;
+    SeabattleField waiting_field_;
+    ServerStats& stats_;
+};
+
+/*
+Соединение с клиентом. Сессия - конечный автомат:
+  WAITING_JOIN     -> (JOIN)          -> WAITING_OPPONENT
+  WAITING_OPPONENT -> (соперник найден) -> PLAYING
+  PLAYING          -> (конец партии)  -> WAITING_JOIN
+Сообщения, не допустимые в текущем состоянии, отклоняются сообщением ERROR.
+Все обработчики сессии выполняются в её strand.
+*/
+class Session : public std::enable_shared_from_this<Session> {
+public:
+    Session(tcp::socket socket, Matchmaker& matchmaker);
+
+    void Start();
+
+    // Методы ниже можно вызывать из любого потока
+
+    // Сессия стала участником партии game под номером player
+    void OnMatched(std::shared_ptr<Game> game, int player, bool my_turn);
+    // Партия завершилась
+    void OnGameOver(bool won);
+    // Отправляет сообщение клиенту
+    void Send(const protocol::Message& message);
+
+private:
+    enum class State {
+        WAITING_JOIN,
+        WAITING_OPPONENT,
+        PLAYING,
+        CLOSED,
+    };
+
+    void Read();
+    void OnRead(sys::error_code ec, size_t bytes_read);
+    void HandleMessage(const protocol::Message& message);
+    void Enqueue(const protocol::Message& message);
+    void Write();
+    void OnWrite(sys::error_code ec, size_t bytes_written);
+    void Close();
+
+    // Предел очереди отправки. Клиент, который не читает ответы, но продолжает присылать
+    // сообщения, иначе заставил бы сервер копить ответы без ограничения
+    static constexpr size_t MAX_WRITE_QUEUE_SIZE = 64 * 1024;
+
+    tcp::socket socket_;
+    Matchmaker& matchmaker_;
+    protocol::MessageReader reader_;
+    // Сообщения, ожидающие отправки, и сообщения, отправляемые в данный момент
+    std::vector<std::uint8_t> write_queue_;
+    std::vector<std::uint8_t> write_buffer_;
+    bool writing_ = false;
+    State state_ = State::WAITING_JOIN;
+    std::shared_ptr<Game> game_;
+    int player_ = 0;
+};
+
+// Принимает входящие соединения и создаёт для них сессии
+class Listener : public std::enable_shared_from_this<Listener> {
+public:
+    Listener(net::io_context& io, const tcp::endpoint& endpoint, Matchmaker& matchmaker);
+
+    void Run();
+
+private:
+    void Accept();
+    void OnAccept(sys::error_code ec, tcp::socket socket);
+
+    net::io_context& io_;
+    tcp::acceptor acceptor_;
+    Matchmaker& matchmaker_;
+};
+
+}  // namespace seabattle_server
@@ -0,0 +1,155 @@
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <string_view>
+
+#include "seabattle.h"
+#include "shot_selector.h"
+
+using namespace std::literals;
+
+namespace {
+
+unsigned ParseArg(int argc, const char* argv[], int index, unsigned default_value) {
+    if (argc <= index) {
+        return default_value;
+    }
+    const std::string_view arg = argv[index];
+    unsigned value = 0;
+    const auto [end, ec] = std::from_chars(arg.data(), arg.data() + arg.size(), value);
+    if (ec != std::errc{} || end != arg.data() + arg.size() || value == 0) {
+        throw std::invalid_argument("Invalid argument: "s + std::string(arg));
+    }
+    return value;
+}
+
+constexpr size_t CELL_COUNT = SeabattleField::field_size * SeabattleField::field_size;
+
+// Игрок, стреляющий по клеткам в случайном порядке
+class RandomPlayer {
+public:
+    template <typename RandomEngine>
+    void StartGame(RandomEngine& random_engine) {
+        std::iota(targets_.begin(), targets_.end(), 0);
+        std::shuffle(targets_.begin(), targets_.end(), random_engine);
+        next_target_ = 0;
+    }
+
+    template <typename RandomEngine>
+    std::pair<size_t, size_t> SelectShot(const SeabattleField& field, RandomEngine&) {
+        // Клетки, состояние которых уже известно, пропускаются
+        size_t cell = 0;
+        do {
+            cell = targets_[next_target_++];
+        } while (field(cell % SeabattleField::field_size, cell / SeabattleField::field_size)
+                 != SeabattleField::State::UNKNOWN);
+        return {cell % SeabattleField::field_size, cell / SeabattleField::field_size};
+    }
+
+private:
+    std::array<size_t, CELL_COUNT> targets_;
+    size_t next_target_ = 0;
+};
+
+// Игрок, выбирающий выстрелы по плотности вероятности
+class DensityPlayer {
+public:
+    explicit DensityPlayer(bool parallel)
+        : selector_{parallel} {
+    }
+
+    template <typename RandomEngine>
+    void StartGame(RandomEngine&) {
+    }
+
+    template <typename RandomEngine>
+    std::pair<size_t, size_t> SelectShot(const SeabattleField& field,
+                                         RandomEngine& random_engine) {
+        return selector_.SelectShot(field, random_engine);
+    }
+
+private:
+    ShotSelector selector_;
+};
+
+/*
+ * Проводит num_games партий игрока против самого себя на случайных полях и выводит
+ * количество партий в секунду и среднее число выстрелов победителя.
+ */
+template <typename Player>
+void RunBenchmark(std::string_view name, Player& player, unsigned num_games, unsigned seed) {
+    using ShotResult = SeabattleField::ShotResult;
+
+    std::mt19937 random_engine{seed};
+    std::uint64_t winner_shots = 0;
+
+    const auto start_time = std::chrono::steady_clock::now();
+    for (unsigned game = 0; game < num_games; ++game) {
+        std::array fields = {SeabattleField::GetRandomField(random_engine),
+                             SeabattleField::GetRandomField(random_engine)};
+        // Поля соперников в том виде, в каком их видят игроки
+        std::array<SeabattleField, 2> views;
+        std::array<Player, 2> players = {player, player};
+        std::array<unsigned, 2> shots{};
+        for (auto& p : players) {
+            p.StartGame(random_engine);
+        }
+
+        int turn = 0;
+        while (!fields[1 - turn].IsLoser()) {
+            auto& view = views[turn];
+            const auto [x, y] = players[turn].SelectShot(view, random_engine);
+            ++shots[turn];
+            switch (fields[1 - turn].Shoot(x, y)) {
+                case ShotResult::MISS:
+                    view.MarkMiss(x, y);
+                    turn = 1 - turn;
+                    break;
+                case ShotResult::HIT:
+                    view.MarkHit(x, y);
+                    break;
+                case ShotResult::KILL:
+                    view.MarkKill(x, y);
+                    break;
+            }
+        }
+        winner_shots += shots[turn];
+    }
+    const double seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+
+    std::cout << name << ": games: "sv << num_games << ", time: "sv << seconds
+              << "s, games/s: "sv << num_games / seconds << ", average shots to win: "sv
+              << static_cast<double>(winner_shots) / num_games << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, const char* argv[]) {
+    try {
+        // seabattle_selfplay_benchmark [<games> [<parallel games> [<seed>]]]
+        // Параллельный режим создаёт потоки на каждый выстрел, поэтому для него по умолчанию
+        // проводится меньше партий
+        const unsigned num_games = ParseArg(argc, argv, 1, 10'000);
+        const unsigned num_parallel_games = ParseArg(argc, argv, 2, 200);
+        const unsigned seed = ParseArg(argc, argv, 3, 42);
+
+        RandomPlayer random_player;
+        RunBenchmark("Random"sv, random_player, num_games, seed);
+
+        DensityPlayer density_player{false};
+        RunBenchmark("Density"sv, density_player, num_games, seed);
+
+        DensityPlayer parallel_density_player{true};
+        RunBenchmark("Density (parallel)"sv, parallel_density_player, num_parallel_games, seed);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+}
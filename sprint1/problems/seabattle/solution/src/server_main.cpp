@@ -0,0 +1,71 @@
+#ifdef WIN32
+#include <sdkddkver.h>
+#endif
+
+#include <boost/asio/signal_set.hpp>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "seabattle_server.h"
+
+namespace {
+
+using namespace seabattle_server;
+using namespace std::literals;
+
+// Запускает функцию fn на n потоках, включая текущий
+template <typename Fn>
+void RunWorkers(unsigned n, const Fn& fn) {
+    n = std::max(1u, n);
+    std::vector<std::jthread> workers;
+    workers.reserve(n - 1);
+    // Запускаем n-1 рабочих потоков, выполняющих функцию fn
+    while (--n) {
+        workers.emplace_back(fn);
+    }
+    fn();
+}
+
+}  // namespace
+
+int main(int argc, const char** argv) {
+    if (argc != 2 && argc != 3) {
+        std::cout << "Usage: seabattle_server <port> [<threads>]" << std::endl;
+        return 1;
+    }
+
+    try {
+        const auto port = static_cast<unsigned short>(std::stoi(argv[1]));
+        const unsigned num_threads = argc == 3 ? static_cast<unsigned>(std::stoi(argv[2]))
+                                               : std::thread::hardware_concurrency();
+
+        net::io_context io(static_cast<int>(std::max(1u, num_threads)));
+
+        // Сервер работает до получения сигнала SIGINT или SIGTERM
+        net::signal_set signals(io, SIGINT, SIGTERM);
+        signals.async_wait([&io](const sys::error_code& ec, [[maybe_unused]] int signal_number) {
+            if (!ec) {
+                io.stop();
+            }
+        });
+
+        ServerStats stats;
+        Matchmaker matchmaker{stats};
+        std::make_shared<Listener>(io, tcp::endpoint{net::ip::address_v4::any(), port}, matchmaker)
+            ->Run();
+
+        std::cout << "Seabattle server is listening on port "sv << port << std::endl;
+        RunWorkers(num_threads, [&io] {
+            io.run();
+        });
+
+        std::cout << "Games started: "sv << stats.games_started
+                  << ", games finished: "sv << stats.games_finished << ", moves: "sv
+                  << stats.moves << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,154 @@
+#include "shot_selector.h"
+
+#include <algorithm>
+#include <future>
+#include <vector>
+
+namespace {
+
+using Field = SeabattleField;
+using Mask = Field::Mask;
+using Density = ShotSelector::Density;
+
+// Наибольшая длина корабля
+constexpr int MAX_SHIP_LENGTH =
+    *std::max_element(Field::ship_sizes.begin(), Field::ship_sizes.end());
+
+// Количество ещё не убитых кораблей каждой длины
+using ShipCounts = std::array<int, MAX_SHIP_LENGTH + 1>;
+
+// Соседние по стороне клетки
+Mask GetSideNeighbors(Mask mask) {
+    return Field::ShiftRight(mask) | Field::ShiftLeft(mask) | Field::ShiftDown(mask)
+         | Field::ShiftUp(mask);
+}
+
+// Связная группа подбитых клеток killed, содержащая клетку cell
+Mask GetShip(Mask cell, Mask killed) {
+    Mask ship = cell;
+    while (true) {
+        const Mask next = ship | (GetSideNeighbors(ship) & killed);
+        if (next == ship) {
+            return ship;
+        }
+        ship = next;
+    }
+}
+
+// Описание поля соперника, необходимое для подсчёта плотности
+struct Situation {
+    Mask unknown = 0;
+    // Подбитые клетки не убитых кораблей
+    Mask hits = 0;
+    ShipCounts remaining{};
+};
+
+Situation AnalyzeField(const Field& field) {
+    Situation situation;
+    situation.unknown = field.GetMask(Field::State::UNKNOWN);
+    for (int length : Field::ship_sizes) {
+        ++situation.remaining[length];
+    }
+
+    Mask killed = field.GetMask(Field::State::KILLED);
+    while (killed) {
+        const Mask ship = GetShip(killed & -killed, killed);
+        killed &= ~ship;
+        if (GetSideNeighbors(ship) & situation.unknown) {
+            situation.hits |= ship;
+            continue;
+        }
+        const int length = std::popcount(ship);
+        if (length <= MAX_SHIP_LENGTH && situation.remaining[length] > 0) {
+            --situation.remaining[length];
+        }
+    }
+    return situation;
+}
+
+// Добавляет к density вклад положений кораблей длины length
+void AddShipDensity(const Situation& situation, int length, Density& density) {
+    const Mask allowed = situation.unknown | situation.hits;
+    const auto weight = static_cast<std::uint32_t>(situation.remaining[length]);
+
+    for (const bool horizontal : {true, false}) {
+        // Однопалубный корабль в обоих направлениях занимает одну и ту же клетку
+        if (!horizontal && length == 1) {
+            break;
+        }
+        Mask starts = Field::GetShipStarts(allowed, length, horizontal);
+        while (starts) {
+            const Mask start = starts & -starts;
+            starts &= starts - 1;
+
+            const Mask ship = Field::GetShipCells(start, length, horizontal);
+            // Корабль не может касаться подбитых клеток, не входящих в него
+            if (Field::Dilate(ship) & situation.hits & ~ship) {
+                continue;
+            }
+            if (situation.hits && !(ship & situation.hits)) {
+                continue;
+            }
+            for (Mask cells = ship & situation.unknown; cells; cells &= cells - 1) {
+                density[std::countr_zero(cells)] += weight;
+            }
+        }
+    }
+}
+
+}  // namespace
+
+ShotSelector::Density ShotSelector::ComputeDensity(const SeabattleField& field) const {
+    const Situation situation = AnalyzeField(field);
+
+    Density density{};
+    if (!parallel_) {
+        for (int length = 1; length <= MAX_SHIP_LENGTH; ++length) {
+            if (situation.remaining[length] > 0) {
+                AddShipDensity(situation, length, density);
+            }
+        }
+        return density;
+    }
+
+    std::vector<std::future<Density>> partial_densities;
+    for (int length = 1; length <= MAX_SHIP_LENGTH; ++length) {
+        if (situation.remaining[length] > 0) {
+            partial_densities.push_back(std::async(std::launch::async, [&situation, length] {
+                Density partial{};
+                AddShipDensity(situation, length, partial);
+                return partial;
+            }));
+        }
+    }
+    for (auto& partial_density : partial_densities) {
+        const Density partial = partial_density.get();
+        for (size_t i = 0; i < density.size(); ++i) {
+            density[i] += partial[i];
+        }
+    }
+    return density;
+}
+
+ShotSelector::Mask ShotSelector::GetBestCells(const SeabattleField& field,
+                                              const Density& density) {
+    const Mask unknown = field.GetMask(SeabattleField::State::UNKNOWN);
+    if (!unknown) {
+        throw std::logic_error("There are no cells to shoot at");
+    }
+
+    std::uint32_t max_density = 0;
+    Mask best = 0;
+    for (Mask cells = unknown; cells; cells &= cells - 1) {
+        const int cell = std::countr_zero(cells);
+        if (density[cell] > max_density) {
+            max_density = density[cell];
+            best = 0;
+        }
+        if (density[cell] == max_density) {
+            best |= Mask{1} << cell;
+        }
+    }
+    // Если ни одно положение кораблей не согласуется с полем, годится любая неизвестная клетка
+    return best;
+}
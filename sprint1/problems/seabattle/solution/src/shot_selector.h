@@ -0,0 +1,52 @@
+#pragma once
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <utility>
+
+#include "seabattle.h"
+
+/*
+Выбор клетки для выстрела по плотности вероятности.
+Для каждой неизвестной клетки поля соперника подсчитывается, сколько допустимых положений
+оставшихся кораблей через неё проходит, и выстрел делается в клетку с наибольшим значением.
+Положение допустимо, если корабль лежит на неизвестных или подбитых клетках и не касается
+подбитых клеток других кораблей. Пока на поле есть подбитые, но не убитые корабли,
+учитываются только положения, проходящие через подбитые клетки (режим добивания).
+Оставшиеся корабли определяются по полю: убитым считается связная группа подбитых клеток,
+не граничащая с неизвестными клетками, так как MarkKill помечает пустыми клетки вокруг неё.
+*/
+class ShotSelector {
+public:
+    using Mask = SeabattleField::Mask;
+    using Density =
+        std::array<std::uint32_t, SeabattleField::field_size * SeabattleField::field_size>;
+
+    // При parallel == true плотность для кораблей разной длины вычисляется в отдельных потоках
+    explicit ShotSelector(bool parallel = false)
+        : parallel_{parallel} {
+    }
+
+    // Вычисляет плотность вероятности для клеток поля соперника field.
+    // Для клеток, состояние которых известно, плотность равна нулю
+    Density ComputeDensity(const SeabattleField& field) const;
+
+    // Возвращает координаты клетки с наибольшей плотностью. Среди равных клеток выбирается
+    // случайная. Выбрасывает std::logic_error, если на поле не осталось неизвестных клеток
+    template <typename RandomEngine>
+    std::pair<size_t, size_t> SelectShot(const SeabattleField& field,
+                                         RandomEngine& random_engine) const {
+        const Mask best = GetBestCells(field, ComputeDensity(field));
+        std::uniform_int_distribution<int> index{0, std::popcount(best) - 1};
+        const auto cell = static_cast<size_t>(
+            std::countr_zero(SeabattleField::SelectBit(best, index(random_engine))));
+        return {cell % SeabattleField::field_size, cell / SeabattleField::field_size};
+    }
+
+private:
+    static Mask GetBestCells(const SeabattleField& field, const Density& density);
+
+    bool parallel_;
+};
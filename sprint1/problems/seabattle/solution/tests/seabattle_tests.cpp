@@ -0,0 +1,143 @@
+#define BOOST_TEST_MODULE seabattle tests
+#include <boost/test/unit_test.hpp>
+
+#include <array>
+#include <random>
+#include <stdexcept>
+#include <string_view>
+
+#include "../src/seabattle.h"
+
+using namespace std::literals;
+
+namespace {
+
+using Rows = std::array<std::string_view, SeabattleField::field_size>;
+
+// Строит маску кораблей по строкам поля, в которых X обозначает клетку корабля
+SeabattleField::Mask MakeMask(const Rows& rows) {
+    SeabattleField::Mask mask = 0;
+    for (size_t y = 0; y < rows.size(); ++y) {
+        for (size_t x = 0; x < rows[y].size(); ++x) {
+            if (rows[y][x] == 'X') {
+                mask |= SeabattleField::CellMask(x, y);
+            }
+        }
+    }
+    return mask;
+}
+
+// Допустимая расстановка: 4, 3, 3, 2, 2, 2, 1, 1, 1, 1
+constexpr Rows VALID_FLEET = {
+    "XXXX.X.X"sv,
+    "........"sv,
+    "XXX.XXX."sv,
+    "........"sv,
+    "XX.XX.XX"sv,
+    "........"sv,
+    "X.X....."sv,
+    "........"sv,
+};
+
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(ShipMask_accepts_valid_fleet) {
+    BOOST_TEST(SeabattleField::IsValidShipMask(MakeMask(VALID_FLEET)));
+
+    // Вертикальные корабли и корабли у краёв поля
+    BOOST_TEST(SeabattleField::IsValidShipMask(MakeMask({
+        "X.X.X..X"sv,
+        "X.X.X..."sv,
+        "X.X....X"sv,
+        "X......X"sv,
+        "...X...X"sv,
+        "X..X...."sv,
+        "X......X"sv,
+        "..X.X..."sv,
+    })));
+}
+
+BOOST_AUTO_TEST_CASE(ShipMask_accepts_random_fields) {
+    std::mt19937 random_engine{42};
+    for (int i = 0; i < 1000; ++i) {
+        const auto mask = SeabattleField::GetRandomField(random_engine).GetShipMask();
+        BOOST_TEST(SeabattleField::IsValidShipMask(mask));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(ShipMask_rejects_touching_ships) {
+    // Однопалубные корабли касаются сторонами и сливаются в двухпалубный
+    BOOST_TEST(!SeabattleField::IsValidShipMask(MakeMask({
+        "XXXX.X.X"sv,
+        "........"sv,
+        "XXX.XXX."sv,
+        "........"sv,
+        "XX.XX.XX"sv,
+        "........"sv,
+        "XX......"sv,
+        "........"sv,
+    })));
+    // Однопалубные корабли касаются углами
+    BOOST_TEST(!SeabattleField::IsValidShipMask(MakeMask({
+        "XXXX.X.X"sv,
+        "........"sv,
+        "XXX.XXX."sv,
+        "........"sv,
+        "XX.XX.XX"sv,
+        "........"sv,
+        "X......."sv,
+        ".X......"sv,
+    })));
+    // Параллельные корабли касаются сторонами
+    BOOST_TEST(!SeabattleField::IsValidShipMask(MakeMask({
+        "XXXX.X.X"sv,
+        "........"sv,
+        "XXX....."sv,
+        "XXX....."sv,
+        "XX.XX.XX"sv,
+        "........"sv,
+        "X.X....."sv,
+        "........"sv,
+    })));
+}
+
+BOOST_AUTO_TEST_CASE(ShipMask_rejects_bent_ships) {
+    // Четырёхпалубный корабль в форме буквы L
+    BOOST_TEST(!SeabattleField::IsValidShipMask(MakeMask({
+        "XXX..X.X"sv,
+        "..X....."sv,
+        "........"sv,
+        "XXX.XXX."sv,
+        "........"sv,
+        "XX.XX.XX"sv,
+        "........"sv,
+        "X.X....."sv,
+    })));
+}
+
+BOOST_AUTO_TEST_CASE(ShipMask_rejects_wrong_fleet) {
+    // 20 клеток одним сплошным блоком
+    BOOST_TEST(!SeabattleField::IsValidShipMask((SeabattleField::Mask{1} << 20) - 1));
+    // Пять четырёхпалубных кораблей вместо положенного набора
+    BOOST_TEST(!SeabattleField::IsValidShipMask(MakeMask({
+        "XXXX...X"sv,
+        ".......X"sv,
+        "XXXX...X"sv,
+        ".......X"sv,
+        "XXXX...."sv,
+        "........"sv,
+        "XXXX...."sv,
+        "........"sv,
+    })));
+    // Слишком мало клеток
+    BOOST_TEST(!SeabattleField::IsValidShipMask(MakeMask(VALID_FLEET) & ~1));
+}
+
+BOOST_AUTO_TEST_CASE(FromShipMask_throws_on_invalid_placement) {
+    BOOST_CHECK_THROW(SeabattleField::FromShipMask((SeabattleField::Mask{1} << 20) - 1),
+                      std::invalid_argument);
+
+    const auto mask = MakeMask(VALID_FLEET);
+    const auto field = SeabattleField::FromShipMask(mask);
+    BOOST_TEST(field.GetShipMask() == mask);
+}
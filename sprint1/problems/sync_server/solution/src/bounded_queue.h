@@ -0,0 +1,98 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+
+/*
+Очередь ограниченной ёмкости с несколькими производителями и потребителями.
+Push блокирует производителя, пока в очереди нет места, TryPush в этом случае сразу
+возвращает false. Pop блокирует потребителя, пока очередь пуста. После вызова Close новые
+элементы не принимаются, а Pop возвращает оставшиеся элементы и затем nullopt.
+*/
+template <typename T>
+class BoundedQueue {
+public:
+    explicit BoundedQueue(size_t capacity)
+        : capacity_{capacity} {
+        if (capacity == 0) {
+            throw std::invalid_argument("Queue capacity must be positive");
+        }
+    }
+
+    BoundedQueue(const BoundedQueue&) = delete;
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+    // Добавляет элемент, дожидаясь свободного места. Возвращает false, если очередь закрыта
+    bool Push(T& item) {
+        std::unique_lock lock{mutex_};
+        not_full_.wait(lock, [this] {
+            return closed_ || items_.size() < capacity_;
+        });
+        return PushLocked(lock, item);
+    }
+
+    // Добавляет элемент, если в очереди есть место. При неудаче item не изменяется
+    bool TryPush(T& item) {
+        std::unique_lock lock{mutex_};
+        if (items_.size() >= capacity_) {
+            return false;
+        }
+        return PushLocked(lock, item);
+    }
+
+    // Извлекает элемент, дожидаясь его появления. Возвращает nullopt, если очередь закрыта
+    // и пуста
+    std::optional<T> Pop() {
+        std::unique_lock lock{mutex_};
+        not_empty_.wait(lock, [this] {
+            return closed_ || !items_.empty();
+        });
+        if (items_.empty()) {
+            return std::nullopt;
+        }
+        std::optional<T> item{std::move(items_.front())};
+        items_.pop_front();
+        lock.unlock();
+        not_full_.notify_one();
+        return item;
+    }
+
+    void Close() {
+        {
+            std::lock_guard lock{mutex_};
+            closed_ = true;
+        }
+        not_full_.notify_all();
+        not_empty_.notify_all();
+    }
+
+    size_t GetSize() const {
+        std::lock_guard lock{mutex_};
+        return items_.size();
+    }
+
+    size_t GetCapacity() const noexcept {
+        return capacity_;
+    }
+
+private:
+    bool PushLocked(std::unique_lock<std::mutex>& lock, T& item) {
+        if (closed_) {
+            return false;
+        }
+        items_.push_back(std::move(item));
+        lock.unlock();
+        not_empty_.notify_one();
+        return true;
+    }
+
+    mutable std::mutex mutex_;
+    std::condition_variable not_full_;
+    std::condition_variable not_empty_;
+    std::deque<T> items_;
+    const size_t capacity_;
+    bool closed_ = false;
+};
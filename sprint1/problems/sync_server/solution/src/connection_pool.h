@@ -0,0 +1,81 @@
+#pragma once
+
+#include <boost/asio/ip/tcp.hpp>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "bounded_queue.h"
+
+// Поведение пула, когда все рабочие потоки заняты, а очередь соединений заполнена
+enum class OverflowPolicy {
+    // Поток, принимающий соединения, ждёт освобождения места в очереди.
+    // Новые соединения тем временем накапливаются в очереди ожидания ядра
+    BLOCK,
+    // Соединение не ставится в очередь, и его обработку берёт на себя вызывающий
+    REJECT,
+};
+
+/*
+Пул потоков для обслуживания TCP-соединений.
+Поток, принимающий соединения, помещает сокеты в ограниченную очередь, а фиксированное число
+рабочих потоков извлекает их и синхронно обслуживает функцией handler. Рабочий поток занят
+соединением до его закрытия, поэтому одновременно обслуживается не более num_workers
+соединений. Деструктор дожидается обслуживания всех соединений из очереди.
+*/
+template <typename ConnectionHandler>
+class ConnectionPool {
+public:
+    using Socket = boost::asio::ip::tcp::socket;
+
+    ConnectionPool(unsigned num_workers, size_t queue_capacity, OverflowPolicy policy,
+                   ConnectionHandler handler)
+        : queue_{queue_capacity}
+        , policy_{policy}
+        , handler_{std::move(handler)} {
+        if (num_workers == 0) {
+            throw std::invalid_argument("Connection pool needs at least one worker");
+        }
+        workers_.reserve(num_workers);
+        for (unsigned i = 0; i < num_workers; ++i) {
+            workers_.emplace_back([this] {
+                Work();
+            });
+        }
+    }
+
+    ConnectionPool(const ConnectionPool&) = delete;
+    ConnectionPool& operator=(const ConnectionPool&) = delete;
+
+    ~ConnectionPool() {
+        queue_.Close();
+    }
+
+    // Передаёт соединение пулу. Возвращает false, если при политике REJECT очередь заполнена.
+    // В этом случае сокет остаётся у вызывающего
+    bool Submit(Socket& socket) {
+        if (policy_ == OverflowPolicy::REJECT) {
+            return queue_.TryPush(socket);
+        }
+        return queue_.Push(socket);
+    }
+
+    // Количество соединений, ожидающих свободного рабочего потока
+    size_t GetQueueSize() const {
+        return queue_.GetSize();
+    }
+
+private:
+    void Work() {
+        while (auto socket = queue_.Pop()) {
+            handler_(*socket);
+        }
+    }
+
+    BoundedQueue<Socket> queue_;
+    const OverflowPolicy policy_;
+    ConnectionHandler handler_;
+    // Потоки объявлены последними, чтобы запускаться после инициализации очереди
+    // и завершаться до её разрушения
+    std::vector<std::jthread> workers_;
+};
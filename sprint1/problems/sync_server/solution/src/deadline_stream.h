@@ -0,0 +1,105 @@
+#pragma once
+
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/beast/core/error.hpp>
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#else
+#include <poll.h>
+#endif
+
+/*
+Поток для синхронного чтения через http::read с ограничением времени.
+Опция SO_RCVTIMEO здесь не помогает: получив от recv ошибку EAGAIN, синхронные операции asio
+снова ждут готовности сокета, уже без ограничения времени. Поэтому перед каждым чтением
+DeadlineReadStream сам ждёт данных через poll, но не дольше, чем осталось до срока.
+По истечении срока чтение завершается ошибкой beast::error::timeout.
+*/
+class DeadlineReadStream {
+public:
+    using Socket = boost::asio::ip::tcp::socket;
+    using Clock = std::chrono::steady_clock;
+
+    explicit DeadlineReadStream(Socket& socket) noexcept
+        : socket_{socket} {
+    }
+
+    // Устанавливает срок, к которому должно завершиться чтение
+    void ExpiresAfter(Clock::duration timeout) {
+        deadline_ = Clock::now() + timeout;
+    }
+
+    // Снимает ограничение времени
+    void ExpiresNever() noexcept {
+        deadline_ = Clock::time_point::max();
+    }
+
+    template <typename MutableBufferSequence>
+    size_t read_some(const MutableBufferSequence& buffers, boost::beast::error_code& ec) {
+        if (!WaitReadable(ec)) {
+            return 0;
+        }
+        return socket_.read_some(buffers, ec);
+    }
+
+    template <typename MutableBufferSequence>
+    size_t read_some(const MutableBufferSequence& buffers) {
+        boost::beast::error_code ec;
+        const size_t size = read_some(buffers, ec);
+        if (ec) {
+            throw boost::beast::system_error{ec};
+        }
+        return size;
+    }
+
+private:
+    static constexpr int MAX_POLL_TIMEOUT_MS = 60'000;
+
+    // Ждёт, пока в сокете появятся данные. Возвращает false, если истёк срок или
+    // произошла ошибка
+    bool WaitReadable(boost::beast::error_code& ec) {
+        if (deadline_ == Clock::time_point::max()) {
+            return true;
+        }
+        while (true) {
+            const auto remaining = std::chrono::ceil<std::chrono::milliseconds>(
+                deadline_ - Clock::now());
+            if (remaining.count() <= 0) {
+                ec = boost::beast::error::timeout;
+                return false;
+            }
+            // Длинные сроки ждём частями, чтобы время ожидания поместилось в int
+            const int timeout_ms = static_cast<int>(std::min<std::chrono::milliseconds::rep>(
+                remaining.count(), MAX_POLL_TIMEOUT_MS));
+            pollfd fd{};
+            fd.fd = socket_.native_handle();
+            fd.events = POLLIN;
+#ifdef _WIN32
+            const int ready = ::WSAPoll(&fd, 1, timeout_ms);
+            if (ready < 0) {
+                ec.assign(::WSAGetLastError(), boost::system::system_category());
+                return false;
+            }
+#else
+            const int ready = ::poll(&fd, 1, timeout_ms);
+            if (ready < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                ec.assign(errno, boost::system::system_category());
+                return false;
+            }
+#endif
+            if (ready > 0) {
+                return true;
+            }
+        }
+    }
+
+    Socket& socket_;
+    Clock::time_point deadline_ = Clock::time_point::max();
+};
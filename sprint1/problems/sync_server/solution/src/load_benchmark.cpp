@@ -0,0 +1,180 @@
+#ifdef WIN32
+#include <sdkddkver.h>
+#endif
+// boost.beast будет использовать std::string_view вместо boost::string_view
+#define BOOST_BEAST_USE_STD_STRING_VIEW
+
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/beast/core.hpp>
+#include <boost/beast/http.hpp>
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace net = boost::asio;
+using tcp = net::ip::tcp;
+using namespace std::literals;
+namespace beast = boost::beast;
+namespace http = beast::http;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+unsigned ParseArg(int argc, const char* argv[], int index, unsigned default_value) {
+    if (argc <= index) {
+        return default_value;
+    }
+    const std::string_view arg = argv[index];
+    unsigned value = 0;
+    const auto [end, ec] = std::from_chars(arg.data(), arg.data() + arg.size(), value);
+    if (ec != std::errc{} || end != arg.data() + arg.size()) {
+        throw std::invalid_argument("Invalid argument: "s + std::string(arg));
+    }
+    return value;
+}
+
+// Результаты одного клиента
+struct ClientStats {
+    std::uint64_t ok = 0;
+    // Ответы 503 Service Unavailable, которыми сервер отклоняет соединения при переполнении
+    std::uint64_t rejected = 0;
+    // Ошибки соединения и ответы с неожиданным статусом
+    std::uint64_t errors = 0;
+    // Время выполнения успешных запросов в микросекундах
+    std::vector<std::uint32_t> latencies;
+};
+
+/*
+Клиент, синхронно отправляющий запросы GET до истечения deadline. При keep_alive все запросы
+идут через одно соединение, иначе для каждого запроса открывается новое соединение, что
+нагружает приём соединений сервером.
+*/
+void RunClient(const tcp::endpoint& endpoint, bool keep_alive, Clock::time_point deadline,
+               ClientStats& stats) {
+    net::io_context io;
+    tcp::socket socket{io};
+    beast::flat_buffer buffer;
+    http::request<http::empty_body> request{http::verb::get, "/benchmark"sv, 11};
+    request.set(http::field::host, "localhost"sv);
+    request.keep_alive(keep_alive);
+
+    while (Clock::now() < deadline) {
+        const auto start = Clock::now();
+        beast::error_code ec;
+        if (!socket.is_open()) {
+            socket.connect(endpoint, ec);
+            if (ec) {
+                ++stats.errors;
+                socket.close(ec);
+                continue;
+            }
+            buffer.clear();
+        }
+
+        http::response<http::string_body> response;
+        http::write(socket, request, ec);
+        if (!ec) {
+            http::read(socket, buffer, response, ec);
+        }
+        if (ec) {
+            ++stats.errors;
+            socket.close(ec);
+            continue;
+        }
+
+        if (response.result() == http::status::ok) {
+            ++stats.ok;
+            stats.latencies.push_back(static_cast<std::uint32_t>(
+                std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start)
+                    .count()));
+        } else if (response.result() == http::status::service_unavailable) {
+            ++stats.rejected;
+        } else {
+            ++stats.errors;
+        }
+        if (!keep_alive || response.need_eof()) {
+            socket.shutdown(tcp::socket::shutdown_both, ec);
+            socket.close(ec);
+        }
+    }
+}
+
+double GetPercentile(const std::vector<std::uint32_t>& sorted, double percentile) {
+    if (sorted.empty()) {
+        return 0;
+    }
+    const auto index = static_cast<size_t>(percentile / 100 * (sorted.size() - 1));
+    return sorted[index] / 1000.0;
+}
+
+}  // namespace
+
+/*
+Нагрузочный тест HTTP-сервера. Одинаково применим к синхронному серверу в режимах пула потоков
+и потока на соединение, а также к асинхронному серверу async_server, что позволяет сравнить
+их на одном оборудовании. Сервер запускается отдельно, например:
+  hello --quiet --mode=pool --workers=32 --queue=128 --overflow=reject
+  hello --quiet --mode=thread
+  hello_async
+*/
+int main(int argc, const char* argv[]) {
+    if (argc < 3) {
+        std::cout << "Usage: hello_load_benchmark <ip> <port> [<connections> [<seconds> "sv
+                     "[<keep alive: 0|1>]]]"sv
+                  << std::endl;
+        return EXIT_FAILURE;
+    }
+    try {
+        const tcp::endpoint endpoint{net::ip::make_address(argv[1]),
+                                     static_cast<unsigned short>(ParseArg(argc, argv, 2, 0))};
+        const unsigned connections = ParseArg(argc, argv, 3, 64);
+        const unsigned seconds = ParseArg(argc, argv, 4, 5);
+        const bool keep_alive = ParseArg(argc, argv, 5, 1) != 0;
+        if (connections == 0 || seconds == 0) {
+            throw std::invalid_argument("Number of connections and duration must be positive");
+        }
+
+        std::vector<ClientStats> stats(connections);
+        const auto start = Clock::now();
+        const auto deadline = start + std::chrono::seconds{seconds};
+        {
+            std::vector<std::jthread> clients;
+            clients.reserve(connections);
+            for (auto& client_stats : stats) {
+                clients.emplace_back([&endpoint, keep_alive, deadline, &client_stats] {
+                    RunClient(endpoint, keep_alive, deadline, client_stats);
+                });
+            }
+        }
+        const double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+        ClientStats total;
+        for (auto& client_stats : stats) {
+            total.ok += client_stats.ok;
+            total.rejected += client_stats.rejected;
+            total.errors += client_stats.errors;
+            total.latencies.insert(total.latencies.end(), client_stats.latencies.begin(),
+                                   client_stats.latencies.end());
+        }
+        std::sort(total.latencies.begin(), total.latencies.end());
+
+        std::cout << "Connections: "sv << connections << (keep_alive ? " (keep-alive)"sv : ""sv)
+                  << ", duration: "sv << elapsed << " s"sv << std::endl;
+        std::cout << "Requests: "sv << total.ok << " ok, "sv << total.rejected << " rejected, "sv
+                  << total.errors << " errors, "sv << total.ok / elapsed << " requests/s"sv
+                  << std::endl;
+        std::cout << "Latency: p50 "sv << GetPercentile(total.latencies, 50) << " ms, p99 "sv
+                  << GetPercentile(total.latencies, 99) << " ms, max "sv
+                  << GetPercentile(total.latencies, 100) << " ms"sv << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+}
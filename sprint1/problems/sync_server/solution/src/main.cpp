@@ -8,11 +8,17 @@
 #include <boost/beast/core.hpp>
 #include <boost/beast/http.hpp>
 #include <boost/asio/write.hpp>
+#include <array>
+#include <charconv>
+#include <chrono>
 #include <iostream>
 #include <thread>
 #include <optional>
 #include <string_view>
 
+#include "connection_pool.h"
+#include "deadline_stream.h"
+
 namespace net = boost::asio;
 using tcp = net::ip::tcp;
 using namespace std::literals;
@@ -24,12 +30,12 @@ using StringRequest = http::request<http::string_body>;
 // Ответ, тело которого представлено в виде строки
 using StringResponse = http::response<http::string_body>;
 
-std::optional<StringRequest> ReadRequest(tcp::socket& socket, beast::flat_buffer& buffer) {
+std::optional<StringRequest> ReadRequest(DeadlineReadStream& stream, beast::flat_buffer& buffer) {
     beast::error_code ec;
     StringRequest req;
-    // Считываем из socket запрос req, используя buffer для хранения данных.
+    // Считываем из stream запрос req, используя buffer для хранения данных.
     // В ec функция запишет код ошибки.
-    http::read(socket, buffer, req, ec);
+    http::read(stream, buffer, req, ec);
 
     if (ec == http::error::end_of_stream) {
         return std::nullopt;
@@ -117,15 +123,30 @@ StringResponse HandleRequest(StringRequest&& req) {
 }
 // --------------------------------------------------
 
+// Обслуживает соединение. Если клиент не присылает запрос целиком за read_timeout,
+// соединение закрывается. Нулевой read_timeout снимает ограничение
 template <typename RequestHandler>
-void HandleConnection(tcp::socket& socket, RequestHandler&& handle_request) {
+void HandleConnection(tcp::socket& socket, RequestHandler&& handle_request, bool dump_requests,
+                      std::chrono::seconds read_timeout) {
     try {
         // Буфер для чтения данных в рамках текущей сессии.
         beast::flat_buffer buffer;
+        DeadlineReadStream stream{socket};
 
         // Продолжаем обработку запросов, пока клиент их отправляет
-        while (auto request = ReadRequest(socket, buffer)) {
-            DumpRequest(*request);
+        while (true) {
+            // Срок отсчитывается заново для каждого запроса, поэтому он ограничивает и время
+            // простоя соединения между запросами
+            if (read_timeout.count() > 0) {
+                stream.ExpiresAfter(read_timeout);
+            }
+            auto request = ReadRequest(stream, buffer);
+            if (!request) {
+                break;
+            }
+            if (dump_requests) {
+                DumpRequest(*request);
+            }
             // Делегируем обработку запроса функции handle_request
             StringResponse response = handle_request(*std::move(request));
             http::write(socket, response);
@@ -142,17 +163,143 @@ void HandleConnection(tcp::socket& socket, RequestHandler&& handle_request) {
     socket.shutdown(tcp::socket::shutdown_send, ec);
 }
 
-int main() {
+// Отвечает клиенту, для которого не нашлось места в очереди соединений, и закрывает соединение.
+// Соединения отклоняет поток, принимающий соединения, поэтому функция не ждёт клиента: иначе
+// при перегрузке медленные клиенты ограничили бы скорость приёма новых соединений
+void RejectConnection(tcp::socket& socket) {
+    constexpr std::string_view body = "Server is overloaded"sv;
+    StringResponse response = MakeStringResponse(http::status::service_unavailable, body, 11,
+                                                 false);
+    response.set(http::field::retry_after, "1"sv);
+    beast::error_code ec;
+    http::write(socket, response, ec);
+    socket.shutdown(tcp::socket::shutdown_send, ec);
+
+    // Если закрыть сокет с непрочитанным запросом, ядро отправит клиенту RST, и клиент может
+    // потерять ещё не прочитанный ответ. Поэтому отбрасываем уже полученные данные, не
+    // дожидаясь новых. Ответ, записанный в буфер отправки, ядро доставит и после закрытия
+    socket.non_blocking(true, ec);
+    std::array<char, 4096> discard;
+    while (!ec) {
+        socket.read_some(net::buffer(discard), ec);
+    }
+    socket.close(ec);
+}
+
+// Способ обслуживания соединений
+enum class ServeMode {
+    // Соединения обслуживает пул потоков с ограниченной очередью
+    POOL,
+    // Каждое соединение обслуживается в отдельном потоке
+    THREAD_PER_CONNECTION,
+};
+
+// Параметры сервера, заданные в командной строке
+struct Args {
+    unsigned short port = 8080;
+    // Пул обслуживает не более num_workers соединений одновременно, поэтому по умолчанию,
+    // как и прежде, каждому соединению выделяется свой поток
+    ServeMode mode = ServeMode::THREAD_PER_CONNECTION;
+    unsigned num_workers = std::max(1u, std::thread::hardware_concurrency()) * 8;
+    size_t queue_capacity = 128;
+    OverflowPolicy overflow = OverflowPolicy::BLOCK;
+    bool dump_requests = true;
+    // Время на получение запроса, включая простой соединения перед ним. 0 - без ограничения
+    std::chrono::seconds read_timeout{30};
+};
+
+template <typename T>
+T ParseNumber(std::string_view value) {
+    T result{};
+    const auto [end, ec] = std::from_chars(value.data(), value.data() + value.size(), result);
+    if (ec != std::errc{} || end != value.data() + value.size()) {
+        throw std::invalid_argument("Invalid number: "s + std::string(value));
+    }
+    return result;
+}
+
+// Разбирает параметры вида --name=value. Без параметров сервер ведёт себя как прежде,
+// но закрывает соединения, по которым запрос не приходит дольше read_timeout
+Args ParseArgs(int argc, const char* const argv[]) {
+    constexpr auto PORT = "--port="sv;
+    constexpr auto WORKERS = "--workers="sv;
+    constexpr auto QUEUE = "--queue="sv;
+    constexpr auto QUIET = "--quiet"sv;
+    constexpr auto READ_TIMEOUT = "--read-timeout="sv;
+
+    Args args;
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        if (arg.starts_with(PORT)) {
+            args.port = ParseNumber<unsigned short>(arg.substr(PORT.size()));
+        } else if (arg == "--mode=pool"sv) {
+            args.mode = ServeMode::POOL;
+        } else if (arg == "--mode=thread"sv) {
+            args.mode = ServeMode::THREAD_PER_CONNECTION;
+        } else if (arg.starts_with(WORKERS)) {
+            args.num_workers = ParseNumber<unsigned>(arg.substr(WORKERS.size()));
+        } else if (arg.starts_with(QUEUE)) {
+            args.queue_capacity = ParseNumber<size_t>(arg.substr(QUEUE.size()));
+        } else if (arg == "--overflow=block"sv) {
+            args.overflow = OverflowPolicy::BLOCK;
+        } else if (arg == "--overflow=reject"sv) {
+            args.overflow = OverflowPolicy::REJECT;
+        } else if (arg.starts_with(READ_TIMEOUT)) {
+            args.read_timeout = std::chrono::seconds{
+                ParseNumber<unsigned>(arg.substr(READ_TIMEOUT.size()))};
+        } else if (arg == QUIET) {
+            args.dump_requests = false;
+        } else {
+            throw std::invalid_argument("Unknown argument: "s + std::string(arg));
+        }
+    }
+    if (args.num_workers == 0 || args.queue_capacity == 0) {
+        throw std::invalid_argument("Number of workers and queue capacity must be positive");
+    }
+    return args;
+}
+
+int main(int argc, const char* argv[]) {
+    Args args;
+    try {
+        args = ParseArgs(argc, argv);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        std::cerr << "Usage: hello [--port=<port>] [--mode=pool|thread] [--workers=<count>] "sv
+                     "[--queue=<capacity>] [--overflow=block|reject] "sv
+                     "[--read-timeout=<seconds>] [--quiet]"sv
+                  << std::endl;
+        return EXIT_FAILURE;
+    }
+
     net::io_context ioc;
 
     const auto address = net::ip::make_address("0.0.0.0");
-    constexpr unsigned short port = 8080;
+    const unsigned short port = args.port;
 
     tcp::acceptor acceptor(ioc, { address, port });
 
+    const bool dump_requests = args.dump_requests;
+    const auto read_timeout = args.read_timeout;
+    auto handle_connection = [dump_requests, read_timeout](tcp::socket& socket) {
+        HandleConnection(socket, HandleRequest, dump_requests, read_timeout);
+    };
+
     // Сообщаем тестам, что сервер готов принимать соединения
     std::cout << "Server has started..." << std::endl;
 
+    if (args.mode == ServeMode::POOL) {
+        ConnectionPool pool{args.num_workers, args.queue_capacity, args.overflow,
+                            handle_connection};
+        while (true) {
+            tcp::socket socket(ioc);
+            acceptor.accept(socket);
+            if (!pool.Submit(socket)) {
+                RejectConnection(socket);
+            }
+        }
+    }
+
     while (true) {
         tcp::socket socket(ioc);
         acceptor.accept(socket);
@@ -160,12 +307,12 @@ int main() {
         // Запускаем обработку взаимодействия с клиентом в отдельном потоке
         std::thread t(
             // Лямбда-функция будет выполняться в отдельном потоке
-            [](tcp::socket socket) {
-                HandleConnection(socket, HandleRequest);
+            [handle_connection](tcp::socket socket) {
+                handle_connection(socket);
             },
             std::move(socket));  // Сокет нельзя скопировать, но можно переместить
 
         // После вызова detach поток продолжит выполняться независимо от объекта t
         t.detach();
     }
-}
\ No newline at end of file
+}
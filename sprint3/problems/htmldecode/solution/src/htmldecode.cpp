@@ -0,0 +1,161 @@
+#include "htmldecode.h"
+
+#include <cstring>
+
+namespace {
+
+using namespace std::literals;
+
+struct Entity {
+    std::string_view name;  // Имя мнемоники без символа &
+    char value;             // Символ, в который декодируется мнемоника
+};
+
+constexpr std::array ENTITIES = {
+    Entity{"lt"sv, '<'},   Entity{"gt"sv, '>'},   Entity{"amp"sv, '&'},
+    Entity{"apos"sv, '\''}, Entity{"quot"sv, '"'}, Entity{"LT"sv, '<'},
+    Entity{"GT"sv, '>'},   Entity{"AMP"sv, '&'},  Entity{"APOS"sv, '\''},
+    Entity{"QUOT"sv, '"'},
+};
+
+constexpr size_t CountDfaStates() {
+    size_t count = 1;
+    for (const auto& entity : ENTITIES) {
+        count += entity.name.size();
+    }
+    return count;
+}
+
+constexpr std::uint8_t ROOT_STATE = 0;
+constexpr std::uint8_t DEAD_STATE = 0xFF;
+constexpr size_t MAX_DFA_STATES = CountDfaStates();
+static_assert(MAX_DFA_STATES < DEAD_STATE);
+
+/*
+ * Детерминированный автомат (бор), распознающий имена мнемоник.
+ * Состояние ROOT_STATE соответствует позиции сразу после символа &.
+ * Принимающие состояния имеют ненулевое значение output.
+ */
+struct Dfa {
+    std::array<std::array<std::uint8_t, 256>, MAX_DFA_STATES> next{};
+    std::array<char, MAX_DFA_STATES> output{};
+    size_t num_states = 1;
+
+    constexpr std::uint8_t Next(std::uint8_t state, char c) const {
+        return next[state][static_cast<unsigned char>(c)];
+    }
+};
+
+constexpr Dfa BuildDfa() {
+    Dfa dfa;
+    for (auto& row : dfa.next) {
+        row.fill(DEAD_STATE);
+    }
+    for (const auto& entity : ENTITIES) {
+        std::uint8_t state = ROOT_STATE;
+        for (char c : entity.name) {
+            auto& next_state = dfa.next[state][static_cast<unsigned char>(c)];
+            if (next_state == DEAD_STATE) {
+                next_state = static_cast<std::uint8_t>(dfa.num_states++);
+            }
+            state = next_state;
+        }
+        dfa.output[state] = entity.value;
+    }
+    return dfa;
+}
+
+constexpr Dfa DFA = BuildDfa();
+
+// Ни одно имя мнемоники не является префиксом другого, поэтому мнемонику можно декодировать
+// сразу по достижении принимающего состояния, не заглядывая вперёд
+constexpr bool IsPrefixFree(const Dfa& dfa) {
+    for (size_t state = 0; state < dfa.num_states; ++state) {
+        if (dfa.output[state] == '\0') {
+            continue;
+        }
+        for (auto next_state : dfa.next[state]) {
+            if (next_state != DEAD_STATE) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+static_assert(IsPrefixFree(DFA));
+
+}  // namespace
+
+void HtmlDecoder::Decode(std::string_view chunk, std::string& out) {
+    const char* pos = chunk.data();
+    const char* const end = pos + chunk.size();
+
+    while (pos != end) {
+        switch (mode_) {
+            case Mode::TEXT: {
+                // Копируем целиком фрагмент текста до следующего символа &
+                const auto* amp = static_cast<const char*>(std::memchr(pos, '&', end - pos));
+                if (!amp) {
+                    out.append(pos, end);
+                    return;
+                }
+                out.append(pos, amp);
+                pos = amp + 1;
+                mode_ = Mode::ENTITY;
+                state_ = ROOT_STATE;
+                pending_size_ = 0;
+                break;
+            }
+            case Mode::ENTITY: {
+                const std::uint8_t next_state = DFA.Next(state_, *pos);
+                if (next_state == DEAD_STATE) {
+                    // Это не мнемоника. Выводим прочитанное как есть, а текущий символ
+                    // обрабатываем в обычном режиме
+                    FlushPendingEntity(out);
+                    mode_ = Mode::TEXT;
+                    break;
+                }
+                ++pos;
+                if (const char value = DFA.output[next_state]) {
+                    out.push_back(value);
+                    mode_ = Mode::AFTER_ENTITY;
+                } else {
+                    pending_[pending_size_++] = pos[-1];
+                    state_ = next_state;
+                }
+                break;
+            }
+            case Mode::AFTER_ENTITY:
+                if (*pos == ';') {
+                    ++pos;
+                }
+                mode_ = Mode::TEXT;
+                break;
+        }
+    }
+}
+
+void HtmlDecoder::Finish(std::string& out) {
+    if (mode_ == Mode::ENTITY) {
+        FlushPendingEntity(out);
+    }
+    mode_ = Mode::TEXT;
+    state_ = ROOT_STATE;
+    pending_size_ = 0;
+}
+
+void HtmlDecoder::FlushPendingEntity(std::string& out) {
+    out.push_back('&');
+    out.append(pending_.data(), pending_size_);
+    pending_size_ = 0;
+}
+
+std::string HtmlDecode(std::string_view str) {
+    std::string result;
+    // Декодированная строка не длиннее исходной
+    result.reserve(str.size());
+    HtmlDecoder decoder;
+    decoder.Decode(str, result);
+    decoder.Finish(result);
+    return result;
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/*
+ * Декодирует основные HTML-мнемоники:
+ * - &lt - <
+ * - &gt - >
+ * - &amp - &
+ * - &apos - '
+ * - &quot - "
+ *
+ * Мнемоника может быть записана целиком либо строчными, либо заглавными буквами:
+ * - &lt и &LT декодируются как <
+ * - &Lt и &lT не мнемоники
+ *
+ * После мнемоники может стоять опциональный символ ;
+ * - M&amp;M&APOSs декодируется в M&M's
+ * - &amp;lt; декодируется в &lt;
+ */
+std::string HtmlDecode(std::string_view str);
+
+/*
+ * Потоковый декодер HTML-мнемоник. Правила декодирования те же, что и у HtmlDecode.
+ * Позволяет декодировать документ по частям, не загружая его в память целиком.
+ * Мнемоника может быть разбита между соседними частями:
+ *
+ * HtmlDecoder decoder;
+ * std::string out;
+ * decoder.Decode("M&am", out);
+ * decoder.Decode("p;M", out);
+ * decoder.Finish(out);  // out == "M&M"
+ *
+ * Фрагменты текста без символа & копируются в out целиком, а мнемоники распознаются
+ * конечным автоматом, таблица переходов которого строится на этапе компиляции.
+ */
+class HtmlDecoder {
+public:
+    // Декодирует очередную часть документа, дописывая результат в конец out.
+    // Незавершённая в конце chunk мнемоника запоминается до следующего вызова
+    void Decode(std::string_view chunk, std::string& out);
+
+    // Сообщает об окончании документа. Дописывает в out незавершённую мнемонику как есть
+    // и возвращает декодер в исходное состояние
+    void Finish(std::string& out);
+
+private:
+    // Максимальная длина мнемоники без символа &
+    static constexpr size_t MAX_ENTITY_LENGTH = 4;
+
+    enum class Mode : std::uint8_t {
+        TEXT,             // Обычный текст
+        ENTITY,           // Внутри мнемоники после символа &
+        AFTER_ENTITY,     // Мнемоника распознана, ожидается опциональный символ ;
+    };
+
+    void FlushPendingEntity(std::string& out);
+
+    Mode mode_ = Mode::TEXT;
+    // Текущее состояние автомата распознавания мнемоник
+    std::uint8_t state_ = 0;
+    // Символы мнемоники, прочитанные после &, но ещё не записанные в выходную строку
+    std::array<char, MAX_ENTITY_LENGTH> pending_{};
+    std::uint8_t pending_size_ = 0;
+};
@@ -0,0 +1,9 @@
+#include "htmldecode.h"
+//
+#include <iostream>
+
+int main() {
+    std::string str;
+    std::getline(std::cin, str);
+    std::cout << HtmlDecode(str) << std::endl;
+}
\ No newline at end of file
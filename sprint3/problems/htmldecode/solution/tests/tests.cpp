@@ -0,0 +1,65 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "../src/htmldecode.h"
+
+using namespace std::literals;
+
+TEST_CASE("Text without mnemonics", "[HtmlDecode]") {
+    CHECK(HtmlDecode(""sv) == ""s);
+    CHECK(HtmlDecode("hello"sv) == "hello"s);
+}
+
+TEST_CASE("Text with mnemonics", "[HtmlDecode]") {
+    CHECK(HtmlDecode("&lt;&gt;&amp;&apos;&quot;"sv) == "<>&'\""s);
+    CHECK(HtmlDecode("&LT&GT&AMP&APOS&QUOT"sv) == "<>&'\""s);
+    CHECK(HtmlDecode("M&amp;M&APOSs"sv) == "M&M's"s);
+    CHECK(HtmlDecode("&amp;lt;"sv) == "&lt;"s);
+    CHECK(HtmlDecode("a&ltb"sv) == "a<b"s);
+    CHECK(HtmlDecode("&lt;;"sv) == "<;"s);
+}
+
+TEST_CASE("Text with invalid mnemonics", "[HtmlDecode]") {
+    CHECK(HtmlDecode("&Lt&lT&Amp"sv) == "&Lt&lT&Amp"s);
+    CHECK(HtmlDecode("&"sv) == "&"s);
+    CHECK(HtmlDecode("&&lt"sv) == "&<"s);
+    CHECK(HtmlDecode("&apo"sv) == "&apo"s);
+    CHECK(HtmlDecode("&ap&amp"sv) == "&ap&"s);
+    CHECK(HtmlDecode("&nbsp;"sv) == "&nbsp;"s);
+}
+
+TEST_CASE("Mnemonics split between chunks", "[HtmlDecoder]") {
+    HtmlDecoder decoder;
+    std::string out;
+
+    decoder.Decode("M&am"sv, out);
+    decoder.Decode("p"sv, out);
+    decoder.Decode(";M&"sv, out);
+    decoder.Decode("APO"sv, out);
+    decoder.Decode("S"sv, out);
+    decoder.Decode(""sv, out);
+    decoder.Decode(";s &q"sv, out);
+    decoder.Finish(out);
+    CHECK(out == "M&M's &q"s);
+
+    // После Finish декодер можно использовать повторно
+    out.clear();
+    decoder.Decode("&g"sv, out);
+    decoder.Decode("t"sv, out);
+    decoder.Finish(out);
+    CHECK(out == ">"s);
+}
+
+TEST_CASE("Chunked decoding matches whole-string decoding", "[HtmlDecoder]") {
+    const auto input = "&lt;p&GT; M&amp;M&APOSs &quot&Lt &amp;amp;&apo&"sv;
+    const auto expected = HtmlDecode(input);
+
+    for (size_t chunk_size = 1; chunk_size <= input.size(); ++chunk_size) {
+        HtmlDecoder decoder;
+        std::string out;
+        for (size_t pos = 0; pos < input.size(); pos += chunk_size) {
+            decoder.Decode(input.substr(pos, chunk_size), out);
+        }
+        decoder.Finish(out);
+        CHECK(out == expected);
+    }
+}
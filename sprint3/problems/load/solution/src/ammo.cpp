@@ -0,0 +1,65 @@
+#include "ammo.h"
+
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/algorithm/string/trim.hpp>
+#include <istream>
+#include <stdexcept>
+
+namespace loadgen {
+
+using namespace std::literals;
+
+std::string Ammo::GetHeader(std::string_view name) const {
+    for (const auto& [header_name, value] : headers) {
+        if (boost::algorithm::iequals(header_name, name)) {
+            return value;
+        }
+    }
+    return {};
+}
+
+Ammo ParseAmmo(std::istream& input) {
+    Ammo ammo;
+    std::string line;
+    while (std::getline(input, line)) {
+        boost::algorithm::trim(line);
+        if (line.empty()) {
+            continue;
+        }
+
+        if (line.front() == '[') {
+            if (line.back() != ']') {
+                throw std::invalid_argument("Unterminated ammo header: "s + line);
+            }
+            const std::string_view header = std::string_view{line}.substr(1, line.size() - 2);
+            const size_t colon_pos = header.find(':');
+            if (colon_pos == std::string_view::npos) {
+                throw std::invalid_argument("Invalid ammo header: "s + line);
+            }
+            std::string name{header.substr(0, colon_pos)};
+            std::string value{header.substr(colon_pos + 1)};
+            boost::algorithm::trim(name);
+            boost::algorithm::trim(value);
+
+            // Повторное объявление заголовка заменяет предыдущее значение
+            std::erase_if(ammo.headers, [&name](const auto& header) {
+                return boost::algorithm::iequals(header.first, name);
+            });
+            ammo.headers.emplace_back(std::move(name), std::move(value));
+            continue;
+        }
+
+        if (line.front() != '/') {
+            throw std::invalid_argument("Invalid ammo target: "s + line);
+        }
+        // Всё, что после пробела, - тег запроса
+        ammo.targets.emplace_back(line.substr(0, line.find_first_of(" \t"sv)));
+    }
+
+    if (ammo.targets.empty()) {
+        throw std::invalid_argument("Ammo file contains no requests");
+    }
+    return ammo;
+}
+
+}  // namespace loadgen
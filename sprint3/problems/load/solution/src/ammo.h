@@ -0,0 +1,34 @@
+#pragma once
+
+#include <iosfwd>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace loadgen {
+
+/*
+ * Патроны в формате uri-ammo Яндекс.Танка:
+ *
+ * [Connection: close]
+ * [Host: cppserver]
+ * /api/v1/maps
+ * /api/v1/maps/map1 tag
+ *
+ * Строки в квадратных скобках задают заголовки всех последующих запросов,
+ * остальные непустые строки - target GET-запроса и необязательный тег через пробел.
+ */
+struct Ammo {
+    std::vector<std::pair<std::string, std::string>> headers;
+    std::vector<std::string> targets;
+
+    // Возвращает значение заголовка name (без учёта регистра) либо пустую строку
+    std::string GetHeader(std::string_view name) const;
+};
+
+// Читает патроны из input. Выбрасывает std::invalid_argument, если файл содержит ошибки
+// или в нём нет ни одного запроса
+Ammo ParseAmmo(std::istream& input);
+
+}  // namespace loadgen
@@ -0,0 +1,2 @@
+// Этот файл служит для подключения реализации библиотеки Boost.Json
+#include <boost/json/src.hpp>
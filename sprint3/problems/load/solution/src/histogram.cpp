@@ -0,0 +1,88 @@
+#include "histogram.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace loadgen {
+
+void LatencyHistogram::Record(std::chrono::nanoseconds value) noexcept {
+    const auto micros = std::chrono::duration_cast<Duration>(value).count();
+    const std::uint64_t clamped = std::min<std::uint64_t>(
+        std::max<std::int64_t>(micros, 0), (std::uint64_t{1} << MAX_VALUE_BITS) - 1);
+
+    ++buckets_[GetBucketIndex(clamped)];
+    ++count_;
+    sum_ += clamped;
+    min_ = std::min(min_, clamped);
+    max_ = std::max(max_, clamped);
+}
+
+void LatencyHistogram::Merge(const LatencyHistogram& other) noexcept {
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+        buckets_[i] += other.buckets_[i];
+    }
+    count_ += other.count_;
+    sum_ += other.sum_;
+    min_ = std::min(min_, other.min_);
+    max_ = std::max(max_, other.max_);
+}
+
+LatencyHistogram::Duration LatencyHistogram::GetMin() const noexcept {
+    return Duration(count_ ? min_ : 0);
+}
+
+LatencyHistogram::Duration LatencyHistogram::GetMax() const noexcept {
+    return Duration(max_);
+}
+
+LatencyHistogram::Duration LatencyHistogram::GetMean() const noexcept {
+    return Duration(count_ ? sum_ / count_ : 0);
+}
+
+LatencyHistogram::Duration LatencyHistogram::GetValueAtPercentile(
+    double percentile) const noexcept {
+    if (count_ == 0) {
+        return Duration{0};
+    }
+    percentile = std::clamp(percentile, 0.0, 100.0);
+    const auto target = std::max<std::uint64_t>(
+        1, static_cast<std::uint64_t>(std::ceil(percentile / 100.0 * count_)));
+
+    std::uint64_t accumulated = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+        accumulated += buckets_[i];
+        if (accumulated >= target) {
+            // Верхняя граница интервала может превышать реальный максимум
+            return Duration(std::min(GetBucketUpperBound(i), max_));
+        }
+    }
+    return Duration(max_);
+}
+
+/*
+ * Значения меньше SUB_BUCKET_COUNT хранятся точно.
+ * Остальные значения делятся на группы по степеням двойки, каждая из которых разбита на
+ * SUB_BUCKET_COUNT / 2 равных интервалов.
+ */
+size_t LatencyHistogram::GetBucketIndex(std::uint64_t value) noexcept {
+    if (value < SUB_BUCKET_COUNT) {
+        return static_cast<size_t>(value);
+    }
+    const int shift = std::bit_width(value) - SUB_BUCKET_BITS;
+    const std::uint64_t sub_bucket = value >> shift;  // [SUB_BUCKET_COUNT/2, SUB_BUCKET_COUNT)
+    return static_cast<size_t>(SUB_BUCKET_COUNT + (shift - 1) * (SUB_BUCKET_COUNT / 2)
+                               + (sub_bucket - SUB_BUCKET_COUNT / 2));
+}
+
+std::uint64_t LatencyHistogram::GetBucketUpperBound(size_t index) noexcept {
+    if (index < SUB_BUCKET_COUNT) {
+        return index;
+    }
+    const size_t offset = index - SUB_BUCKET_COUNT;
+    const int shift = static_cast<int>(offset / (SUB_BUCKET_COUNT / 2)) + 1;
+    const std::uint64_t sub_bucket = offset % (SUB_BUCKET_COUNT / 2) + SUB_BUCKET_COUNT / 2;
+    return ((sub_bucket + 1) << shift) - 1;
+}
+
+}  // namespace loadgen
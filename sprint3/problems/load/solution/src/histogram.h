@@ -0,0 +1,54 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+namespace loadgen {
+
+/*
+ * Гистограмма задержек с логарифмически-линейной сеткой интервалов, как в HdrHistogram.
+ * Значения хранятся с точностью до микросекунды, относительная погрешность не превышает 1%.
+ * Запись значения выполняется за O(1) и не выделяет память.
+ */
+class LatencyHistogram {
+public:
+    using Duration = std::chrono::microseconds;
+
+    void Record(std::chrono::nanoseconds value) noexcept;
+
+    // Добавляет к гистограмме все значения из other
+    void Merge(const LatencyHistogram& other) noexcept;
+
+    std::uint64_t GetCount() const noexcept {
+        return count_;
+    }
+
+    Duration GetMin() const noexcept;
+    Duration GetMax() const noexcept;
+    Duration GetMean() const noexcept;
+
+    // Возвращает значение, не меньше которого percentile процентов записанных значений
+    Duration GetValueAtPercentile(double percentile) const noexcept;
+
+private:
+    // Количество интервалов на одну степень двойки
+    static constexpr int SUB_BUCKET_BITS = 7;
+    static constexpr std::uint64_t SUB_BUCKET_COUNT = std::uint64_t{1} << SUB_BUCKET_BITS;
+    // Максимальное значение - 2^36 мкс (около 19 часов). Большие значения прижимаются к нему
+    static constexpr int MAX_VALUE_BITS = 36;
+    static constexpr size_t BUCKET_COUNT =
+        SUB_BUCKET_COUNT + (MAX_VALUE_BITS - SUB_BUCKET_BITS) * (SUB_BUCKET_COUNT / 2);
+
+    static size_t GetBucketIndex(std::uint64_t value) noexcept;
+    static std::uint64_t GetBucketUpperBound(size_t index) noexcept;
+
+    std::array<std::uint64_t, BUCKET_COUNT> buckets_{};
+    std::uint64_t count_ = 0;
+    std::uint64_t min_ = UINT64_MAX;
+    std::uint64_t max_ = 0;
+    // Сумма значений для вычисления среднего. 2^64 мкс хватит на сотни тысяч лет
+    std::uint64_t sum_ = 0;
+};
+
+}  // namespace loadgen
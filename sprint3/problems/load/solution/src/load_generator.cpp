@@ -0,0 +1,293 @@
+#include "load_generator.h"
+
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/asio/write.hpp>
+
+namespace loadgen {
+
+using namespace std::literals;
+
+/*
+ * Соединение с сервером. Запросы отправляются в порядке поступления, и, если позволяет глубина
+ * конвейера, следующий запрос отправляется, не дожидаясь ответа на предыдущий.
+ * Ответы приходят в том же порядке, в каком были отправлены запросы.
+ */
+class LoadGenerator::Connection : public std::enable_shared_from_this<Connection> {
+public:
+    explicit Connection(LoadGenerator& owner)
+        : owner_{owner}
+        , stream_{owner.io_} {
+    }
+
+    size_t GetLoad() const noexcept {
+        return in_flight_.size();
+    }
+
+    bool CanSend() const noexcept {
+        const size_t depth = owner_.config_.keep_alive ? owner_.config_.pipeline_depth : 1;
+        return in_flight_.size() < depth;
+    }
+
+    void Send(const Shot& shot) {
+        in_flight_.push_back({shot, {}});
+        if (state_ == State::DISCONNECTED) {
+            Connect();
+        } else if (state_ == State::CONNECTED) {
+            Write();
+        }
+    }
+
+    void Close() {
+        ++generation_;
+        sys::error_code ec;
+        stream_.socket().shutdown(tcp::socket::shutdown_send, ec);
+        stream_.close();
+        buffer_.clear();
+        state_ = State::DISCONNECTED;
+        writing_ = reading_ = false;
+    }
+
+private:
+    enum class State { DISCONNECTED, CONNECTING, CONNECTED };
+
+    struct Request {
+        Shot shot;
+        Clock::time_point sent_at;
+    };
+
+    void Connect() {
+        state_ = State::CONNECTING;
+        stream_.expires_after(owner_.config_.timeout);
+        stream_.async_connect(owner_.endpoint_,
+                              [self = shared_from_this(), gen = generation_](sys::error_code ec) {
+                                  self->OnConnect(gen, ec);
+                              });
+    }
+
+    void OnConnect(std::uint64_t gen, sys::error_code ec) {
+        if (gen != generation_) {
+            return;
+        }
+        if (ec) {
+            return Fail();
+        }
+        state_ = State::CONNECTED;
+        sys::error_code ignored;
+        stream_.socket().set_option(tcp::no_delay{true}, ignored);
+        Write();
+    }
+
+    // Отправляет следующий ещё не отправленный запрос
+    void Write() {
+        if (writing_ || written_ == in_flight_.size()) {
+            return;
+        }
+        writing_ = true;
+        Request& request = in_flight_[written_];
+        request.sent_at = Clock::now();
+        const std::string& data = owner_.requests_[request.shot.request_index];
+        stream_.expires_after(owner_.config_.timeout);
+        net::async_write(stream_, net::buffer(data),
+                         [self = shared_from_this(), gen = generation_](sys::error_code ec,
+                                                                        size_t) {
+                             self->OnWrite(gen, ec);
+                         });
+    }
+
+    void OnWrite(std::uint64_t gen, sys::error_code ec) {
+        if (gen != generation_) {
+            return;
+        }
+        writing_ = false;
+        if (ec) {
+            return Fail();
+        }
+        ++written_;
+        Write();
+        Read();
+    }
+
+    void Read() {
+        if (reading_ || written_ == 0) {
+            return;
+        }
+        reading_ = true;
+        response_ = {};
+        stream_.expires_after(owner_.config_.timeout);
+        http::async_read(stream_, buffer_, response_,
+                         [self = shared_from_this(), gen = generation_](sys::error_code ec,
+                                                                        size_t) {
+                             self->OnRead(gen, ec);
+                         });
+    }
+
+    void OnRead(std::uint64_t gen, sys::error_code ec) {
+        if (gen != generation_) {
+            return;
+        }
+        reading_ = false;
+        if (ec) {
+            return Fail();
+        }
+
+        const Request request = in_flight_.front();
+        const unsigned status = response_.result_int();
+        in_flight_.pop_front();
+        --written_;
+
+        if (response_.need_eof()) {
+            // Сервер закрывает соединение. Запросы, отправленные вслед за этим, потеряны,
+            // а ещё не отправленные будут отправлены после повторного подключения
+            Close();
+            std::vector<Shot> lost;
+            for (; written_ > 0; --written_) {
+                lost.push_back(in_flight_.front().shot);
+                in_flight_.pop_front();
+            }
+            if (!in_flight_.empty()) {
+                Connect();
+            }
+            for (const Shot& shot : lost) {
+                owner_.OnError(shot);
+            }
+        } else {
+            Read();
+            Write();
+        }
+
+        owner_.OnResponse(request.shot, request.sent_at, status);
+    }
+
+    void Fail() {
+        Close();
+        written_ = 0;
+        auto failed = std::move(in_flight_);
+        in_flight_.clear();
+        for (const Request& request : failed) {
+            owner_.OnError(request.shot);
+        }
+        owner_.Dispatch();
+        owner_.CheckFinished();
+    }
+
+    LoadGenerator& owner_;
+    beast::tcp_stream stream_;
+    beast::flat_buffer buffer_;
+    http::response<http::string_body> response_;
+    State state_ = State::DISCONNECTED;
+    // Запросы в порядке отправки. Первые written_ из них уже отправлены
+    std::deque<Request> in_flight_;
+    size_t written_ = 0;
+    bool writing_ = false;
+    bool reading_ = false;
+    // Увеличивается при закрытии сокета, чтобы игнорировать завершение прерванных операций
+    std::uint64_t generation_ = 0;
+};
+
+LoadGenerator::LoadGenerator(net::io_context& io, tcp::endpoint endpoint, const Ammo& ammo,
+                             LoadSchedule schedule, LoadConfig config)
+    : io_{io}
+    , endpoint_{std::move(endpoint)}
+    , schedule_{std::move(schedule)}
+    , config_{std::move(config)}
+    , timer_{io} {
+    if (config_.connections == 0 || config_.pipeline_depth == 0) {
+        throw std::invalid_argument("Number of connections and pipeline depth must be positive");
+    }
+
+    std::string host = config_.host.empty() ? ammo.GetHeader("Host"sv) : config_.host;
+    if (host.empty()) {
+        host = endpoint_.address().to_string();
+    }
+
+    for (const auto& target : ammo.targets) {
+        std::string request = "GET "s + target + " HTTP/1.1\r\nHost: "s + host + "\r\n"s;
+        for (const auto& [name, value] : ammo.headers) {
+            if (!boost::algorithm::iequals(name, "Host"sv)
+                && !boost::algorithm::iequals(name, "Connection"sv)) {
+                request += name + ": "s + value + "\r\n"s;
+            }
+        }
+        request += config_.keep_alive ? "Connection: keep-alive\r\n\r\n"sv
+                                      : "Connection: close\r\n\r\n"sv;
+        requests_.push_back(std::move(request));
+    }
+
+    connections_.reserve(config_.connections);
+    for (size_t i = 0; i < config_.connections; ++i) {
+        connections_.push_back(std::make_shared<Connection>(*this));
+    }
+}
+
+LoadGenerator::~LoadGenerator() = default;
+
+void LoadGenerator::Start() {
+    start_time_ = Clock::now();
+    ScheduleNextShot();
+}
+
+void LoadGenerator::ScheduleNextShot() {
+    const auto offset = schedule_.NextShot();
+    if (!offset) {
+        schedule_finished_ = true;
+        return CheckFinished();
+    }
+    timer_.expires_at(start_time_ + *offset);
+    timer_.async_wait([this](sys::error_code ec) {
+        if (ec) {
+            return;
+        }
+        waiting_shots_.push_back({timer_.expiry(), next_request_});
+        next_request_ = (next_request_ + 1) % requests_.size();
+        ++report_.scheduled;
+        Dispatch();
+        ScheduleNextShot();
+    });
+}
+
+void LoadGenerator::Dispatch() {
+    while (!waiting_shots_.empty()) {
+        // Выбираем наименее загруженное соединение
+        Connection* best = nullptr;
+        for (const auto& connection : connections_) {
+            if (connection->CanSend() && (!best || connection->GetLoad() < best->GetLoad())) {
+                best = connection.get();
+            }
+        }
+        if (!best) {
+            return;
+        }
+        ++in_flight_;
+        const Shot shot = waiting_shots_.front();
+        waiting_shots_.pop_front();
+        best->Send(shot);
+    }
+}
+
+void LoadGenerator::OnResponse(const Shot& shot, Clock::time_point sent_at, unsigned status) {
+    const auto now = Clock::now();
+    --in_flight_;
+    ++report_.completed;
+    ++report_.status_codes[status];
+    report_.latency.Record(now - shot.scheduled_at);
+    report_.service_time.Record(now - sent_at);
+    Dispatch();
+    CheckFinished();
+}
+
+void LoadGenerator::OnError([[maybe_unused]] const Shot& shot) {
+    --in_flight_;
+    ++report_.errors;
+}
+
+void LoadGenerator::CheckFinished() {
+    if (!schedule_finished_ || !waiting_shots_.empty() || in_flight_ != 0) {
+        return;
+    }
+    report_.elapsed = Clock::now() - start_time_;
+    for (const auto& connection : connections_) {
+        connection->Close();
+    }
+}
+
+}  // namespace loadgen
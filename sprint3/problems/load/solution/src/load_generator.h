@@ -0,0 +1,115 @@
+#pragma once
+#include "sdk.h"
+// boost.beast будет использовать std::string_view вместо boost::string_view
+#define BOOST_BEAST_USE_STD_STRING_VIEW
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/beast/core.hpp>
+#include <boost/beast/http.hpp>
+#include <chrono>
+#include <deque>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ammo.h"
+#include "histogram.h"
+#include "schedule.h"
+
+namespace loadgen {
+
+namespace net = boost::asio;
+using tcp = net::ip::tcp;
+namespace beast = boost::beast;
+namespace http = beast::http;
+namespace sys = boost::system;
+
+using Clock = std::chrono::steady_clock;
+
+struct LoadConfig {
+    // Значение заголовка Host. Если пусто, берётся из патронов
+    std::string host;
+    // Количество одновременно открытых соединений
+    size_t connections = 16;
+    // Сколько запросов можно отправить в одно соединение, не дожидаясь ответа
+    size_t pipeline_depth = 1;
+    // Использовать ли одно соединение для нескольких запросов.
+    // Если false, каждый запрос отправляется с заголовком Connection: close
+    bool keep_alive = true;
+    // Максимальное время ожидания подключения или ответа
+    std::chrono::milliseconds timeout{10'000};
+};
+
+struct LoadReport {
+    /*
+     * Задержка от запланированного момента отправки запроса до получения ответа.
+     * Запрос, который ждал свободного соединения, учитывается вместе со временем ожидания.
+     * Это устраняет эффект coordinated omission: медленный сервер не может снизить
+     * интенсивность нагрузки и тем самым скрыть свои задержки
+     */
+    LatencyHistogram latency;
+    // Время от фактической отправки запроса до получения ответа
+    LatencyHistogram service_time;
+    std::uint64_t scheduled = 0;
+    std::uint64_t completed = 0;
+    std::uint64_t errors = 0;
+    std::map<unsigned, std::uint64_t> status_codes;
+    Clock::duration elapsed{};
+};
+
+/*
+ * Генератор нагрузки. Отправляет GET-запросы из патронов по кругу в моменты времени,
+ * заданные профилем нагрузки, и собирает статистику ответов.
+ * Все операции выполняются в одном потоке, вызывающем io_context::run.
+ */
+class LoadGenerator {
+public:
+    LoadGenerator(net::io_context& io, tcp::endpoint endpoint, const Ammo& ammo,
+                  LoadSchedule schedule, LoadConfig config);
+    ~LoadGenerator();
+
+    LoadGenerator(const LoadGenerator&) = delete;
+    LoadGenerator& operator=(const LoadGenerator&) = delete;
+
+    // Начинает стрельбу. Она закончится, когда закончится профиль и придут все ответы
+    void Start();
+
+    const LoadReport& GetReport() const noexcept {
+        return report_;
+    }
+
+private:
+    class Connection;
+
+    struct Shot {
+        Clock::time_point scheduled_at;
+        size_t request_index;
+    };
+
+    void ScheduleNextShot();
+    void Dispatch();
+    void OnResponse(const Shot& shot, Clock::time_point sent_at, unsigned status);
+    void OnError(const Shot& shot);
+    void CheckFinished();
+
+    net::io_context& io_;
+    tcp::endpoint endpoint_;
+    LoadSchedule schedule_;
+    LoadConfig config_;
+    // Запросы сериализуются один раз и затем отправляются без копирования
+    std::vector<std::string> requests_;
+    std::vector<std::shared_ptr<Connection>> connections_;
+    net::steady_timer timer_;
+    Clock::time_point start_time_;
+    size_t next_request_ = 0;
+    bool schedule_finished_ = false;
+    // Запросы, время отправки которых наступило, но для которых нет свободного соединения
+    std::deque<Shot> waiting_shots_;
+    std::uint64_t in_flight_ = 0;
+    LoadReport report_;
+};
+
+}  // namespace loadgen
@@ -0,0 +1,124 @@
+#include "sdk.h"
+//
+#include <boost/asio/io_context.hpp>
+#include <boost/program_options.hpp>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+
+#include "load_generator.h"
+
+using namespace std::literals;
+namespace net = boost::asio;
+
+namespace {
+
+struct Args {
+    std::string ammo_file;
+    std::string schedule;
+    std::string address;
+    unsigned short port = 8080;
+    loadgen::LoadConfig config;
+};
+
+[[nodiscard]] std::optional<Args> ParseCommandLine(int argc, const char* const argv[]) {
+    namespace po = boost::program_options;
+
+    po::options_description desc{"All options"s};
+
+    Args args;
+    bool close_connections = false;
+    desc.add_options()                                  //
+        ("help,h", "produce help message")              //
+        ("ammo,a", po::value(&args.ammo_file)->value_name("file"s), "ammo file in uri format")
+        ("schedule,s", po::value(&args.schedule)->default_value("line(5, 30, 1m)"s)
+                           ->value_name("profile"s), "load profile, e.g. line(5, 30, 1m)")
+        ("address", po::value(&args.address)->default_value("127.0.0.1"s), "server address")
+        ("port,p", po::value(&args.port)->default_value(8080), "server port")
+        ("host", po::value(&args.config.host)->value_name("name"s),
+         "Host header (taken from ammo by default)")
+        ("connections,c", po::value(&args.config.connections)->default_value(16),
+         "number of connections")
+        ("pipeline", po::value(&args.config.pipeline_depth)->default_value(1),
+         "max number of requests sent over a connection without waiting for response")
+        ("close", po::bool_switch(&close_connections),
+         "send every request over a new connection");
+
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+
+    if (vm.contains("help"s)) {
+        std::cout << desc;
+        return std::nullopt;
+    }
+    if (!vm.contains("ammo"s)) {
+        throw std::runtime_error("Ammo file has not been specified"s);
+    }
+    args.config.keep_alive = !close_connections;
+    return args;
+}
+
+void PrintHistogram(std::ostream& out, std::string_view title,
+                    const loadgen::LatencyHistogram& histogram) {
+    const auto as_ms = [](loadgen::LatencyHistogram::Duration d) {
+        return std::chrono::duration<double, std::milli>(d).count();
+    };
+
+    out << title << " (ms):"sv << std::endl;
+    out << "  min "sv << as_ms(histogram.GetMin()) << ", mean "sv << as_ms(histogram.GetMean())
+        << ", max "sv << as_ms(histogram.GetMax()) << std::endl;
+    for (double percentile : {50.0, 75.0, 90.0, 95.0, 99.0, 99.9, 99.99}) {
+        out << "  p"sv << std::left << std::setw(6) << percentile << std::right
+            << as_ms(histogram.GetValueAtPercentile(percentile)) << std::endl;
+    }
+}
+
+void PrintReport(std::ostream& out, const loadgen::LoadReport& report) {
+    const double seconds = std::chrono::duration<double>(report.elapsed).count();
+
+    out << "Duration: "sv << seconds << "s"sv << std::endl;
+    out << "Requests: "sv << report.scheduled << " scheduled, "sv << report.completed
+        << " completed, "sv << report.errors << " errors"sv << std::endl;
+    if (seconds > 0) {
+        out << "Throughput: "sv << report.completed / seconds << " rps"sv << std::endl;
+    }
+    for (const auto& [status, count] : report.status_codes) {
+        out << "  HTTP "sv << status << ": "sv << count << std::endl;
+    }
+    PrintHistogram(out, "Latency from scheduled time"sv, report.latency);
+    PrintHistogram(out, "Service time"sv, report.service_time);
+}
+
+}  // namespace
+
+int main(int argc, const char* argv[]) {
+    try {
+        auto args = ParseCommandLine(argc, argv);
+        if (!args) {
+            return EXIT_SUCCESS;
+        }
+
+        std::ifstream ammo_file{args->ammo_file};
+        if (!ammo_file) {
+            throw std::runtime_error("Failed to open ammo file "s + args->ammo_file);
+        }
+        const loadgen::Ammo ammo = loadgen::ParseAmmo(ammo_file);
+
+        net::io_context ioc;
+        loadgen::tcp::resolver resolver{ioc};
+        const auto endpoints = resolver.resolve(args->address, std::to_string(args->port));
+
+        loadgen::LoadGenerator generator{ioc, endpoints.begin()->endpoint(), ammo,
+                                         loadgen::LoadSchedule::Parse(args->schedule),
+                                         args->config};
+        generator.Start();
+        ioc.run();
+
+        PrintReport(std::cout, generator.GetReport());
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+}
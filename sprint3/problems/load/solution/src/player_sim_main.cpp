@@ -0,0 +1,124 @@
+#include "sdk.h"
+//
+#include <boost/asio/io_context.hpp>
+#include <boost/program_options.hpp>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+
+#include "player_simulator.h"
+
+using namespace std::literals;
+namespace net = boost::asio;
+
+namespace {
+
+struct Args {
+    std::string address;
+    unsigned short port = 8080;
+    loadgen::SimulatorConfig config;
+};
+
+[[nodiscard]] std::optional<Args> ParseCommandLine(int argc, const char* const argv[]) {
+    namespace po = boost::program_options;
+
+    po::options_description desc{"All options"s};
+
+    Args args;
+    unsigned duration_ms = 0;
+    unsigned tick_period_ms = 0;
+    desc.add_options()                      //
+        ("help,h", "produce help message")  //
+        ("address", po::value(&args.address)->default_value("127.0.0.1"s), "server address")
+        ("port,p", po::value(&args.port)->default_value(8080), "server port")
+        ("map", po::value(&args.config.map_id)->default_value("map1"s), "map id to join")
+        ("players,n", po::value(&args.config.players)->default_value(1000), "number of players")
+        ("connections,c", po::value(&args.config.connections)->default_value(16),
+         "number of connections used by players")
+        ("duration,d", po::value(&duration_ms)->default_value(10'000)->value_name("ms"s),
+         "duration of the play phase")
+        ("action-share", po::value(&args.config.action_share)->default_value(0.5),
+         "share of /player/action requests among player requests")
+        ("tick-period,t", po::value(&tick_period_ms)->default_value(50)->value_name("ms"s),
+         "period of /game/tick requests, 0 disables them")
+        ("seed", po::value(&args.config.seed)->default_value(0), "random seed");
+
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+
+    if (vm.contains("help"s)) {
+        std::cout << desc;
+        return std::nullopt;
+    }
+    if (!(args.config.action_share >= 0 && args.config.action_share <= 1)) {
+        throw std::runtime_error("Action share must be in range [0, 1]"s);
+    }
+    args.config.duration = std::chrono::milliseconds{duration_ms};
+    if (tick_period_ms == 0) {
+        args.config.tick_period.reset();
+    } else {
+        args.config.tick_period = std::chrono::milliseconds{tick_period_ms};
+    }
+    return args;
+}
+
+void PrintReport(std::ostream& out, const loadgen::SimulatorReport& report) {
+    using namespace loadgen;
+    const auto as_seconds = [](auto d) {
+        return std::chrono::duration<double>(d).count();
+    };
+    const auto as_ms = [](LatencyHistogram::Duration d) {
+        return std::chrono::duration<double, std::milli>(d).count();
+    };
+
+    out << "Joined players: "sv << report.joined_players << " in "sv
+        << as_seconds(report.join_duration) << "s"sv << std::endl;
+    out << "Play phase: "sv << as_seconds(report.play_duration) << "s"sv << std::endl;
+
+    out << std::left << std::setw(28) << "Endpoint"sv << std::right << std::setw(10) << "ok"sv
+        << std::setw(8) << "errors"sv << std::setw(10) << "rps"sv << std::setw(9) << "p50"sv
+        << std::setw(9) << "p90"sv << std::setw(9) << "p99"sv << std::setw(9) << "p99.9"sv
+        << std::setw(9) << "max"sv << std::endl;
+
+    for (auto endpoint : {GameEndpoint::JOIN, GameEndpoint::ACTION, GameEndpoint::STATE,
+                          GameEndpoint::TICK}) {
+        const auto& stats = report[endpoint];
+        const auto& latency = stats.latency;
+        const double duration = as_seconds(endpoint == GameEndpoint::JOIN ? report.join_duration
+                                                                          : report.play_duration);
+        out << std::left << std::setw(28) << GetEndpointTarget(endpoint) << std::right
+            << std::setw(10) << latency.GetCount() << std::setw(8) << stats.errors
+            << std::setw(10) << std::fixed << std::setprecision(0)
+            << (duration > 0 ? latency.GetCount() / duration : 0.0) << std::setprecision(3);
+        for (double percentile : {50.0, 90.0, 99.0, 99.9}) {
+            out << std::setw(9) << as_ms(latency.GetValueAtPercentile(percentile));
+        }
+        out << std::setw(9) << as_ms(latency.GetMax()) << std::defaultfloat << std::endl;
+    }
+    out << "Latencies are in milliseconds"sv << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, const char* argv[]) {
+    try {
+        auto args = ParseCommandLine(argc, argv);
+        if (!args) {
+            return EXIT_SUCCESS;
+        }
+
+        net::io_context ioc;
+        loadgen::tcp::resolver resolver{ioc};
+        const auto endpoints = resolver.resolve(args->address, std::to_string(args->port));
+
+        loadgen::PlayerSimulator simulator{ioc, endpoints.begin()->endpoint(), args->config};
+        simulator.Start();
+        ioc.run();
+
+        PrintReport(std::cout, simulator.GetReport());
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,321 @@
+#include "player_simulator.h"
+
+#include <algorithm>
+#include <boost/beast/core.hpp>
+#include <boost/beast/http.hpp>
+#include <boost/json.hpp>
+
+namespace loadgen {
+
+namespace beast = boost::beast;
+namespace http = beast::http;
+namespace json = boost::json;
+namespace sys = boost::system;
+using namespace std::literals;
+using Clock = std::chrono::steady_clock;
+
+std::string_view GetEndpointTarget(GameEndpoint endpoint) noexcept {
+    switch (endpoint) {
+        case GameEndpoint::JOIN:
+            return "/api/v1/game/join"sv;
+        case GameEndpoint::ACTION:
+            return "/api/v1/game/player/action"sv;
+        case GameEndpoint::STATE:
+            return "/api/v1/game/state"sv;
+        case GameEndpoint::TICK:
+            return "/api/v1/game/tick"sv;
+    }
+    return {};
+}
+
+struct PlayerSimulator::GameRequest {
+    GameEndpoint endpoint;
+    http::verb method = http::verb::get;
+    std::string body;
+    std::string authorization;
+    // Момент, не раньше которого запрос нужно отправить
+    std::optional<Clock::time_point> send_at;
+};
+
+/*
+ * Соединение, по которому запросы отправляются по одному: следующий запрос отправляется
+ * после получения ответа на предыдущий. Запросы соединение берёт у PlayerSimulator.
+ */
+class PlayerSimulator::Session : public std::enable_shared_from_this<Session> {
+public:
+    Session(PlayerSimulator& owner, bool ticker)
+        : owner_{owner}
+        , ticker_{ticker}
+        , stream_{owner.io_}
+        , timer_{owner.io_} {
+    }
+
+    bool IsIdle() const noexcept {
+        return idle_;
+    }
+
+    // Берёт у владельца следующий запрос и отправляет его.
+    // Если запросов нет, соединение переходит в режим ожидания
+    void Resume() {
+        auto request = ticker_ ? owner_.NextTickRequest() : owner_.NextPlayerRequest();
+        if (!request) {
+            idle_ = true;
+            return owner_.OnSessionIdle();
+        }
+        idle_ = false;
+        request_ = std::move(*request);
+        if (request_.send_at) {
+            timer_.expires_at(*request_.send_at);
+            timer_.async_wait([self = shared_from_this()](sys::error_code ec) {
+                if (!ec) {
+                    self->Send();
+                }
+            });
+        } else {
+            Send();
+        }
+    }
+
+    void Close() {
+        sys::error_code ec;
+        stream_.socket().shutdown(tcp::socket::shutdown_send, ec);
+        stream_.close();
+        buffer_.clear();
+        connected_ = false;
+    }
+
+private:
+    void Send() {
+        http_request_ = {};
+        http_request_.method(request_.method);
+        http_request_.target(GetEndpointTarget(request_.endpoint));
+        http_request_.version(11);
+        http_request_.set(http::field::host, owner_.endpoint_.address().to_string());
+        if (!request_.authorization.empty()) {
+            http_request_.set(http::field::authorization, request_.authorization);
+        }
+        if (request_.method == http::verb::post) {
+            http_request_.set(http::field::content_type, "application/json"sv);
+            http_request_.body() = request_.body;
+        }
+        http_request_.keep_alive(true);
+        http_request_.prepare_payload();
+
+        stream_.expires_after(owner_.config_.timeout);
+        if (connected_) {
+            return Write();
+        }
+        stream_.async_connect(owner_.endpoint_,
+                              [self = shared_from_this()](sys::error_code ec) {
+                                  if (ec) {
+                                      return self->Fail();
+                                  }
+                                  self->connected_ = true;
+                                  self->Write();
+                              });
+    }
+
+    void Write() {
+        sent_at_ = Clock::now();
+        http::async_write(stream_, http_request_,
+                          [self = shared_from_this()](sys::error_code ec, size_t) {
+                              if (ec) {
+                                  return self->Fail();
+                              }
+                              self->Read();
+                          });
+    }
+
+    void Read() {
+        response_ = {};
+        http::async_read(stream_, buffer_, response_,
+                         [self = shared_from_this()](sys::error_code ec, size_t) {
+                             self->OnRead(ec);
+                         });
+    }
+
+    void OnRead(sys::error_code ec) {
+        if (ec) {
+            return Fail();
+        }
+        if (response_.need_eof()) {
+            Close();
+        }
+        owner_.OnResponse(request_, response_.result_int(), response_.body(),
+                          Clock::now() - sent_at_);
+        Resume();
+    }
+
+    void Fail() {
+        Close();
+        owner_.OnError(request_);
+        Resume();
+    }
+
+    PlayerSimulator& owner_;
+    bool ticker_;
+    beast::tcp_stream stream_;
+    net::steady_timer timer_;
+    beast::flat_buffer buffer_;
+    http::request<http::string_body> http_request_;
+    http::response<http::string_body> response_;
+    GameRequest request_;
+    Clock::time_point sent_at_;
+    bool connected_ = false;
+    bool idle_ = true;
+};
+
+PlayerSimulator::PlayerSimulator(net::io_context& io, tcp::endpoint endpoint,
+                                 SimulatorConfig config)
+    : io_{io}
+    , endpoint_{std::move(endpoint)}
+    , config_{std::move(config)}
+    , random_engine_{config_.seed} {
+    if (config_.connections == 0) {
+        throw std::invalid_argument("Number of connections must be positive");
+    }
+    authorizations_.reserve(config_.players);
+    sessions_.reserve(config_.connections);
+    for (size_t i = 0; i < config_.connections; ++i) {
+        sessions_.push_back(std::make_shared<Session>(*this, false));
+    }
+    if (config_.tick_period) {
+        tick_session_ = std::make_shared<Session>(*this, true);
+    }
+}
+
+PlayerSimulator::~PlayerSimulator() = default;
+
+void PlayerSimulator::Start() {
+    phase_start_ = Clock::now();
+    if (config_.players == 0) {
+        return StartPlayPhase();
+    }
+    for (const auto& session : sessions_) {
+        session->Resume();
+    }
+}
+
+std::optional<PlayerSimulator::GameRequest> PlayerSimulator::NextPlayerRequest() {
+    switch (phase_) {
+        case Phase::JOIN: {
+            if (join_requests_sent_ == config_.players) {
+                return std::nullopt;
+            }
+            const json::object body{
+                {"userName"sv, "Player"s + std::to_string(join_requests_sent_++)},
+                {"mapId"sv, config_.map_id},
+            };
+            return GameRequest{GameEndpoint::JOIN, http::verb::post, json::serialize(body), {},
+                               {}};
+        }
+        case Phase::PLAY: {
+            if (authorizations_.empty() || Clock::now() - phase_start_ >= config_.duration) {
+                return std::nullopt;
+            }
+            std::uniform_int_distribution<size_t> player_distribution{0,
+                                                                      authorizations_.size() - 1};
+            std::string authorization = authorizations_[player_distribution(random_engine_)];
+            if (std::bernoulli_distribution{config_.action_share}(random_engine_)) {
+                // Пустая строка означает остановку игрока
+                static constexpr std::array MOVES = {"L"sv, "R"sv, "U"sv, "D"sv, ""sv};
+                std::uniform_int_distribution<size_t> move_distribution{0, MOVES.size() - 1};
+                const json::object body{{"move"sv, MOVES[move_distribution(random_engine_)]}};
+                return GameRequest{GameEndpoint::ACTION, http::verb::post, json::serialize(body),
+                                   std::move(authorization), {}};
+            }
+            return GameRequest{GameEndpoint::STATE, http::verb::get, {}, std::move(authorization),
+                               {}};
+        }
+        case Phase::FINISHED:
+            break;
+    }
+    return std::nullopt;
+}
+
+std::optional<PlayerSimulator::GameRequest> PlayerSimulator::NextTickRequest() {
+    if (phase_ != Phase::PLAY || !config_.tick_period) {
+        return std::nullopt;
+    }
+    const auto& stats = report_[GameEndpoint::TICK];
+    const auto tick_number = stats.latency.GetCount() + stats.errors;
+    // Тики отправляются через равные промежутки времени независимо от длительности
+    // обработки предыдущего тика
+    const auto send_at = phase_start_ + *config_.tick_period * (tick_number + 1);
+    if (send_at - phase_start_ >= config_.duration) {
+        return std::nullopt;
+    }
+    const json::object body{{"timeDelta"sv, config_.tick_period->count()}};
+    return GameRequest{GameEndpoint::TICK, http::verb::post, json::serialize(body), {}, send_at};
+}
+
+void PlayerSimulator::OnResponse(const GameRequest& request, unsigned status,
+                                 std::string_view body, Clock::duration latency) {
+    if (status != 200) {
+        return OnError(request);
+    }
+
+    if (request.endpoint == GameEndpoint::JOIN) {
+        // Ответ без токена считается ошибкой, и его задержка не учитывается
+        try {
+            const auto response = json::parse(body).as_object();
+            authorizations_.push_back("Bearer "s
+                                      + std::string{response.at("authToken"sv).as_string()});
+        } catch (const std::exception&) {
+            return OnError(request);
+        }
+    }
+
+    report_[request.endpoint].latency.Record(latency);
+    if (request.endpoint == GameEndpoint::JOIN && ++join_responses_ == config_.players) {
+        StartPlayPhase();
+    }
+}
+
+void PlayerSimulator::OnError(const GameRequest& request) {
+    ++report_[request.endpoint].errors;
+    if (request.endpoint == GameEndpoint::JOIN && ++join_responses_ == config_.players) {
+        StartPlayPhase();
+    }
+}
+
+void PlayerSimulator::OnSessionIdle() {
+    if (phase_ != Phase::PLAY) {
+        return;
+    }
+    const auto is_idle = [](const auto& session) {
+        return !session || session->IsIdle();
+    };
+    if (!std::all_of(sessions_.begin(), sessions_.end(), is_idle) || !is_idle(tick_session_)) {
+        return;
+    }
+
+    phase_ = Phase::FINISHED;
+    report_.play_duration = Clock::now() - phase_start_;
+    for (const auto& session : sessions_) {
+        session->Close();
+    }
+    if (tick_session_) {
+        tick_session_->Close();
+    }
+}
+
+void PlayerSimulator::StartPlayPhase() {
+    const auto now = Clock::now();
+    report_.join_duration = now - phase_start_;
+    report_.joined_players = authorizations_.size();
+    phase_ = Phase::PLAY;
+    phase_start_ = now;
+
+    // Соединение, завершившее фазу присоединения, продолжит работу само
+    for (const auto& session : sessions_) {
+        if (session->IsIdle()) {
+            session->Resume();
+        }
+    }
+    if (tick_session_) {
+        tick_session_->Resume();
+    }
+}
+
+}  // namespace loadgen
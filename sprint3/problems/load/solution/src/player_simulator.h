@@ -0,0 +1,123 @@
+#pragma once
+#include "sdk.h"
+// boost.beast будет использовать std::string_view вместо boost::string_view
+#define BOOST_BEAST_USE_STD_STRING_VIEW
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <array>
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "histogram.h"
+
+namespace loadgen {
+
+namespace net = boost::asio;
+using tcp = net::ip::tcp;
+
+// Эндпоинты игрового API, для которых собирается статистика
+enum class GameEndpoint { JOIN, ACTION, STATE, TICK };
+
+constexpr size_t GAME_ENDPOINT_COUNT = 4;
+
+std::string_view GetEndpointTarget(GameEndpoint endpoint) noexcept;
+
+struct SimulatorConfig {
+    std::string map_id = "map1";
+    // Количество игроков, которые присоединятся к игре
+    size_t players = 1000;
+    // Количество соединений, по которым игроки отправляют запросы
+    size_t connections = 16;
+    // Длительность игровой фазы после того, как все игроки присоединились
+    std::chrono::milliseconds duration{10'000};
+    // Доля запросов /player/action среди запросов игроков. Остальные - запросы /game/state
+    double action_share = 0.5;
+    // Период отправки /game/tick. Если не задан, предполагается, что время в игре
+    // обновляет сам сервер
+    std::optional<std::chrono::milliseconds> tick_period = std::chrono::milliseconds{50};
+    std::chrono::milliseconds timeout{10'000};
+    unsigned seed = 0;
+};
+
+struct EndpointStats {
+    LatencyHistogram latency;
+    std::uint64_t errors = 0;
+};
+
+struct SimulatorReport {
+    std::array<EndpointStats, GAME_ENDPOINT_COUNT> endpoints;
+    size_t joined_players = 0;
+    std::chrono::steady_clock::duration join_duration{};
+    std::chrono::steady_clock::duration play_duration{};
+
+    const EndpointStats& operator[](GameEndpoint endpoint) const noexcept {
+        return endpoints[static_cast<size_t>(endpoint)];
+    }
+    EndpointStats& operator[](GameEndpoint endpoint) noexcept {
+        return endpoints[static_cast<size_t>(endpoint)];
+    }
+};
+
+/*
+ * Имитирует игроков, играющих через HTTP API игрового сервера.
+ * Сначала все игроки присоединяются к игре через /api/v1/game/join, затем в течение
+ * заданного времени случайные игроки отправляют команды /api/v1/game/player/action и
+ * запрашивают /api/v1/game/state. Если задан tick_period, по отдельному соединению
+ * периодически отправляется /api/v1/game/tick (сервер должен быть запущен в тестовом режиме).
+ * Каждое соединение отправляет следующий запрос сразу после получения ответа на предыдущий.
+ * Все операции выполняются в одном потоке, вызывающем io_context::run.
+ */
+class PlayerSimulator {
+public:
+    PlayerSimulator(net::io_context& io, tcp::endpoint endpoint, SimulatorConfig config);
+    ~PlayerSimulator();
+
+    PlayerSimulator(const PlayerSimulator&) = delete;
+    PlayerSimulator& operator=(const PlayerSimulator&) = delete;
+
+    void Start();
+
+    const SimulatorReport& GetReport() const noexcept {
+        return report_;
+    }
+
+private:
+    class Session;
+    struct GameRequest;
+
+    enum class Phase { JOIN, PLAY, FINISHED };
+
+    // Возвращает следующий запрос для соединения игроков или nullopt, если соединение
+    // должно ждать смены фазы
+    std::optional<GameRequest> NextPlayerRequest();
+    std::optional<GameRequest> NextTickRequest();
+    void OnResponse(const GameRequest& request, unsigned status, std::string_view body,
+                    std::chrono::steady_clock::duration latency);
+    void OnError(const GameRequest& request);
+    void OnSessionIdle();
+    void StartPlayPhase();
+
+    net::io_context& io_;
+    tcp::endpoint endpoint_;
+    SimulatorConfig config_;
+    std::mt19937 random_engine_;
+    std::vector<std::shared_ptr<Session>> sessions_;
+    std::shared_ptr<Session> tick_session_;
+
+    Phase phase_ = Phase::JOIN;
+    std::chrono::steady_clock::time_point phase_start_;
+    // Заголовки Authorization присоединившихся игроков
+    std::vector<std::string> authorizations_;
+    size_t join_requests_sent_ = 0;
+    size_t join_responses_ = 0;
+    size_t idle_sessions_ = 0;
+    SimulatorReport report_;
+};
+
+}  // namespace loadgen
@@ -0,0 +1,175 @@
+#include "schedule.h"
+
+#include <charconv>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+namespace loadgen {
+
+using namespace std::literals;
+using std::chrono::nanoseconds;
+
+namespace {
+
+std::string_view Trim(std::string_view str) {
+    const size_t begin = str.find_first_not_of(" \t"sv);
+    if (begin == std::string_view::npos) {
+        return {};
+    }
+    return str.substr(begin, str.find_last_not_of(" \t"sv) - begin + 1);
+}
+
+double ParseNumber(std::string_view str) {
+    str = Trim(str);
+    double value = 0;
+    const auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), value);
+    if (ec != std::errc{} || ptr != str.data() + str.size() || value < 0) {
+        throw std::invalid_argument("Invalid number in load schedule: "s.append(str));
+    }
+    return value;
+}
+
+nanoseconds ParseDuration(std::string_view str) {
+    str = Trim(str);
+    const size_t suffix_pos = str.find_first_not_of("0123456789."sv);
+    if (suffix_pos == 0 || suffix_pos == std::string_view::npos) {
+        throw std::invalid_argument("Invalid duration in load schedule: "s.append(str));
+    }
+    const double value = ParseNumber(str.substr(0, suffix_pos));
+    const std::string_view suffix = str.substr(suffix_pos);
+
+    using Seconds = std::chrono::duration<double>;
+    Seconds result;
+    if (suffix == "ms"sv) {
+        result = Seconds{value / 1000};
+    } else if (suffix == "s"sv) {
+        result = Seconds{value};
+    } else if (suffix == "m"sv) {
+        result = Seconds{value * 60};
+    } else if (suffix == "h"sv) {
+        result = Seconds{value * 3600};
+    } else {
+        throw std::invalid_argument("Invalid duration suffix in load schedule: "s.append(str));
+    }
+    return std::chrono::duration_cast<nanoseconds>(result);
+}
+
+std::vector<std::string_view> SplitArgs(std::string_view args) {
+    std::vector<std::string_view> result;
+    while (true) {
+        const size_t comma_pos = args.find(',');
+        result.push_back(args.substr(0, comma_pos));
+        if (comma_pos == std::string_view::npos) {
+            return result;
+        }
+        args.remove_prefix(comma_pos + 1);
+    }
+}
+
+void AppendSteps(std::string_view name, std::string_view args_str, std::vector<LoadStep>& steps) {
+    const auto args = SplitArgs(args_str);
+    const auto check_arg_count = [&](size_t count) {
+        if (args.size() != count) {
+            throw std::invalid_argument("Invalid number of arguments for "s.append(name));
+        }
+    };
+
+    if (name == "line"sv) {
+        check_arg_count(3);
+        steps.push_back({ParseNumber(args[0]), ParseNumber(args[1]), ParseDuration(args[2])});
+    } else if (name == "const"sv) {
+        check_arg_count(2);
+        const double rps = ParseNumber(args[0]);
+        steps.push_back({rps, rps, ParseDuration(args[1])});
+    } else if (name == "step"sv) {
+        check_arg_count(4);
+        const double from = ParseNumber(args[0]);
+        const double to = ParseNumber(args[1]);
+        const double step = ParseNumber(args[2]);
+        const nanoseconds duration = ParseDuration(args[3]);
+        if (step == 0) {
+            throw std::invalid_argument("Step must be positive");
+        }
+        // Ступени идут от from к to в обе стороны, последняя ступень равна to
+        const double direction = to >= from ? 1 : -1;
+        for (double rps = from; (to - rps) * direction > -step / 2; rps += step * direction) {
+            steps.push_back({rps, rps, duration});
+        }
+    } else {
+        throw std::invalid_argument("Unknown load schedule step: "s.append(name));
+    }
+}
+
+}  // namespace
+
+LoadSchedule::LoadSchedule(std::vector<LoadStep> steps)
+    : steps_{std::move(steps)} {
+}
+
+LoadSchedule LoadSchedule::Parse(std::string_view str) {
+    std::vector<LoadStep> steps;
+    while (!(str = Trim(str)).empty()) {
+        const size_t open_pos = str.find('(');
+        const size_t close_pos = str.find(')');
+        if (open_pos == std::string_view::npos || close_pos == std::string_view::npos
+            || close_pos < open_pos) {
+            throw std::invalid_argument("Invalid load schedule: "s.append(str));
+        }
+        AppendSteps(Trim(str.substr(0, open_pos)),
+                    str.substr(open_pos + 1, close_pos - open_pos - 1), steps);
+        str.remove_prefix(close_pos + 1);
+    }
+    if (steps.empty()) {
+        throw std::invalid_argument("Load schedule is empty");
+    }
+    return LoadSchedule{std::move(steps)};
+}
+
+std::optional<nanoseconds> LoadSchedule::NextShot() {
+    using Seconds = std::chrono::duration<double>;
+
+    while (current_step_ < steps_.size()) {
+        const LoadStep& step = steps_[current_step_];
+        const double duration = Seconds{step.duration}.count();
+
+        /*
+         * Количество выстрелов к моменту t от начала участка:
+         * N(t) = a*t + (b - a) * t^2 / (2 * T)
+         * Момент k-го выстрела - корень уравнения N(t) = k
+         */
+        const double a = step.start_rps;
+        const double c = duration > 0 ? (step.end_rps - step.start_rps) / (2 * duration) : 0;
+        const double k = static_cast<double>(step_shots_);
+
+        double t = -1;
+        if (std::abs(c) < 1e-12) {
+            if (a > 0) {
+                t = k / a;
+            }
+        } else if (const double discriminant = a * a + 4 * c * k; discriminant >= 0) {
+            t = (std::sqrt(discriminant) - a) / (2 * c);
+        }
+
+        if (t >= 0 && t < duration) {
+            ++step_shots_;
+            return step_start_ + std::chrono::duration_cast<nanoseconds>(Seconds{t});
+        }
+
+        // Участок закончился, переходим к следующему
+        step_start_ += step.duration;
+        step_shots_ = 0;
+        ++current_step_;
+    }
+    return std::nullopt;
+}
+
+nanoseconds LoadSchedule::GetDuration() const noexcept {
+    nanoseconds total{};
+    for (const auto& step : steps_) {
+        total += step.duration;
+    }
+    return total;
+}
+
+}  // namespace loadgen
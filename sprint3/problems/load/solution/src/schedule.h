@@ -0,0 +1,55 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace loadgen {
+
+// Участок профиля нагрузки, на котором интенсивность линейно меняется от start_rps до end_rps
+struct LoadStep {
+    double start_rps = 0;
+    double end_rps = 0;
+    std::chrono::nanoseconds duration{};
+};
+
+/*
+ * Профиль нагрузки в открытом цикле: моменты отправки запросов не зависят от того,
+ * как быстро сервер отвечает на предыдущие.
+ */
+class LoadSchedule {
+public:
+    explicit LoadSchedule(std::vector<LoadStep> steps);
+
+    /*
+     * Разбирает профиль в формате schedule Яндекс.Танка. Участки перечисляются через пробел:
+     * - line(a, b, dur) - линейный рост интенсивности от a до b rps за время dur
+     * - const(a, dur) - постоянная интенсивность a rps в течение dur
+     * - step(a, b, s, dur) - ступенчатый рост от a до b rps с шагом s, каждая ступень длится dur
+     * Длительность задаётся числом с суффиксом ms, s, m или h, например 1m или 30s.
+     * В случае ошибки выбрасывает исключение std::invalid_argument
+     */
+    static LoadSchedule Parse(std::string_view str);
+
+    // Возвращает момент отправки следующего запроса относительно начала стрельбы
+    // либо std::nullopt, если профиль закончился
+    std::optional<std::chrono::nanoseconds> NextShot();
+
+    std::chrono::nanoseconds GetDuration() const noexcept;
+
+    const std::vector<LoadStep>& GetSteps() const noexcept {
+        return steps_;
+    }
+
+private:
+    std::vector<LoadStep> steps_;
+    size_t current_step_ = 0;
+    // Время начала текущего участка
+    std::chrono::nanoseconds step_start_{};
+    // Количество выстрелов, сделанных на текущем участке
+    std::uint64_t step_shots_ = 0;
+};
+
+}  // namespace loadgen
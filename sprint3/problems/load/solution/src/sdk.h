@@ -0,0 +1,4 @@
+#pragma once
+#ifdef WIN32
+#include <sdkddkver.h>
+#endif
@@ -0,0 +1,115 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <sstream>
+#include <stdexcept>
+
+#include "../src/ammo.h"
+#include "../src/histogram.h"
+#include "../src/schedule.h"
+
+using namespace std::literals;
+using namespace loadgen;
+
+TEST_CASE("Ammo file parsing", "[Ammo]") {
+    std::istringstream input{
+        "[Connection: close]\n"
+        "[Host: cppserver]\n"
+        "[Cookie: None]\n"
+        "/api/v1/maps \n"
+        "\n"
+        "/api/v1/maps/map1 tag\n"s};
+    const Ammo ammo = ParseAmmo(input);
+
+    CHECK(ammo.targets == std::vector{"/api/v1/maps"s, "/api/v1/maps/map1"s});
+    CHECK(ammo.headers.size() == 3);
+    CHECK(ammo.GetHeader("host"sv) == "cppserver"s);
+    CHECK(ammo.GetHeader("Connection"sv) == "close"s);
+    CHECK(ammo.GetHeader("Accept"sv).empty());
+
+    std::istringstream no_targets{"[Host: cppserver]\n"s};
+    CHECK_THROWS_AS(ParseAmmo(no_targets), std::invalid_argument);
+
+    std::istringstream bad_header{"[Host cppserver]\n/\n"s};
+    CHECK_THROWS_AS(ParseAmmo(bad_header), std::invalid_argument);
+}
+
+TEST_CASE("Load schedule parsing", "[LoadSchedule]") {
+    const auto schedule = LoadSchedule::Parse("line(5, 30, 1m) const(10, 500ms) step(5, 15, 5, 2s)"sv);
+    const auto& steps = schedule.GetSteps();
+    REQUIRE(steps.size() == 5);
+    CHECK(steps[0].start_rps == 5);
+    CHECK(steps[0].end_rps == 30);
+    CHECK(steps[0].duration == 1min);
+    CHECK(steps[1].start_rps == 10);
+    CHECK(steps[1].duration == 500ms);
+    CHECK(steps[2].start_rps == 5);
+    CHECK(steps[3].start_rps == 10);
+    CHECK(steps[4].end_rps == 15);
+    CHECK(schedule.GetDuration() == 1min + 500ms + 6s);
+
+    CHECK_THROWS_AS(LoadSchedule::Parse(""sv), std::invalid_argument);
+    CHECK_THROWS_AS(LoadSchedule::Parse("line(5, 30)"sv), std::invalid_argument);
+    CHECK_THROWS_AS(LoadSchedule::Parse("const(5, 30x)"sv), std::invalid_argument);
+    CHECK_THROWS_AS(LoadSchedule::Parse("wave(1, 2s)"sv), std::invalid_argument);
+}
+
+TEST_CASE("Load schedule produces open-loop shot times", "[LoadSchedule]") {
+    SECTION("constant load") {
+        auto schedule = LoadSchedule::Parse("const(10, 1s)"sv);
+        std::vector<std::chrono::nanoseconds> shots;
+        while (auto shot = schedule.NextShot()) {
+            shots.push_back(*shot);
+        }
+        REQUIRE(shots.size() == 10);
+        CHECK(shots.front() == 0ms);
+        CHECK(shots.back() == 900ms);
+    }
+
+    SECTION("linear load") {
+        // Среднее значение интенсивности - 17.5 rps, за минуту должно быть 1050 выстрелов
+        auto schedule = LoadSchedule::Parse("line(5, 30, 1m)"sv);
+        size_t count = 0;
+        std::chrono::nanoseconds prev{-1};
+        while (auto shot = schedule.NextShot()) {
+            CHECK(*shot > prev);
+            CHECK(*shot < 1min);
+            prev = *shot;
+            ++count;
+        }
+        CHECK(count == 1050);
+    }
+
+    SECTION("pause") {
+        auto schedule = LoadSchedule::Parse("const(0, 1s) const(1, 1s)"sv);
+        CHECK(schedule.NextShot() == 1s);
+        CHECK(!schedule.NextShot());
+    }
+}
+
+TEST_CASE("Latency histogram percentiles", "[LatencyHistogram]") {
+    LatencyHistogram histogram;
+    CHECK(histogram.GetValueAtPercentile(99) == 0us);
+
+    for (int i = 1; i <= 1000; ++i) {
+        histogram.Record(std::chrono::milliseconds{i});
+    }
+    CHECK(histogram.GetCount() == 1000);
+    CHECK(histogram.GetMin() == 1ms);
+    CHECK(histogram.GetMax() == 1000ms);
+
+    // Относительная погрешность не превышает 1%
+    const auto check_close = [](auto actual, auto expected) {
+        const auto diff = actual > expected ? actual - expected : expected - actual;
+        CHECK(diff * 100 <= expected);
+    };
+    check_close(histogram.GetMean(), std::chrono::microseconds{500500});
+    check_close(histogram.GetValueAtPercentile(50), std::chrono::microseconds{500ms});
+    check_close(histogram.GetValueAtPercentile(99), std::chrono::microseconds{990ms});
+    CHECK(histogram.GetValueAtPercentile(100) == 1000ms);
+
+    LatencyHistogram other;
+    other.Record(5s);
+    histogram.Merge(other);
+    CHECK(histogram.GetCount() == 1001);
+    CHECK(histogram.GetMax() == 5s);
+}
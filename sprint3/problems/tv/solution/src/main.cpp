@@ -0,0 +1,26 @@
+#include <iostream>
+
+#include "controller.h"
+
+int main(int argc, const char* argv[]) {
+    using namespace std::literals;
+
+    TV tv;
+    Menu menu{std::cin, std::cout};
+    Controller controller{tv, menu};
+    menu.AddAction("Exit"s, {}, "Exits the program"s, [](auto&&...) {
+        return false;
+    });
+    menu.AddAction("Help", {}, "Shows instructions"s, [&menu](auto&&...) {
+        menu.ShowInstructions();
+        return true;
+    });
+    // При запуске с ключом --batch команды читаются из стандартного ввода блоками
+    if (argc > 1 && argv[1] == "--batch"sv) {
+        std::ios::sync_with_stdio(false);
+        menu.RunBatch();
+        return 0;
+    }
+    menu.ShowInstructions();
+    menu.Run();
+}
@@ -0,0 +1,84 @@
+#define BOOST_TEST_MODULE TV tests
+#include <boost/test/unit_test.hpp>
+#include <iostream>
+#include <sstream>
+
+#include "../src/tv.h"
+#include "boost_test_helpers.h"
+
+struct TVFixture {
+    TV tv;
+};
+BOOST_FIXTURE_TEST_SUITE(TV_, TVFixture)
+BOOST_AUTO_TEST_CASE(is_off_by_default) {
+    // Внутри теста поля структуры TVFixture доступны по их имени
+    BOOST_TEST(!tv.IsTurnedOn());
+}
+BOOST_AUTO_TEST_CASE(doesnt_show_any_channel_by_default) {
+    BOOST_TEST(!tv.GetChannel().has_value());
+}
+BOOST_AUTO_TEST_CASE(cant_select_any_channel_when_it_is_off) {
+    BOOST_CHECK_THROW(tv.SelectChannel(10), std::logic_error);
+    BOOST_TEST(tv.GetChannel() == std::nullopt);
+    tv.TurnOn();
+    BOOST_TEST(tv.GetChannel() == 1);
+}
+BOOST_AUTO_TEST_CASE(cant_select_last_viewed_channel_when_it_is_off) {
+    BOOST_CHECK_THROW(tv.SelectLastViewedChannel(), std::logic_error);
+}
+
+// Тестовый стенд "Включенный телевизор" унаследован от TVFixture.
+struct TurnedOnTVFixture : TVFixture {
+    // В конструкторе выполняем донастройку унаследованного поля tv
+    TurnedOnTVFixture() {
+        tv.TurnOn();
+    }
+};
+// (Телевизор) после включения
+BOOST_FIXTURE_TEST_SUITE(After_turning_on_, TurnedOnTVFixture)
+// показывает канал #1
+BOOST_AUTO_TEST_CASE(shows_channel_1) {
+    BOOST_TEST(tv.IsTurnedOn());
+    BOOST_TEST(tv.GetChannel() == 1);
+}
+// Может быть выключен
+BOOST_AUTO_TEST_CASE(can_be_turned_off) {
+    tv.TurnOff();
+    BOOST_TEST(!tv.IsTurnedOn());
+    BOOST_TEST(tv.GetChannel() == std::nullopt);
+}
+// Может выбирать каналы с 1 по 99
+BOOST_AUTO_TEST_CASE(can_select_channel_from_1_to_99) {
+    tv.SelectChannel(TV::MIN_CHANNEL);
+    BOOST_TEST(tv.GetChannel() == TV::MIN_CHANNEL);
+    tv.SelectChannel(42);
+    BOOST_TEST(tv.GetChannel() == 42);
+    tv.SelectChannel(TV::MAX_CHANNEL);
+    BOOST_TEST(tv.GetChannel() == TV::MAX_CHANNEL);
+}
+// Не выбирает каналы за пределами диапазона
+BOOST_AUTO_TEST_CASE(cant_select_channel_out_of_range) {
+    tv.SelectChannel(42);
+    BOOST_CHECK_THROW(tv.SelectChannel(TV::MIN_CHANNEL - 1), std::out_of_range);
+    BOOST_CHECK_THROW(tv.SelectChannel(TV::MAX_CHANNEL + 1), std::out_of_range);
+    BOOST_TEST(tv.GetChannel() == 42);
+}
+// Переключает два последних выбранных канала
+BOOST_AUTO_TEST_CASE(switches_between_two_last_viewed_channels) {
+    tv.SelectChannel(42);
+    // Повторный выбор того же канала не меняет предыдущий канал
+    tv.SelectChannel(42);
+    tv.SelectLastViewedChannel();
+    BOOST_TEST(tv.GetChannel() == 1);
+    tv.SelectLastViewedChannel();
+    BOOST_TEST(tv.GetChannel() == 42);
+}
+// Помнит выбранный канал после выключения
+BOOST_AUTO_TEST_CASE(restores_channel_after_turning_off_and_on) {
+    tv.SelectChannel(42);
+    tv.TurnOff();
+    tv.TurnOn();
+    BOOST_TEST(tv.GetChannel() == 42);
+}
+BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,130 @@
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+
+#include "../src/controller.h"
+
+using namespace std::literals;
+
+class ControllerWithTurnedOffTV : public testing::Test {
+protected:
+    void SetUp() override {
+        ASSERT_FALSE(tv_.IsTurnedOn());
+    }
+
+    void RunMenuCommand(std::string command) {
+        input_.str(std::move(command));
+        input_.clear();
+        menu_.Run();
+    }
+
+    void ExpectExtraArgumentsErrorInOutput(std::string_view command) const {
+        ExpectOutput(
+            "Error: the "s.append(command).append(" command does not require any arguments\n"sv));
+    }
+
+    void ExpectEmptyOutput() const {
+        ExpectOutput({});
+    }
+
+    void ExpectOutput(std::string_view expected) const {
+        // В g++ 10.3 не реализован метод ostringstream::view(), поэтому приходится
+        // использовать метод str()
+        EXPECT_EQ(output_.str(), std::string{expected});
+    }
+
+    TV tv_;
+    std::istringstream input_;
+    std::ostringstream output_;
+    Menu menu_{input_, output_};
+    Controller controller_{tv_, menu_};
+};
+
+TEST_F(ControllerWithTurnedOffTV, OnInfoCommandPrintsThatTVIsOff) {
+    input_.str("Info"s);
+    menu_.Run();
+    ExpectOutput("TV is turned off\n"sv);
+    EXPECT_FALSE(tv_.IsTurnedOn());
+}
+TEST_F(ControllerWithTurnedOffTV, OnInfoCommandPrintsErrorMessageIfCommandHasAnyArgs) {
+    RunMenuCommand("Info some extra args"s);
+    EXPECT_FALSE(tv_.IsTurnedOn());
+    ExpectExtraArgumentsErrorInOutput("Info"sv);
+}
+TEST_F(ControllerWithTurnedOffTV, OnInfoCommandWithTrailingSpacesPrintsThatTVIsOff) {
+    input_.str("Info  "s);
+    menu_.Run();
+    ExpectOutput("TV is turned off\n"sv);
+}
+TEST_F(ControllerWithTurnedOffTV, OnTurnOnCommandTurnsTVOn) {
+    RunMenuCommand("TurnOn"s);
+    EXPECT_TRUE(tv_.IsTurnedOn());
+    ExpectEmptyOutput();
+}
+TEST_F(ControllerWithTurnedOffTV, OnTurnOnCommandPrintsErrorMessageIfCommandHasAnyArgs) {
+    RunMenuCommand("TurnOn some extra args"s);
+    EXPECT_FALSE(tv_.IsTurnedOn());
+    ExpectExtraArgumentsErrorInOutput("TurnOn"sv);
+}
+TEST_F(ControllerWithTurnedOffTV, InBatchModeExecutesAllCommands) {
+    input_.str("Info\nTurnOff extra\n\nUnknown\nTurnOn"s);
+    menu_.RunBatch();
+    EXPECT_TRUE(tv_.IsTurnedOn());
+    ExpectOutput(
+        "TV is turned off\n"
+        "Error: the TurnOff command does not require any arguments\n"
+        "Invalid command\n"
+        "Command 'Unknown' has not been found.\n"sv);
+}
+TEST_F(ControllerWithTurnedOffTV, OnSelectChannelPrintsThatTVIsOff) {
+    RunMenuCommand("SelectChannel 5"s);
+    ExpectOutput("TV is turned off\n"sv);
+}
+TEST_F(ControllerWithTurnedOffTV, OnSelectPreviousChannelPrintsThatTVIsOff) {
+    RunMenuCommand("SelectPreviousChannel"s);
+    ExpectOutput("TV is turned off\n"sv);
+}
+
+//-----------------------------------------------------------------------------------
+
+class ControllerWithTurnedOnTV : public ControllerWithTurnedOffTV {
+protected:
+    void SetUp() override {
+        tv_.TurnOn();
+    }
+};
+
+TEST_F(ControllerWithTurnedOnTV, OnTurnOffCommandTurnsTVOff) {
+    RunMenuCommand("TurnOff"s);
+    EXPECT_FALSE(tv_.IsTurnedOn());
+    ExpectEmptyOutput();
+}
+TEST_F(ControllerWithTurnedOnTV, OnTurnOffCommandPrintsErrorMessageIfCommandHasAnyArgs) {
+    RunMenuCommand("TurnOff some extra args"s);
+    EXPECT_TRUE(tv_.IsTurnedOn());
+    ExpectExtraArgumentsErrorInOutput("TurnOff"sv);
+}
+TEST_F(ControllerWithTurnedOnTV, OnInfoPrintsCurrentChannel) {
+    tv_.SelectChannel(42);
+    RunMenuCommand("Info"s);
+    ExpectOutput("TV is turned on\nChannel number is 42\n"sv);
+}
+TEST_F(ControllerWithTurnedOnTV, OnSelectChannelSelectsChannel) {
+    RunMenuCommand("SelectChannel 42 "s);
+    EXPECT_THAT(tv_.GetChannel(), testing::Optional(42));
+    ExpectEmptyOutput();
+}
+TEST_F(ControllerWithTurnedOnTV, OnSelectChannelWithInvalidChannelPrintsErrorMessage) {
+    RunMenuCommand("SelectChannel 4x\nSelectChannel\nSelectChannel 4 2"s);
+    EXPECT_THAT(tv_.GetChannel(), testing::Optional(1));
+    ExpectOutput("Invalid channel\nInvalid channel\nInvalid channel\n"sv);
+}
+TEST_F(ControllerWithTurnedOnTV, OnSelectChannelOutOfRangePrintsErrorMessage) {
+    RunMenuCommand("SelectChannel 100"s);
+    EXPECT_THAT(tv_.GetChannel(), testing::Optional(1));
+    ExpectOutput("Channel is out of range\n"sv);
+}
+TEST_F(ControllerWithTurnedOnTV, OnSelectPreviousChannelSelectsPreviousChannel) {
+    RunMenuCommand("SelectChannel 42\nSelectPreviousChannel\nSelectPreviousChannel extra"s);
+    EXPECT_THAT(tv_.GetChannel(), testing::Optional(1));
+    ExpectExtraArgumentsErrorInOutput("SelectPreviousChannel"sv);
+}
@@ -0,0 +1,72 @@
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+
+#include "../src/tv.h"
+
+// Тестовый стенд "Телевизор по умолчанию"
+class TVByDefault : public testing::Test {
+protected:
+    TV tv_;
+};
+TEST_F(TVByDefault, IsOff) {
+    EXPECT_FALSE(tv_.IsTurnedOn());
+}
+TEST_F(TVByDefault, DoesntShowAChannelWhenItIsOff) {
+    EXPECT_FALSE(tv_.GetChannel().has_value());
+}
+TEST_F(TVByDefault, CantSelectAnyChannel) {
+    EXPECT_THROW(tv_.SelectChannel(10), std::logic_error);
+    EXPECT_EQ(tv_.GetChannel(), std::nullopt);
+    tv_.TurnOn();
+    EXPECT_THAT(tv_.GetChannel(), testing::Optional(1));
+}
+TEST_F(TVByDefault, CantSelectLastViewedChannel) {
+    EXPECT_THROW(tv_.SelectLastViewedChannel(), std::logic_error);
+}
+
+// Тестовый стенд "Включенный телевизор"
+class TurnedOnTV : public TVByDefault {
+protected:
+    void SetUp() override {
+        tv_.TurnOn();
+    }
+};
+TEST_F(TurnedOnTV, ShowsChannel1) {
+    EXPECT_TRUE(tv_.IsTurnedOn());
+    EXPECT_THAT(tv_.GetChannel(), testing::Optional(1));
+}
+TEST_F(TurnedOnTV, AfterTurningOffTurnsOffAndDoesntShowAnyChannel) {
+    tv_.TurnOff();
+    EXPECT_FALSE(tv_.IsTurnedOn());
+    // Сравнение с nullopt в GoogleTest выполняется так:
+    EXPECT_EQ(tv_.GetChannel(), std::nullopt);
+}
+TEST_F(TurnedOnTV, CanSelectChannelFrom1To99) {
+    tv_.SelectChannel(TV::MIN_CHANNEL);
+    EXPECT_THAT(tv_.GetChannel(), testing::Optional(TV::MIN_CHANNEL));
+    tv_.SelectChannel(42);
+    EXPECT_THAT(tv_.GetChannel(), testing::Optional(42));
+    tv_.SelectChannel(TV::MAX_CHANNEL);
+    EXPECT_THAT(tv_.GetChannel(), testing::Optional(TV::MAX_CHANNEL));
+}
+TEST_F(TurnedOnTV, CantSelectChannelOutOfRange) {
+    tv_.SelectChannel(42);
+    EXPECT_THROW(tv_.SelectChannel(TV::MIN_CHANNEL - 1), std::out_of_range);
+    EXPECT_THROW(tv_.SelectChannel(TV::MAX_CHANNEL + 1), std::out_of_range);
+    EXPECT_THAT(tv_.GetChannel(), testing::Optional(42));
+}
+TEST_F(TurnedOnTV, SwitchesBetweenTwoLastViewedChannels) {
+    tv_.SelectChannel(42);
+    // Повторный выбор того же канала не меняет предыдущий канал
+    tv_.SelectChannel(42);
+    tv_.SelectLastViewedChannel();
+    EXPECT_THAT(tv_.GetChannel(), testing::Optional(1));
+    tv_.SelectLastViewedChannel();
+    EXPECT_THAT(tv_.GetChannel(), testing::Optional(42));
+}
+TEST_F(TurnedOnTV, RestoresChannelAfterTurningOffAndOn) {
+    tv_.SelectChannel(42);
+    tv_.TurnOff();
+    tv_.TurnOn();
+    EXPECT_THAT(tv_.GetChannel(), testing::Optional(42));
+}
@@ -0,0 +1,99 @@
+#include "query_string.h"
+
+namespace {
+
+// Сравнивает закодированное имя параметра с декодированным именем name, декодируя символы
+// по ходу сравнения. Не выделяет память и не выбрасывает исключений: имя с некорректной
+// %-последовательностью ни с чем не совпадает, чтобы оно не мешало искать остальные параметры
+bool NameEquals(std::string_view encoded_name, std::string_view name) noexcept {
+    size_t pos = 0;
+    for (const char expected : name) {
+        if (pos == encoded_name.size()) {
+            return false;
+        }
+        char c = encoded_name[pos++];
+        if (c == '+') {
+            c = ' ';
+        } else if (c == '%') {
+            if (encoded_name.size() - pos < 2) {
+                return false;
+            }
+            const int hi = HexDigitValue(encoded_name[pos]);
+            const int lo = HexDigitValue(encoded_name[pos + 1]);
+            if (hi < 0 || lo < 0) {
+                return false;
+            }
+            c = static_cast<char>(hi * 16 + lo);
+            pos += 2;
+        }
+        if (c != expected) {
+            return false;
+        }
+    }
+    return pos == encoded_name.size();
+}
+
+}  // namespace
+
+QueryString::QueryString(std::string_view target) {
+    const size_t query_start = target.find('?');
+    path_ = target.substr(0, query_start);
+    if (query_start == std::string_view::npos) {
+        return;
+    }
+
+    std::string_view query = target.substr(query_start + 1);
+    // Фрагмент URL к строке запроса не относится
+    query = query.substr(0, query.find('#'));
+
+    while (!query.empty()) {
+        const size_t param_end = query.find('&');
+        const std::string_view param = query.substr(0, param_end);
+        query = param_end == std::string_view::npos ? std::string_view{}
+                                                    : query.substr(param_end + 1);
+        if (param.empty()) {
+            continue;
+        }
+        if (size_ == params_.size()) {
+            throw std::invalid_argument("Too many query parameters");
+        }
+
+        const size_t eq_pos = param.find('=');
+        if (eq_pos == std::string_view::npos) {
+            params_[size_++] = {param, {}};
+        } else {
+            params_[size_++] = {param.substr(0, eq_pos), param.substr(eq_pos + 1)};
+        }
+    }
+}
+
+std::optional<std::string_view> QueryString::GetRaw(std::string_view name) const {
+    if (const Param* param = Find(name)) {
+        return param->value;
+    }
+    return std::nullopt;
+}
+
+std::optional<std::string_view> QueryString::GetView(std::string_view name,
+                                                     std::span<char> buffer) const {
+    if (const Param* param = Find(name)) {
+        return UrlDecodeView(param->value, buffer);
+    }
+    return std::nullopt;
+}
+
+std::optional<std::string> QueryString::GetString(std::string_view name) const {
+    if (const Param* param = Find(name)) {
+        return UrlDecode(param->value);
+    }
+    return std::nullopt;
+}
+
+const QueryString::Param* QueryString::Find(std::string_view name) const {
+    for (const Param& param : *this) {
+        if (NameEquals(param.name, name)) {
+            return &param;
+        }
+    }
+    return nullptr;
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <array>
+#include <charconv>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "urldecode.h"
+
+/*
+Разобранная строка запроса URL, например "/api/v1/game/records?start=0&maxItems=100".
+Не копирует данные: имена и значения параметров хранятся в виде string_view на исходную строку,
+поэтому она должна жить дольше объекта QueryString.
+Значения URL-декодируются только при обращении к ним и только если содержат %-последовательности
+или символы +.
+Параметры хранятся в массиве фиксированного размера. Если параметров больше MAX_PARAMS,
+конструктор выбрасывает исключение std::invalid_argument
+*/
+class QueryString {
+public:
+    static constexpr size_t MAX_PARAMS = 16;
+
+    // Параметр в том виде, в котором он записан в URL (без декодирования)
+    struct Param {
+        std::string_view name;
+        std::string_view value;
+    };
+
+    using const_iterator = const Param*;
+
+    QueryString() = default;
+
+    // Разбирает target. Часть до символа ? считается путём, остаток - строкой запроса.
+    // Пустые параметры ("a=1&&b=2") пропускаются, параметр без = получает пустое значение
+    explicit QueryString(std::string_view target);
+
+    // Возвращает путь - часть target до символа ?
+    std::string_view GetPath() const noexcept {
+        return path_;
+    }
+
+    size_t Size() const noexcept {
+        return size_;
+    }
+
+    bool Empty() const noexcept {
+        return size_ == 0;
+    }
+
+    const_iterator begin() const noexcept {
+        return params_.data();
+    }
+
+    const_iterator end() const noexcept {
+        return params_.data() + size_;
+    }
+
+    bool Contains(std::string_view name) const {
+        return Find(name) != nullptr;
+    }
+
+    // Возвращает значение первого параметра с именем name без декодирования
+    std::optional<std::string_view> GetRaw(std::string_view name) const;
+
+    // Возвращает декодированное значение параметра name.
+    // Если значение не требует декодирования, возвращается string_view на исходную строку,
+    // иначе значение декодируется в buffer, размер которого должен быть не меньше длины значения
+    std::optional<std::string_view> GetView(std::string_view name, std::span<char> buffer) const;
+
+    // Возвращает декодированное значение параметра name в виде строки
+    std::optional<std::string> GetString(std::string_view name) const;
+
+    /*
+    Возвращает значение параметра name, преобразованное в целое число или число с плавающей
+    запятой при помощи std::from_chars.
+    Если параметр отсутствует, возвращает std::nullopt.
+    Если значение не является числом целиком, выбрасывает исключение std::invalid_argument
+    */
+    template <typename T>
+    std::optional<T> GetNumber(std::string_view name) const {
+        static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>);
+
+        // Числа короткие, поэтому декодируем их в буфер на стеке
+        std::array<char, MAX_NUMBER_LENGTH> buffer;
+        const Param* param = Find(name);
+        if (!param) {
+            return std::nullopt;
+        }
+        if (param->value.size() > buffer.size()) {
+            throw std::invalid_argument("Query parameter is not a number");
+        }
+        const std::string_view value = UrlDecodeView(param->value, buffer);
+
+        T result{};
+        const auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), result);
+        if (ec != std::errc{} || ptr != value.data() + value.size()) {
+            throw std::invalid_argument("Query parameter is not a number");
+        }
+        return result;
+    }
+
+private:
+    static constexpr size_t MAX_NUMBER_LENGTH = 64;
+
+    const Param* Find(std::string_view name) const;
+
+    std::string_view path_;
+    std::array<Param, MAX_PARAMS> params_;
+    size_t size_ = 0;
+};
@@ -0,0 +1,76 @@
+#include "urldecode.h"
+
+#include <charconv>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+// Декодирует str в out. Так как позиция записи никогда не опережает позицию чтения,
+// out может указывать на начало str
+size_t DecodeTo(std::string_view str, char* out) {
+    size_t out_pos = 0;
+    for (size_t i = 0; i < str.size(); ++i) {
+        const char c = str[i];
+        if (c == '+') {
+            out[out_pos++] = ' ';
+        } else if (c == '%') {
+            if (str.size() - i < 3) {
+                throw std::invalid_argument("Incomplete percent-encoded sequence");
+            }
+            const int hi = HexDigitValue(str[i + 1]);
+            const int lo = HexDigitValue(str[i + 2]);
+            if (hi < 0 || lo < 0) {
+                throw std::invalid_argument("Invalid percent-encoded sequence");
+            }
+            out[out_pos++] = static_cast<char>(hi * 16 + lo);
+            i += 2;
+        } else {
+            out[out_pos++] = c;
+        }
+    }
+    return out_pos;
+}
+
+}  // namespace
+
+bool UrlNeedsDecoding(std::string_view str) noexcept {
+    return str.find_first_of("%+") != std::string_view::npos;
+}
+
+std::string UrlDecode(std::string_view str) {
+    if (!UrlNeedsDecoding(str)) {
+        return std::string{str};
+    }
+    std::string result(str.size(), '\0');
+    result.resize(DecodeTo(str, result.data()));
+    return result;
+}
+
+size_t UrlDecodeTo(std::string_view str, std::span<char> out) {
+    // Заранее неизвестно, насколько сократится строка, поэтому требуем буфер размером с исходную
+    if (out.size() < str.size()) {
+        throw std::invalid_argument("Output buffer is too small");
+    }
+    if (!UrlNeedsDecoding(str)) {
+        // Области могут перекрываться, если декодирование выполняется на месте
+        std::memmove(out.data(), str.data(), str.size());
+        return str.size();
+    }
+    return DecodeTo(str, out.data());
+}
+
+std::string_view UrlDecodeInPlace(std::span<char> buffer) {
+    const std::string_view str{buffer.data(), buffer.size()};
+    if (!UrlNeedsDecoding(str)) {
+        return str;
+    }
+    return {buffer.data(), DecodeTo(str, buffer.data())};
+}
+
+std::string_view UrlDecodeView(std::string_view str, std::span<char> buffer) {
+    if (!UrlNeedsDecoding(str)) {
+        return str;
+    }
+    return {buffer.data(), UrlDecodeTo(str, buffer)};
+}
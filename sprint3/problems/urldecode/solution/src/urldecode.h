@@ -0,0 +1,56 @@
+#pragma once
+
+#include <span>
+#include <string>
+#include <string_view>
+
+// Возвращает значение шестнадцатеричной цифры либо -1, если c не является такой цифрой
+inline int HexDigitValue(char c) noexcept {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+/*
+Возвращает URL-декодированное представление строки str.
+Пример: "Hello+World%20%21" должна превратиться в "Hello World !"
+В случае ошибки выбрасывает исключение std::invalid_argument
+*/
+std::string UrlDecode(std::string_view str);
+
+/*
+Сообщает, содержит ли строка %-последовательности или символы +.
+Если нет, декодированное представление строки совпадает с ней самой
+*/
+bool UrlNeedsDecoding(std::string_view str) noexcept;
+
+/*
+Декодирует str в буфер out и возвращает количество записанных символов.
+Декодированная строка никогда не длиннее исходной, поэтому буфера размером str.size() всегда
+достаточно. Буфер out может совпадать с началом str (декодирование на месте).
+В случае ошибки или нехватки места в out выбрасывает исключение std::invalid_argument
+*/
+size_t UrlDecodeTo(std::string_view str, std::span<char> out);
+
+/*
+Декодирует содержимое буфера buffer на месте, не выделяя память.
+Возвращает представление декодированной части буфера.
+В случае ошибки выбрасывает исключение std::invalid_argument, содержимое буфера при этом не определено
+*/
+std::string_view UrlDecodeInPlace(std::span<char> buffer);
+
+/*
+Возвращает декодированное представление str, не выделяя память.
+Если str не требует декодирования, возвращается сама str без копирования.
+Иначе str декодируется в буфер buffer (например, в буфер сессии) и возвращается представление
+на его декодированную часть.
+В случае ошибки или нехватки места в buffer выбрасывает исключение std::invalid_argument
+*/
+std::string_view UrlDecodeView(std::string_view str, std::span<char> buffer);
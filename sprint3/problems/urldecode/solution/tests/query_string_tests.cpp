@@ -0,0 +1,88 @@
+#include <boost/test/unit_test.hpp>
+
+#include <array>
+#include <stdexcept>
+
+#include "../src/query_string.h"
+
+using namespace std::literals;
+
+BOOST_AUTO_TEST_CASE(QueryString_parses_params) {
+    constexpr auto target = "/api/v1/game/records?start=0&maxItems=100"sv;
+    const QueryString query{target};
+
+    BOOST_TEST((query.GetPath() == "/api/v1/game/records"sv));
+    BOOST_TEST(query.Size() == 2u);
+    BOOST_TEST((query.GetRaw("start"sv) == "0"sv));
+    BOOST_TEST((query.GetRaw("maxItems"sv) == "100"sv));
+    BOOST_TEST(!query.GetRaw("missing"sv));
+
+    // Значения ссылаются на исходную строку
+    BOOST_TEST((query.GetRaw("start"sv)->data() == target.data() + target.find("0&"sv)));
+}
+
+BOOST_AUTO_TEST_CASE(QueryString_without_query) {
+    const QueryString query{"/api/v1/maps"sv};
+    BOOST_TEST((query.GetPath() == "/api/v1/maps"sv));
+    BOOST_TEST(query.Empty());
+
+    const QueryString empty_query{"/api/v1/maps?"sv};
+    BOOST_TEST(empty_query.Empty());
+}
+
+BOOST_AUTO_TEST_CASE(QueryString_skips_empty_params) {
+    const QueryString query{"/?&a=1&&b&c=#fragment"sv};
+    BOOST_TEST(query.Size() == 3u);
+    BOOST_TEST((query.GetRaw("a"sv) == "1"sv));
+    BOOST_TEST((query.GetRaw("b"sv) == ""sv));
+    BOOST_TEST((query.GetRaw("c"sv) == ""sv));
+}
+
+BOOST_AUTO_TEST_CASE(QueryString_decodes_values_lazily) {
+    const QueryString query{"/?name=Hello+World%21&plain=abc&key%20x=1"sv};
+
+    std::array<char, 32> buffer{};
+    const auto plain = query.GetView("plain"sv, buffer);
+    BOOST_TEST((plain == "abc"sv));
+    BOOST_TEST(plain->data() != buffer.data());
+
+    const auto name = query.GetView("name"sv, buffer);
+    BOOST_TEST((name == "Hello World!"sv));
+    BOOST_TEST(name->data() == buffer.data());
+
+    BOOST_TEST((query.GetString("name"sv) == "Hello World!"s));
+    BOOST_TEST(query.Contains("key x"sv));
+}
+
+BOOST_AUTO_TEST_CASE(QueryString_ignores_names_with_bad_escapes) {
+    const QueryString query{"/?abcdef%zz=1&bad%4=2&start=5&key%2=3&%41b=4"sv};
+
+    // Некорректное имя не совпадает ни с одним именем и не мешает искать остальные параметры
+    BOOST_TEST((query.GetNumber<int>("start"sv) == 5));
+    BOOST_TEST(!query.Contains("abcdef%zz"sv));
+    BOOST_TEST(!query.Contains("bad%4"sv));
+    BOOST_TEST(!query.Contains("key%2"sv));
+    BOOST_TEST((query.GetRaw("Ab"sv) == "4"sv));
+    BOOST_TEST(!query.Contains("A"sv));
+}
+
+BOOST_AUTO_TEST_CASE(QueryString_typed_accessors) {
+    const QueryString query{"/?start=10&max=-5&ratio=0.25&enc=%31%32&bad=12x&big=1e400"sv};
+
+    BOOST_TEST((query.GetNumber<int>("start"sv) == 10));
+    BOOST_TEST((query.GetNumber<long>("max"sv) == -5));
+    BOOST_TEST((query.GetNumber<double>("ratio"sv) == 0.25));
+    BOOST_TEST((query.GetNumber<unsigned>("enc"sv) == 12u));
+    BOOST_TEST(!query.GetNumber<int>("missing"sv));
+    BOOST_CHECK_THROW(query.GetNumber<int>("bad"sv), std::invalid_argument);
+    BOOST_CHECK_THROW(query.GetNumber<unsigned>("max"sv), std::invalid_argument);
+    BOOST_CHECK_THROW(query.GetNumber<double>("big"sv), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(QueryString_capacity_is_limited) {
+    std::string target = "/?"s;
+    for (size_t i = 0; i <= QueryString::MAX_PARAMS; ++i) {
+        target += "p=1&"sv;
+    }
+    BOOST_CHECK_THROW(QueryString{target}, std::invalid_argument);
+}
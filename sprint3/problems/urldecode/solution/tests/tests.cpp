@@ -0,0 +1,65 @@
+#define BOOST_TEST_MODULE urlencode tests
+#include <boost/test/unit_test.hpp>
+
+#include <array>
+#include <stdexcept>
+
+#include "../src/urldecode.h"
+
+BOOST_AUTO_TEST_CASE(UrlDecode_tests) {
+    using namespace std::literals;
+
+    BOOST_TEST(UrlDecode(""sv) == ""s);
+    BOOST_TEST(UrlDecode("hello"sv) == "hello"s);
+    BOOST_TEST(UrlDecode("Hello+World%20%21"sv) == "Hello World !"s);
+    BOOST_TEST(UrlDecode("%2f%2F"sv) == "//"s);
+    BOOST_TEST(UrlDecode("%00"sv) == "\0"s);
+    BOOST_CHECK_THROW(UrlDecode("%"sv), std::invalid_argument);
+    BOOST_CHECK_THROW(UrlDecode("abc%2"sv), std::invalid_argument);
+    BOOST_CHECK_THROW(UrlDecode("%g0"sv), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(UrlDecodeInPlace_tests) {
+    using namespace std::literals;
+
+    std::string buffer = "/api/v1/maps/map%201+a"s;
+    const auto decoded = UrlDecodeInPlace(buffer);
+    BOOST_TEST(decoded == "/api/v1/maps/map 1 a"sv);
+    BOOST_TEST(decoded.data() == buffer.data());
+
+    std::string empty;
+    BOOST_TEST(UrlDecodeInPlace(empty).empty());
+
+    std::string invalid = "%zz"s;
+    BOOST_CHECK_THROW(UrlDecodeInPlace(invalid), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(UrlDecodeTo_tests) {
+    using namespace std::literals;
+
+    std::array<char, 16> buffer{};
+    const auto size = UrlDecodeTo("a%41+b"sv, buffer);
+    BOOST_TEST((std::string_view{buffer.data(), size} == "aA b"sv));
+
+    BOOST_TEST(UrlDecodeTo("plain"sv, buffer) == 5u);
+    BOOST_TEST((std::string_view{buffer.data(), 5} == "plain"sv));
+
+    std::array<char, 4> small{};
+    BOOST_CHECK_THROW(UrlDecodeTo("%41%42"sv, small), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(UrlDecodeView_tests) {
+    using namespace std::literals;
+
+    std::array<char, 32> buffer{};
+
+    // Строка без %-последовательностей возвращается без копирования
+    constexpr auto plain = "/api/v1/maps"sv;
+    const auto plain_view = UrlDecodeView(plain, buffer);
+    BOOST_TEST(plain_view.data() == plain.data());
+    BOOST_TEST(!UrlNeedsDecoding(plain));
+
+    const auto decoded = UrlDecodeView("/static/a%20b.html"sv, buffer);
+    BOOST_TEST(decoded == "/static/a b.html"sv);
+    BOOST_TEST(decoded.data() == buffer.data());
+}
@@ -0,0 +1,555 @@
+#include "catalog_import.h"
+
+#include <algorithm>
+#include <charconv>
+#include <deque>
+#include <future>
+#include <istream>
+#include <optional>
+#include <stdexcept>
+#include <unordered_map>
+
+#include "../domain/author.h"
+
+namespace app {
+
+using namespace std::literals;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Ограничения длины совпадают с размерами столбцов в базе данных
+constexpr size_t MAX_AUTHOR_LENGTH = 100;
+constexpr size_t MAX_TITLE_LENGTH = 100;
+constexpr auto WHITESPACE = " \t\r"sv;
+
+std::string_view Trim(std::string_view str) {
+    const size_t begin = str.find_first_not_of(WHITESPACE);
+    if (begin == str.npos) {
+        return {};
+    }
+    return str.substr(begin, str.find_last_not_of(WHITESPACE) - begin + 1);
+}
+
+// Количество символов в строке UTF-8
+size_t GetUtf8Length(std::string_view str) {
+    return std::count_if(str.begin(), str.end(), [](char c) {
+        return (static_cast<unsigned char>(c) & 0xC0) != 0x80;
+    });
+}
+
+// Проверяет, что строка — корректная последовательность UTF-8. Отвергает обрезанные
+// и избыточно длинные последовательности, суррогаты и кодовые точки больше U+10FFFF
+bool IsValidUtf8(std::string_view str) {
+    for (size_t i = 0; i < str.size();) {
+        const auto lead = static_cast<unsigned char>(str[i]);
+        size_t size = 0;
+        char32_t code = 0;
+        char32_t min_code = 0;
+        if (lead < 0x80) {
+            ++i;
+            continue;
+        } else if ((lead & 0xE0) == 0xC0) {
+            size = 2, code = lead & 0x1F, min_code = 0x80;
+        } else if ((lead & 0xF0) == 0xE0) {
+            size = 3, code = lead & 0x0F, min_code = 0x800;
+        } else if ((lead & 0xF8) == 0xF0) {
+            size = 4, code = lead & 0x07, min_code = 0x10000;
+        } else {
+            return false;
+        }
+        if (str.size() - i < size) {
+            return false;
+        }
+        for (size_t j = 1; j < size; ++j) {
+            const auto c = static_cast<unsigned char>(str[i + j]);
+            if ((c & 0xC0) != 0x80) {
+                return false;
+            }
+            code = (code << 6) | (c & 0x3F);
+        }
+        if (code < min_code || code > 0x10FFFF || (code >= 0xD800 && code <= 0xDFFF)) {
+            return false;
+        }
+        i += size;
+    }
+    return true;
+}
+
+std::optional<int> ParseYear(std::string_view str) {
+    str = Trim(str);
+    int year = 0;
+    const auto [end, ec] = std::from_chars(str.data(), str.data() + str.size(), year);
+    if (str.empty() || ec != std::errc{} || end != str.data() + str.size()) {
+        return std::nullopt;
+    }
+    return year;
+}
+
+// Исключение с описанием ошибки в строке каталога
+class RowError : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+// Разбирает строку CSV. Возвращает nullopt для строки заголовка
+std::optional<CatalogRecord> ParseCsvRow(std::string_view line, bool may_be_header) {
+    std::vector<std::string> fields(1);
+    bool quoted = false;
+    bool was_quoted = false;
+    for (size_t i = 0; i < line.size(); ++i) {
+        const char c = line[i];
+        if (quoted) {
+            if (c != '"') {
+                fields.back() += c;
+            } else if (i + 1 < line.size() && line[i + 1] == '"') {
+                fields.back() += '"';
+                ++i;
+            } else {
+                quoted = false;
+            }
+        } else if (c == ',') {
+            if (!was_quoted) {
+                fields.back() = Trim(fields.back());
+            }
+            fields.emplace_back();
+            was_quoted = false;
+        } else if (was_quoted) {
+            // После закрывающей кавычки допускаются только пробелы
+            if (WHITESPACE.find(c) == WHITESPACE.npos) {
+                throw RowError("unexpected character after a quoted field");
+            }
+        } else if (c == '"' && Trim(fields.back()).empty()) {
+            fields.back().clear();
+            quoted = was_quoted = true;
+        } else {
+            fields.back() += c;
+        }
+    }
+    if (quoted) {
+        throw RowError("unterminated quoted field");
+    }
+    if (!was_quoted) {
+        fields.back() = Trim(fields.back());
+    }
+    if (fields.size() != 3) {
+        throw RowError("expected 3 fields, found "s + std::to_string(fields.size()));
+    }
+
+    const auto year = ParseYear(fields[2]);
+    if (!year) {
+        if (may_be_header) {
+            return std::nullopt;
+        }
+        throw RowError("invalid publication year");
+    }
+    return CatalogRecord{std::move(fields[0]), std::move(fields[1]), *year};
+}
+
+/*
+Разбор одной строки JSONL. Поддерживается объект без вложенных объектов и массивов,
+значения которого - строки, числа, true, false или null.
+*/
+class JsonRowParser {
+public:
+    explicit JsonRowParser(std::string_view line)
+        : line_{line} {
+    }
+
+    CatalogRecord Parse() {
+        CatalogRecord record;
+        bool has_author = false;
+        bool has_title = false;
+        bool has_year = false;
+
+        Expect('{');
+        if (!TryConsume('}')) {
+            do {
+                const std::string key = ParseString();
+                Expect(':');
+                if (key == "author"sv) {
+                    record.author = ParseString();
+                    has_author = true;
+                } else if (key == "title"sv) {
+                    record.title = ParseString();
+                    has_title = true;
+                } else if (key == "publication_year"sv) {
+                    const auto year = ParseYear(ParseScalar());
+                    if (!year) {
+                        throw RowError("invalid publication year");
+                    }
+                    record.publication_year = *year;
+                    has_year = true;
+                } else {
+                    SkipValue();
+                }
+            } while (TryConsume(','));
+            Expect('}');
+        }
+        SkipWhitespace();
+        if (pos_ != line_.size()) {
+            throw RowError("unexpected data after the object");
+        }
+        if (!has_author || !has_title || !has_year) {
+            throw RowError("author, title and publication_year are required");
+        }
+        return record;
+    }
+
+private:
+    void SkipWhitespace() {
+        while (pos_ < line_.size() && WHITESPACE.find(line_[pos_]) != WHITESPACE.npos) {
+            ++pos_;
+        }
+    }
+
+    bool TryConsume(char c) {
+        SkipWhitespace();
+        if (pos_ < line_.size() && line_[pos_] == c) {
+            ++pos_;
+            return true;
+        }
+        return false;
+    }
+
+    void Expect(char c) {
+        if (!TryConsume(c)) {
+            throw RowError("expected '"s + c + '\'');
+        }
+    }
+
+    std::string ParseString() {
+        Expect('"');
+        std::string result;
+        while (true) {
+            if (pos_ >= line_.size()) {
+                throw RowError("unterminated string");
+            }
+            const char c = line_[pos_++];
+            if (c == '"') {
+                return result;
+            }
+            if (c != '\\') {
+                result += c;
+                continue;
+            }
+            if (pos_ >= line_.size()) {
+                throw RowError("unterminated string");
+            }
+            switch (const char escaped = line_[pos_++]) {
+                case '"':
+                case '\\':
+                case '/':
+                    result += escaped;
+                    break;
+                case 'b':
+                    result += '\b';
+                    break;
+                case 'f':
+                    result += '\f';
+                    break;
+                case 'n':
+                    result += '\n';
+                    break;
+                case 'r':
+                    result += '\r';
+                    break;
+                case 't':
+                    result += '\t';
+                    break;
+                case 'u':
+                    AppendUtf8(result, ParseCodePoint());
+                    break;
+                default:
+                    throw RowError("invalid escape sequence");
+            }
+        }
+    }
+
+    // Разбирает \uXXXX после "\u", включая суррогатные пары
+    char32_t ParseCodePoint() {
+        char32_t code = ParseHex4();
+        if (code >= 0xD800 && code <= 0xDBFF) {
+            if (line_.substr(pos_, 2) != "\\u"sv) {
+                throw RowError("invalid surrogate pair");
+            }
+            pos_ += 2;
+            const char32_t low = ParseHex4();
+            if (low < 0xDC00 || low > 0xDFFF) {
+                throw RowError("invalid surrogate pair");
+            }
+            code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+        } else if (code >= 0xDC00 && code <= 0xDFFF) {
+            throw RowError("invalid surrogate pair");
+        }
+        return code;
+    }
+
+    char32_t ParseHex4() {
+        unsigned value = 0;
+        const auto digits = line_.substr(pos_, 4);
+        const auto [end, ec] =
+            std::from_chars(digits.data(), digits.data() + digits.size(), value, 16);
+        if (digits.size() != 4 || ec != std::errc{} || end != digits.data() + digits.size()) {
+            throw RowError("invalid \\u escape sequence");
+        }
+        pos_ += 4;
+        return value;
+    }
+
+    static void AppendUtf8(std::string& out, char32_t code) {
+        if (code < 0x80) {
+            out += static_cast<char>(code);
+        } else if (code < 0x800) {
+            out += static_cast<char>(0xC0 | (code >> 6));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        } else if (code < 0x10000) {
+            out += static_cast<char>(0xE0 | (code >> 12));
+            out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        } else {
+            out += static_cast<char>(0xF0 | (code >> 18));
+            out += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        }
+    }
+
+    // Возвращает текст числа, true, false или null
+    std::string_view ParseScalar() {
+        SkipWhitespace();
+        const size_t begin = pos_;
+        while (pos_ < line_.size() && line_[pos_] != ',' && line_[pos_] != '}'
+               && WHITESPACE.find(line_[pos_]) == WHITESPACE.npos) {
+            ++pos_;
+        }
+        if (begin == pos_) {
+            throw RowError("value expected");
+        }
+        return line_.substr(begin, pos_ - begin);
+    }
+
+    void SkipValue() {
+        SkipWhitespace();
+        if (pos_ < line_.size() && line_[pos_] == '"') {
+            ParseString();
+        } else if (pos_ < line_.size() && (line_[pos_] == '{' || line_[pos_] == '[')) {
+            throw RowError("nested objects and arrays are not supported");
+        } else {
+            ParseScalar();
+        }
+    }
+
+    std::string_view line_;
+    size_t pos_ = 0;
+};
+
+// PostgreSQL не хранит символ NUL в текстовых столбцах и отвергает некорректный UTF-8,
+// прерывая COPY целиком. Поэтому такие строки отбрасываются до записи в базу
+void ValidateText(std::string_view text, std::string_view field) {
+    if (text.find('\0') != text.npos) {
+        throw RowError(std::string{field} + " must not contain NUL characters");
+    }
+    if (!IsValidUtf8(text)) {
+        throw RowError(std::string{field} + " is not valid UTF-8");
+    }
+}
+
+void Validate(const CatalogRecord& record) {
+    ValidateText(record.author, "author name"sv);
+    ValidateText(record.title, "title"sv);
+    if (record.author.empty() || GetUtf8Length(record.author) > MAX_AUTHOR_LENGTH) {
+        throw RowError("author name must contain from 1 to "s + std::to_string(MAX_AUTHOR_LENGTH)
+                       + " characters");
+    }
+    if (record.title.empty() || GetUtf8Length(record.title) > MAX_TITLE_LENGTH) {
+        throw RowError("title must contain from 1 to "s + std::to_string(MAX_TITLE_LENGTH)
+                       + " characters");
+    }
+}
+
+// Фрагмент входных данных, состоящий из целых строк
+struct Chunk {
+    std::string text;
+    size_t first_line = 1;
+};
+
+class ChunkReader {
+public:
+    ChunkReader(std::istream& input, size_t chunk_size)
+        : input_{input}
+        , chunk_size_{std::max<size_t>(chunk_size, 1)} {
+    }
+
+    std::optional<Chunk> Next() {
+        Chunk chunk{std::move(tail_), next_line_};
+        tail_.clear();
+        size_t eol = chunk.text.rfind('\n');
+        // Фрагмент дочитывается, пока в нём нет ни одного конца строки
+        while (input_ && (chunk.text.size() < chunk_size_ || eol == chunk.text.npos)) {
+            const size_t old_size = chunk.text.size();
+            chunk.text.resize(old_size + chunk_size_);
+            input_.read(chunk.text.data() + old_size, static_cast<std::streamsize>(chunk_size_));
+            chunk.text.resize(old_size + static_cast<size_t>(input_.gcount()));
+            const size_t pos = chunk.text.rfind('\n');
+            if (pos != chunk.text.npos && pos >= old_size) {
+                eol = pos;
+            }
+        }
+        if (chunk.text.empty()) {
+            return std::nullopt;
+        }
+        // Неполная последняя строка переносится в следующий фрагмент, если файл не закончился
+        if (input_ && eol != chunk.text.npos) {
+            tail_.assign(chunk.text, eol + 1);
+            chunk.text.resize(eol + 1);
+        }
+        next_line_ += std::count(chunk.text.begin(), chunk.text.end(), '\n');
+        return chunk;
+    }
+
+private:
+    std::istream& input_;
+    const size_t chunk_size_;
+    std::string tail_;
+    size_t next_line_ = 1;
+};
+
+// Фрагмент, разобранный рабочим потоком. Идентификаторы книг тоже создаются параллельно
+struct PreparedChunk {
+    ParsedChunk parsed;
+    std::vector<domain::BookId> book_ids;
+};
+
+}  // namespace
+
+CatalogFormat GetCatalogFormat(std::string_view file_path) {
+    if (file_path.ends_with(".csv"sv)) {
+        return CatalogFormat::CSV;
+    }
+    if (file_path.ends_with(".jsonl"sv) || file_path.ends_with(".json"sv)) {
+        return CatalogFormat::JSONL;
+    }
+    throw std::invalid_argument("Unknown catalog format. Expected .csv or .jsonl file");
+}
+
+ParsedChunk ParseCatalogChunk(std::string_view chunk, CatalogFormat format, size_t first_line,
+                              size_t max_errors) {
+    ParsedChunk result;
+    size_t line_number = first_line;
+    for (size_t pos = 0; pos < chunk.size(); ++line_number) {
+        const size_t eol = std::min(chunk.find('\n', pos), chunk.size());
+        const std::string_view line = chunk.substr(pos, eol - pos);
+        pos = eol + 1;
+        if (Trim(line).empty()) {
+            continue;
+        }
+        try {
+            std::optional<CatalogRecord> record;
+            if (format == CatalogFormat::CSV) {
+                record = ParseCsvRow(line, line_number == 1);
+            } else {
+                record = JsonRowParser{line}.Parse();
+            }
+            if (record) {
+                Validate(*record);
+                result.records.push_back(std::move(*record));
+            }
+        } catch (const RowError& e) {
+            ++result.invalid_rows;
+            if (result.errors.size() < max_errors) {
+                result.errors.push_back("Line "s + std::to_string(line_number) + ": "s + e.what());
+            }
+        }
+    }
+    return result;
+}
+
+CatalogImporter::CatalogImporter(CatalogStorage& storage, ImportOptions options)
+    : storage_{storage}
+    , options_{options} {
+    if (options_.num_threads == 0) {
+        throw std::invalid_argument("At least one import thread is required");
+    }
+}
+
+ImportStats CatalogImporter::Import(std::istream& input, CatalogFormat format,
+                                    const ImportProgressHandler& on_progress) {
+    const auto start = Clock::now();
+    auto last_report = start;
+    ImportStats stats;
+
+    auto writer = storage_.StartImport();
+    std::unordered_map<std::string, domain::AuthorId> author_ids;
+    for (const auto& author : writer->LoadAuthors()) {
+        author_ids.emplace(author.GetName(), author.GetId());
+    }
+
+    std::vector<domain::Author> new_authors;
+    std::vector<domain::Book> books;
+    auto write_chunk = [&](PreparedChunk chunk) {
+        new_authors.clear();
+        books.clear();
+        books.reserve(chunk.parsed.records.size());
+        for (size_t i = 0; i < chunk.parsed.records.size(); ++i) {
+            auto& record = chunk.parsed.records[i];
+            auto [it, inserted] = author_ids.try_emplace(std::move(record.author));
+            if (inserted) {
+                it->second = domain::AuthorId::New();
+                new_authors.emplace_back(it->second, it->first);
+            }
+            books.emplace_back(std::move(chunk.book_ids[i]), it->second, std::move(record.title),
+                               record.publication_year);
+        }
+        writer->Write(new_authors, books);
+
+        stats.rows += books.size() + chunk.parsed.invalid_rows;
+        stats.books += books.size();
+        stats.authors += new_authors.size();
+        stats.invalid_rows += chunk.parsed.invalid_rows;
+        for (auto& error : chunk.parsed.errors) {
+            if (stats.errors.size() < options_.max_errors) {
+                stats.errors.push_back(std::move(error));
+            }
+        }
+
+        const auto now = Clock::now();
+        if (on_progress && now - last_report >= options_.progress_interval) {
+            last_report = now;
+            stats.elapsed = now - start;
+            on_progress(stats);
+        }
+    };
+
+    // Разбор выполняется в фоновых потоках, а запись - в текущем потоке в порядке фрагментов
+    std::deque<std::future<PreparedChunk>> pending;
+    ChunkReader reader{input, options_.chunk_size};
+    while (auto chunk = reader.Next()) {
+        pending.push_back(std::async(std::launch::async, [format, chunk = std::move(*chunk),
+                                                          max_errors = options_.max_errors] {
+            PreparedChunk prepared{
+                ParseCatalogChunk(chunk.text, format, chunk.first_line, max_errors), {}};
+            prepared.book_ids.reserve(prepared.parsed.records.size());
+            std::generate_n(std::back_inserter(prepared.book_ids), prepared.parsed.records.size(),
+                            domain::BookId::New);
+            return prepared;
+        }));
+        if (pending.size() >= options_.num_threads) {
+            write_chunk(pending.front().get());
+            pending.pop_front();
+        }
+    }
+    for (; !pending.empty(); pending.pop_front()) {
+        write_chunk(pending.front().get());
+    }
+    if (input.bad()) {
+        throw std::runtime_error("Failed to read the catalog");
+    }
+
+    writer->Commit();
+    stats.elapsed = Clock::now() - start;
+    return stats;
+}
+
+}  // namespace app
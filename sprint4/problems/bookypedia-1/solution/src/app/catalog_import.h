@@ -0,0 +1,115 @@
+#pragma once
+#include <chrono>
+#include <functional>
+#include <iosfwd>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../domain/author_fwd.h"
+#include "../domain/book.h"
+
+namespace app {
+
+enum class CatalogFormat {
+    // Строки вида author,title,publication_year. Поле, содержащее запятую, заключается в
+    // двойные кавычки, а кавычка внутри него удваивается. Первая строка может быть заголовком
+    CSV,
+    // JSON-объект в каждой строке: {"author": "...", "title": "...", "publication_year": 1999}.
+    // Остальные поля объекта игнорируются
+    JSONL,
+};
+
+// Определяет формат каталога по расширению файла: .csv, .jsonl или .json
+CatalogFormat GetCatalogFormat(std::string_view file_path);
+
+struct CatalogRecord {
+    std::string author;
+    std::string title;
+    int publication_year = 0;
+};
+
+struct ParsedChunk {
+    std::vector<CatalogRecord> records;
+    size_t invalid_rows = 0;
+    // Сообщения о первых max_errors ошибках с номерами строк
+    std::vector<std::string> errors;
+};
+
+// Разбирает и проверяет строки chunk. first_line - номер первой строки chunk в файле, начиная с 1
+ParsedChunk ParseCatalogChunk(std::string_view chunk, CatalogFormat format, size_t first_line,
+                              size_t max_errors);
+
+/*
+Транзакция импорта каталога, реализуемая слоем хранения.
+Если Commit не был вызван, при разрушении объекта все записанные данные отменяются.
+*/
+class CatalogWriter {
+public:
+    virtual ~CatalogWriter() = default;
+
+    // Возвращает авторов, уже имеющихся в хранилище
+    virtual std::vector<domain::Author> LoadAuthors() = 0;
+    // Записывает новых авторов и книги. Авторы книг должны быть записаны раньше книг
+    virtual void Write(std::span<const domain::Author> authors,
+                       std::span<const domain::Book> books) = 0;
+    virtual void Commit() = 0;
+};
+
+class CatalogStorage {
+public:
+    virtual std::unique_ptr<CatalogWriter> StartImport() = 0;
+
+protected:
+    ~CatalogStorage() = default;
+};
+
+struct ImportStats {
+    // Обработанные строки, не считая пустых
+    size_t rows = 0;
+    size_t books = 0;
+    // Добавленные авторы. Авторы, которые уже есть в хранилище, повторно не добавляются
+    size_t authors = 0;
+    size_t invalid_rows = 0;
+    std::vector<std::string> errors;
+    std::chrono::duration<double> elapsed{};
+
+    double GetRowsPerSecond() const noexcept {
+        return elapsed.count() > 0 ? rows / elapsed.count() : 0;
+    }
+};
+
+using ImportProgressHandler = std::function<void(const ImportStats&)>;
+
+struct ImportOptions {
+    // Количество фрагментов, разбираемых одновременно
+    unsigned num_threads = 4;
+    // Примерный размер фрагмента в байтах. Фрагмент всегда заканчивается концом строки
+    size_t chunk_size = 4 << 20;
+    size_t max_errors = 10;
+    std::chrono::milliseconds progress_interval{1000};
+};
+
+/*
+Импорт каталога книг.
+Входные данные читаются фрагментами, которые разбираются параллельно, а затем по порядку
+записываются в хранилище: авторы сопоставляются по имени, новые авторы добавляются вместе с
+первой их книгой. Весь импорт выполняется в одной транзакции CatalogWriter. Строки с ошибками
+пропускаются.
+*/
+class CatalogImporter {
+public:
+    explicit CatalogImporter(CatalogStorage& storage, ImportOptions options = {});
+
+    // on_progress вызывается не чаще, чем раз в progress_interval
+    ImportStats Import(std::istream& input, CatalogFormat format,
+                       const ImportProgressHandler& on_progress = {});
+
+private:
+    CatalogStorage& storage_;
+    ImportOptions options_;
+};
+
+}  // namespace app
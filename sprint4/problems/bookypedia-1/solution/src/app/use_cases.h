@@ -0,0 +1,28 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "../domain/author.h"
+#include "../domain/book.h"
+#include "catalog_import.h"
+
+namespace app {
+
+class UseCases {
+public:
+    virtual void AddAuthor(const std::string& name) = 0;
+    virtual void AddBook(const std::string& author_id, const std::string& title,
+                         int publication_year) = 0;
+    virtual std::vector<domain::Author> GetAuthors() = 0;
+    virtual std::vector<domain::Book> GetBooks() = 0;
+    virtual std::vector<domain::Book> GetAuthorBooks(const std::string& author_id) = 0;
+    // Импортирует авторов и книги из файла CSV или JSONL
+    virtual ImportStats ImportCatalog(const std::string& file_path,
+                                      const ImportProgressHandler& on_progress) = 0;
+
+protected:
+    ~UseCases() = default;
+};
+
+}  // namespace app
@@ -0,0 +1,47 @@
+#include "use_cases_impl.h"
+
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+#include <thread>
+
+#include "../domain/author.h"
+#include "../domain/book.h"
+
+namespace app {
+using namespace domain;
+
+void UseCasesImpl::AddAuthor(const std::string& name) {
+    authors_.Save({AuthorId::New(), name});
+}
+
+void UseCasesImpl::AddBook(const std::string& author_id, const std::string& title,
+                           int publication_year) {
+    books_.Save({BookId::New(), AuthorId::FromString(author_id), title, publication_year});
+}
+
+std::vector<Author> UseCasesImpl::GetAuthors() {
+    return authors_.GetAll();
+}
+
+std::vector<Book> UseCasesImpl::GetBooks() {
+    return books_.GetAll();
+}
+
+std::vector<Book> UseCasesImpl::GetAuthorBooks(const std::string& author_id) {
+    return books_.GetByAuthor(AuthorId::FromString(author_id));
+}
+
+ImportStats UseCasesImpl::ImportCatalog(const std::string& file_path,
+                                        const ImportProgressHandler& on_progress) {
+    const CatalogFormat format = GetCatalogFormat(file_path);
+    std::ifstream input{file_path, std::ios::binary};
+    if (!input) {
+        throw std::runtime_error("Failed to open " + file_path);
+    }
+    ImportOptions options;
+    options.num_threads = std::max(1u, std::thread::hardware_concurrency());
+    return CatalogImporter{catalog_, options}.Import(input, format, on_progress);
+}
+
+}  // namespace app
@@ -0,0 +1,32 @@
+#pragma once
+#include "../domain/author_fwd.h"
+#include "../domain/book_fwd.h"
+#include "use_cases.h"
+
+namespace app {
+
+class UseCasesImpl : public UseCases {
+public:
+    UseCasesImpl(domain::AuthorRepository& authors, domain::BookRepository& books,
+                 CatalogStorage& catalog)
+        : authors_{authors}
+        , books_{books}
+        , catalog_{catalog} {
+    }
+
+    void AddAuthor(const std::string& name) override;
+    void AddBook(const std::string& author_id, const std::string& title,
+                 int publication_year) override;
+    std::vector<domain::Author> GetAuthors() override;
+    std::vector<domain::Book> GetBooks() override;
+    std::vector<domain::Book> GetAuthorBooks(const std::string& author_id) override;
+    ImportStats ImportCatalog(const std::string& file_path,
+                              const ImportProgressHandler& on_progress) override;
+
+private:
+    domain::AuthorRepository& authors_;
+    domain::BookRepository& books_;
+    CatalogStorage& catalog_;
+};
+
+}  // namespace app
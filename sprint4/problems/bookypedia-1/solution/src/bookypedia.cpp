@@ -0,0 +1,35 @@
+#include "bookypedia.h"
+
+#include <iostream>
+
+#include "menu/menu.h"
+#include "postgres/postgres.h"
+#include "ui/view.h"
+
+namespace bookypedia {
+
+using namespace std::literals;
+
+Application::Application(const AppConfig& config)
+    : batch_mode_{config.batch_mode}
+    , db_{pqxx::connection{config.db_url}} {
+}
+
+void Application::Run() {
+    menu::Menu menu{std::cin, std::cout};
+    menu.AddAction("Help"s, {}, "Show instructions"s, [&menu](std::istream&) {
+        menu.ShowInstructions();
+        return true;
+    });
+    menu.AddAction("Exit"s, {}, "Exit program"s, [&menu](std::istream&) {
+        return false;
+    });
+    ui::View view{menu, use_cases_, std::cin, std::cout};
+    if (batch_mode_) {
+        menu.RunBatch();
+    } else {
+        menu.Run();
+    }
+}
+
+}  // namespace bookypedia
@@ -0,0 +1,27 @@
+#pragma once
+#include <pqxx/pqxx>
+
+#include "app/use_cases_impl.h"
+#include "postgres/postgres.h"
+
+namespace bookypedia {
+
+struct AppConfig {
+    std::string db_url;
+    // Команды читаются из стандартного ввода блоками, без подсказок и интерактивного ввода
+    bool batch_mode = false;
+};
+
+class Application {
+public:
+    explicit Application(const AppConfig& config);
+
+    void Run();
+
+private:
+    bool batch_mode_;
+    postgres::Database db_;
+    app::UseCasesImpl use_cases_{db_.GetAuthors(), db_.GetBooks(), db_.GetCatalog()};
+};
+
+}  // namespace bookypedia
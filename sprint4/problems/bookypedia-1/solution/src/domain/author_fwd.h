@@ -0,0 +1,9 @@
+#pragma once
+
+namespace domain {
+
+class Author;
+
+class AuthorRepository;
+
+}  // namespace domain
\ No newline at end of file
@@ -0,0 +1,43 @@
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+
+#include "bookypedia.h"
+
+using namespace std::literals;
+
+namespace {
+
+constexpr const char DB_URL_ENV_NAME[]{"BOOKYPEDIA_DB_URL"};
+
+bookypedia::AppConfig GetConfigFromEnv() {
+    bookypedia::AppConfig config;
+    if (const auto* url = std::getenv(DB_URL_ENV_NAME)) {
+        config.db_url = url;
+    } else {
+        throw std::runtime_error(DB_URL_ENV_NAME + " environment variable not found"s);
+    }
+    return config;
+}
+
+}  // namespace
+
+int main(int argc, const char* argv[]) {
+    try {
+        auto config = GetConfigFromEnv();
+        // bookypedia [--batch]
+        if (argc > 1) {
+            if (argc > 2 || argv[1] != "--batch"sv) {
+                throw std::invalid_argument("Usage: bookypedia [--batch]");
+            }
+            config.batch_mode = true;
+            // Стандартный ввод читается большими блоками, синхронизация с stdio не нужна
+            std::ios::sync_with_stdio(false);
+        }
+        bookypedia::Application app{config};
+        app.Run();
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+}
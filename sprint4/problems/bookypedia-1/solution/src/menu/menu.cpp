@@ -0,0 +1,152 @@
+#include "menu.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <istream>
+#include <stdexcept>
+#include <vector>
+
+namespace menu {
+
+Menu::Menu(std::istream& input, std::ostream& output)
+    : input_{input}
+    , output_{output} {
+}
+
+void Menu::AddAction(std::string action_name, std::string args, std::string description,
+                     Handler handler) {
+    AddActionInfo(std::move(action_name),
+                  ActionInfo{std::move(handler), {}, std::move(args), std::move(description)});
+}
+
+void Menu::AddLineAction(std::string action_name, std::string args, std::string description,
+                         LineHandler handler) {
+    AddActionInfo(std::move(action_name),
+                  ActionInfo{{}, std::move(handler), std::move(args), std::move(description)});
+}
+
+void Menu::AddActionInfo(std::string action_name, ActionInfo info) {
+    if (!actions_.try_emplace(std::move(action_name), std::move(info)).second) {
+        throw std::invalid_argument("A command has been added already");
+    }
+    // Команды добавляются при запуске программы, поэтому индекс можно перестраивать целиком
+    action_index_.Build(
+        actions_,
+        [](const auto& action) -> std::string_view {
+            return action.first;
+        },
+        [](const auto& action) {
+            return &action.second;
+        });
+}
+
+void Menu::Run() {
+    std::string line;
+    while (std::getline(input_, line)) {
+        if (!ExecuteCommand(line)) {
+            break;
+        }
+    }
+}
+
+void Menu::RunBatch() {
+    std::vector<char> block(BATCH_BLOCK_SIZE);
+    // Начало строки, не поместившейся в предыдущий блок
+    std::string incomplete_line;
+    std::streambuf* const input = input_.rdbuf();
+    while (true) {
+        const std::streamsize size = input->sgetn(block.data(), block.size());
+        if (size <= 0) {
+            break;
+        }
+        std::string_view data{block.data(), static_cast<size_t>(size)};
+        for (size_t eol = data.find('\n'); eol != data.npos; eol = data.find('\n')) {
+            bool proceed = true;
+            if (incomplete_line.empty()) {
+                proceed = ExecuteCommand(data.substr(0, eol));
+            } else {
+                incomplete_line.append(data.substr(0, eol));
+                proceed = ExecuteCommand(incomplete_line);
+                incomplete_line.clear();
+            }
+            if (!proceed) {
+                return;
+            }
+            data.remove_prefix(eol + 1);
+        }
+        incomplete_line.append(data);
+    }
+    // Последняя строка может не заканчиваться переводом строки
+    if (!incomplete_line.empty()) {
+        [[maybe_unused]] const bool proceed = ExecuteCommand(incomplete_line);
+    }
+}
+
+void Menu::ShowInstructions() const {
+    if (actions_.empty()) {
+        return;
+    }
+    size_t actions_width = 0;
+    size_t args_width = 0;
+    for (const auto& [action_name, info] : actions_) {
+        actions_width = std::max(actions_width, action_name.length());
+        args_width = std::max(args_width, info.args.length());
+    }
+
+    const auto old_flags = output_.flags();
+    const auto old_fill = output_.fill();
+    auto restore_flags = [this, old_fill, old_flags] {
+        output_.fill(old_fill);
+        output_.setf(old_flags);
+    };
+
+    try {
+        output_ << std::left << std::setfill(' ');
+        for (const auto& [action_name, info] : actions_) {
+            output_ << std::setw(actions_width + 1) << action_name;
+            output_ << std::setw(args_width + 1) << info.args;
+            output_ << info.description << std::endl;
+        }
+    } catch (...) {
+        restore_flags();
+        throw;
+    }
+    restore_flags();
+}
+
+bool Menu::ExecuteCommand(std::string_view line) {
+    using namespace std::literals;
+    constexpr auto WHITESPACE = " \t\n\v\f\r"sv;
+
+    try {
+        const size_t cmd_begin = line.find_first_not_of(WHITESPACE);
+        if (cmd_begin == line.npos) {
+            output_ << "Invalid command"sv << std::endl;
+            return true;
+        }
+        const size_t cmd_end = std::min(line.find_first_of(WHITESPACE, cmd_begin), line.size());
+        const std::string_view cmd = line.substr(cmd_begin, cmd_end - cmd_begin);
+        if (const ActionInfo* action = action_index_.Find(cmd)) {
+            const std::string_view args = line.substr(cmd_end);
+            if (action->line_handler) {
+                return action->line_handler(args);
+            }
+            ResetArgsStream(args);
+            return action->handler(args_stream_);
+        }
+        output_ << "Command '"sv << cmd << "' has not been found."sv << std::endl;
+    } catch (const std::exception& e) {
+        output_ << e.what() << std::endl;
+    }
+    return true;
+}
+
+void Menu::ResetArgsStream(std::string_view args) {
+    args_stream_.exceptions(std::ios_base::goodbit);
+    args_stream_.clear();
+    args_stream_.flags(std::ios_base::skipws | std::ios_base::dec);
+    args_stream_.width(0);
+    args_stream_.str(std::string{args});
+}
+
+}  // namespace menu
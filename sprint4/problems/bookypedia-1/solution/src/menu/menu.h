@@ -0,0 +1,63 @@
+#pragma once
+#include <functional>
+#include <iosfwd>
+#include <map>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+#include "perfect_hash.h"
+
+namespace menu {
+
+class Menu {
+public:
+    using Handler = std::function<bool(std::istream&)>;
+    // Обработчик, получающий остаток строки после имени команды без создания потока
+    using LineHandler = std::function<bool(std::string_view)>;
+
+    // Размер блока, которым RunBatch читает входные данные
+    static constexpr size_t BATCH_BLOCK_SIZE = 1 << 20;
+
+    Menu(std::istream& input, std::ostream& output);
+
+    void AddAction(std::string action_name, std::string args, std::string description,
+                   Handler handler);
+
+    void AddLineAction(std::string action_name, std::string args, std::string description,
+                       LineHandler handler);
+
+    void Run();
+
+    // Пакетный режим для входных данных, переданных через конвейер. Читает input большими
+    // блоками и разбирает строки без потоков. Обработчики не должны читать из input сами:
+    // в пакетном режиме его данные уже прочитаны в блок
+    void RunBatch();
+
+    void ShowInstructions() const;
+
+private:
+    struct ActionInfo {
+        Handler handler;
+        LineHandler line_handler;
+        std::string args;
+        std::string description;
+    };
+
+    void AddActionInfo(std::string action_name, ActionInfo info);
+
+    [[nodiscard]] bool ExecuteCommand(std::string_view line);
+
+    // Возвращает args_stream_ в исходное состояние, чтобы обработчик предыдущей команды,
+    // изменивший флаги форматирования или маску исключений, не влиял на следующую
+    void ResetArgsStream(std::string_view args);
+
+    std::istream& input_;
+    std::ostream& output_;
+    std::map<std::string, ActionInfo> actions_;
+    PerfectHashIndex<const ActionInfo> action_index_;
+    // Поток с аргументами команды для обработчиков Handler. Используется повторно
+    std::istringstream args_stream_;
+};
+
+}  // namespace menu
@@ -0,0 +1,89 @@
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+namespace menu {
+
+/*
+Индекс с идеальным хешированием для небольшого неизменяемого набора строковых ключей.
+При построении подбирается seed, при котором все ключи попадают в разные ячейки таблицы,
+поэтому поиск выполняет одно вычисление хеша и не больше одного сравнения строк.
+Индекс не владеет ключами и значениями: они должны существовать, пока индекс используется.
+*/
+template <typename T>
+class PerfectHashIndex {
+public:
+    // Строит индекс по диапазону пар (ключ, значение). Ключи должны быть различными
+    template <typename Range, typename GetKey, typename GetValue>
+    void Build(const Range& items, GetKey get_key, GetValue get_value) {
+        size_t count = 0;
+        for ([[maybe_unused]] const auto& item : items) {
+            ++count;
+        }
+        // Таблица заполнена не более чем наполовину, чтобы seed находился за несколько попыток
+        for (size_t size = std::bit_ceil(std::max<size_t>(count * 2, 1)); size <= MAX_SIZE;
+             size *= 2) {
+            for (std::uint64_t seed = 0; seed < SEEDS_PER_SIZE; ++seed) {
+                if (TryBuild(items, get_key, get_value, size, seed)) {
+                    return;
+                }
+            }
+        }
+        throw std::invalid_argument("Failed to build a perfect hash index: duplicate keys?");
+    }
+
+    T* Find(std::string_view key) const noexcept {
+        if (slots_.empty()) {
+            return nullptr;
+        }
+        const Slot& slot = slots_[Hash(key, seed_) & mask_];
+        return slot.value && slot.key == key ? slot.value : nullptr;
+    }
+
+private:
+    static constexpr size_t MAX_SIZE = size_t{1} << 20;
+    static constexpr std::uint64_t SEEDS_PER_SIZE = 64;
+
+    struct Slot {
+        std::string_view key;
+        T* value = nullptr;
+    };
+
+    // FNV-1a с перемешиванием старших битов в младшие, которые выбирают ячейку
+    static std::uint64_t Hash(std::string_view key, std::uint64_t seed) noexcept {
+        std::uint64_t hash = 0xcbf29ce484222325ull ^ (seed * 0x9e3779b97f4a7c15ull);
+        for (const char c : key) {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 0x100000001b3ull;
+        }
+        return hash ^ (hash >> 29) ^ (hash >> 47);
+    }
+
+    template <typename Range, typename GetKey, typename GetValue>
+    bool TryBuild(const Range& items, GetKey& get_key, GetValue& get_value, size_t size,
+                  std::uint64_t seed) {
+        std::vector<Slot> slots(size);
+        for (const auto& item : items) {
+            const std::string_view key = get_key(item);
+            Slot& slot = slots[Hash(key, seed) & (size - 1)];
+            if (slot.value) {
+                return false;
+            }
+            slot = {key, get_value(item)};
+        }
+        slots_ = std::move(slots);
+        seed_ = seed;
+        mask_ = size - 1;
+        return true;
+    }
+
+    std::vector<Slot> slots_;
+    std::uint64_t seed_ = 0;
+    size_t mask_ = 0;
+};
+
+}  // namespace menu
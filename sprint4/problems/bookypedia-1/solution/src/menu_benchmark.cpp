@@ -0,0 +1,124 @@
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include "menu/menu.h"
+
+using namespace std::literals;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+unsigned ParseArg(int argc, const char* argv[], int index, unsigned default_value) {
+    if (argc <= index) {
+        return default_value;
+    }
+    const std::string_view arg = argv[index];
+    unsigned value = 0;
+    const auto [end, ec] = std::from_chars(arg.data(), arg.data() + arg.size(), value);
+    if (ec != std::errc{} || end != arg.data() + arg.size()) {
+        throw std::invalid_argument("Invalid argument: "s + std::string(arg));
+    }
+    return value;
+}
+
+// Прежняя схема разбора: поток для каждой строки и поиск команды в std::map
+void RunLegacy(std::istream& input, const std::map<std::string, menu::Menu::Handler>& actions) {
+    std::string line;
+    while (std::getline(input, line)) {
+        std::istringstream cmd_stream{std::move(line)};
+        std::string cmd;
+        if (cmd_stream >> cmd) {
+            if (const auto it = actions.find(cmd); it != actions.end()) {
+                it->second(cmd_stream);
+            }
+        }
+    }
+}
+
+template <typename Fn>
+void Measure(std::string_view name, unsigned num_commands, const std::string& commands,
+             size_t& counter, const Fn& run) {
+    counter = 0;
+    std::istringstream input{commands};
+    const auto start = Clock::now();
+    run(input);
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    if (counter != num_commands) {
+        throw std::logic_error("Not all commands have been executed");
+    }
+    std::cout << name << ": "sv << num_commands / seconds / 1e6 << "M commands/s"sv
+              << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, const char* argv[]) {
+    try {
+        // menu_benchmark [<commands>]
+        const unsigned num_commands = ParseArg(argc, argv, 1, 1'000'000);
+
+        // Команды, похожие на команды bookypedia, с аргументом - остатком строки
+        const std::array names{"AddAuthor"s, "AddBook"s, "ShowAuthors"s, "ShowBooks"s,
+                               "ShowAuthorBooks"s, "Help"s};
+        std::string commands;
+        for (unsigned i = 0; i < num_commands; ++i) {
+            commands += names[i % names.size()] + " Author "s + std::to_string(i) + '\n';
+        }
+
+        size_t counter = 0;
+        const auto stream_handler = [&counter](std::istream& args) {
+            std::string line;
+            std::getline(args, line);
+            counter += !line.empty();
+            return true;
+        };
+        const auto line_handler = [&counter](std::string_view args) {
+            counter += !args.empty();
+            return true;
+        };
+
+        std::map<std::string, menu::Menu::Handler> legacy_actions;
+        for (const auto& name : names) {
+            legacy_actions.emplace(name, stream_handler);
+        }
+        Measure("std::map + istringstream"sv, num_commands, commands, counter,
+                [&legacy_actions](std::istream& input) {
+                    RunLegacy(input, legacy_actions);
+                });
+
+        std::ostringstream output;
+        for (const bool line_handlers : {false, true}) {
+            for (const bool batch : {false, true}) {
+                const auto name = std::string{batch ? "RunBatch"sv : "Run"sv}
+                                + (line_handlers ? " + line handlers"s : " + stream handlers"s);
+                Measure(name, num_commands, commands, counter, [&](std::istream& input) {
+                    menu::Menu menu{input, output};
+                    for (const auto& action_name : names) {
+                        if (line_handlers) {
+                            menu.AddLineAction(action_name, {}, {}, line_handler);
+                        } else {
+                            menu.AddAction(action_name, {}, {}, stream_handler);
+                        }
+                    }
+                    if (batch) {
+                        menu.RunBatch();
+                    } else {
+                        menu.Run();
+                    }
+                });
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,138 @@
+#include "postgres.h"
+
+#include <pqxx/stream_to>
+#include <pqxx/zview.hxx>
+
+#include "../domain/book.h"
+
+namespace postgres {
+
+using namespace std::literals;
+using pqxx::operator"" _zv;
+
+void AuthorRepositoryImpl::Save(const domain::Author& author) {
+    // Пока каждое обращение к репозиторию выполняется внутри отдельной транзакции
+    // В будущих уроках вы узнаете про паттерн Unit of Work, при помощи которого сможете несколько
+    // запросов выполнить в рамках одной транзакции.
+    // Вы также может самостоятельно почитать информацию про этот паттерн и применить его здесь.
+    pqxx::work work{connection_};
+    work.exec_params(
+        R"(
+INSERT INTO authors (id, name) VALUES ($1, $2)
+ON CONFLICT (id) DO UPDATE SET name=$2;
+)"_zv,
+        author.GetId().ToString(), author.GetName());
+    work.commit();
+}
+
+std::vector<domain::Author> AuthorRepositoryImpl::GetAll() {
+    pqxx::read_transaction read{connection_};
+    std::vector<domain::Author> authors;
+    for (const auto& row : read.exec("SELECT id, name FROM authors ORDER BY name;"_zv)) {
+        authors.emplace_back(domain::AuthorId::FromString(row[0].as<std::string>()),
+                             row[1].as<std::string>());
+    }
+    return authors;
+}
+
+namespace {
+
+std::vector<domain::Book> ReadBooks(const pqxx::result& result) {
+    std::vector<domain::Book> books;
+    books.reserve(result.size());
+    for (const auto& row : result) {
+        books.emplace_back(domain::BookId::FromString(row[0].as<std::string>()),
+                           domain::AuthorId::FromString(row[1].as<std::string>()),
+                           row[2].as<std::string>(), row[3].as<int>(0));
+    }
+    return books;
+}
+
+}  // namespace
+
+void BookRepositoryImpl::Save(const domain::Book& book) {
+    pqxx::work work{connection_};
+    work.exec_params(
+        R"(
+INSERT INTO books (id, author_id, title, publication_year) VALUES ($1, $2, $3, $4)
+ON CONFLICT (id) DO UPDATE SET author_id=$2, title=$3, publication_year=$4;
+)"_zv,
+        book.GetId().ToString(), book.GetAuthorId().ToString(), book.GetTitle(),
+        book.GetPublicationYear());
+    work.commit();
+}
+
+std::vector<domain::Book> BookRepositoryImpl::GetAll() {
+    pqxx::read_transaction read{connection_};
+    return ReadBooks(
+        read.exec("SELECT id, author_id, title, publication_year FROM books ORDER BY title;"_zv));
+}
+
+std::vector<domain::Book> BookRepositoryImpl::GetByAuthor(const domain::AuthorId& author_id) {
+    pqxx::read_transaction read{connection_};
+    return ReadBooks(read.exec_params(
+        R"(
+SELECT id, author_id, title, publication_year FROM books WHERE author_id = $1
+ORDER BY publication_year, title;
+)"_zv,
+        author_id.ToString()));
+}
+
+std::vector<domain::Author> CatalogWriterImpl::LoadAuthors() {
+    std::vector<domain::Author> authors;
+    for (const auto& row : work_.exec("SELECT id, name FROM authors;"_zv)) {
+        authors.emplace_back(domain::AuthorId::FromString(row[0].as<std::string>()),
+                             row[1].as<std::string>());
+    }
+    return authors;
+}
+
+void CatalogWriterImpl::Write(std::span<const domain::Author> authors,
+                              std::span<const domain::Book> books) {
+    // В транзакции может быть открыт только один поток COPY, поэтому таблицы заполняются
+    // по очереди. Авторы записываются первыми, так как на них ссылаются книги
+    if (!authors.empty()) {
+        auto stream = pqxx::stream_to::table(work_, {"authors"sv}, {"id"sv, "name"sv});
+        for (const auto& author : authors) {
+            stream.write_values(author.GetId().ToString(), author.GetName());
+        }
+        stream.complete();
+    }
+    if (!books.empty()) {
+        auto stream = pqxx::stream_to::table(
+            work_, {"books"sv}, {"id"sv, "author_id"sv, "title"sv, "publication_year"sv});
+        for (const auto& book : books) {
+            stream.write_values(book.GetId().ToString(), book.GetAuthorId().ToString(),
+                                book.GetTitle(), book.GetPublicationYear());
+        }
+        stream.complete();
+    }
+}
+
+void CatalogWriterImpl::Commit() {
+    work_.commit();
+}
+
+Database::Database(pqxx::connection connection)
+    : connection_{std::move(connection)} {
+    pqxx::work work{connection_};
+    work.exec(R"(
+CREATE TABLE IF NOT EXISTS authors (
+    id UUID CONSTRAINT author_id_constraint PRIMARY KEY,
+    name varchar(100) UNIQUE NOT NULL
+);
+)"_zv);
+    work.exec(R"(
+CREATE TABLE IF NOT EXISTS books (
+    id UUID CONSTRAINT book_id_constraint PRIMARY KEY,
+    author_id UUID NOT NULL REFERENCES authors (id),
+    title varchar(100) NOT NULL,
+    publication_year integer
+);
+)"_zv);
+
+    // коммитим изменения
+    work.commit();
+}
+
+}  // namespace postgres
\ No newline at end of file
@@ -0,0 +1,197 @@
+#include "view.h"
+
+#include <boost/algorithm/string/trim.hpp>
+#include <iostream>
+#include <stdexcept>
+
+#include "../app/use_cases.h"
+#include "../menu/menu.h"
+
+using namespace std::literals;
+namespace ph = std::placeholders;
+
+namespace ui {
+namespace detail {
+
+std::ostream& operator<<(std::ostream& out, const AuthorInfo& author) {
+    out << author.name;
+    return out;
+}
+
+std::ostream& operator<<(std::ostream& out, const BookInfo& book) {
+    out << book.title << ", " << book.publication_year;
+    return out;
+}
+
+}  // namespace detail
+
+template <typename T>
+void PrintVector(std::ostream& out, const std::vector<T>& vector) {
+    int i = 1;
+    for (auto& value : vector) {
+        out << i++ << " " << value << std::endl;
+    }
+}
+
+View::View(menu::Menu& menu, app::UseCases& use_cases, std::istream& input, std::ostream& output)
+    : menu_{menu}
+    , use_cases_{use_cases}
+    , input_{input}
+    , output_{output} {
+    // Имя автора - весь остаток строки, поэтому команду можно разобрать без потока
+    menu_.AddLineAction(  //
+        "AddAuthor"s, "name"s, "Adds author"s, std::bind(&View::AddAuthor, this, ph::_1)
+        // либо
+        // [this](std::string_view name) { return AddAuthor(name); }
+    );
+    menu_.AddAction("AddBook"s, "<pub year> <title>"s, "Adds book"s,
+                    std::bind(&View::AddBook, this, ph::_1));
+    menu_.AddLineAction("ImportCatalog"s, "<file>"s, "Imports authors and books from CSV or JSONL"s,
+                        std::bind(&View::ImportCatalog, this, ph::_1));
+    menu_.AddAction("ShowAuthors"s, {}, "Show authors"s, std::bind(&View::ShowAuthors, this));
+    menu_.AddAction("ShowBooks"s, {}, "Show books"s, std::bind(&View::ShowBooks, this));
+    menu_.AddAction("ShowAuthorBooks"s, {}, "Show author books"s,
+                    std::bind(&View::ShowAuthorBooks, this));
+}
+
+bool View::AddAuthor(std::string_view name) const {
+    try {
+        use_cases_.AddAuthor(std::string{boost::algorithm::trim_copy(name)});
+    } catch (const std::exception&) {
+        output_ << "Failed to add author"sv << std::endl;
+    }
+    return true;
+}
+
+bool View::AddBook(std::istream& cmd_input) const {
+    try {
+        if (auto params = GetBookParams(cmd_input)) {
+            use_cases_.AddBook(params->author_id, params->title, params->publication_year);
+        }
+    } catch (const std::exception&) {
+        output_ << "Failed to add book"sv << std::endl;
+    }
+    return true;
+}
+
+bool View::ImportCatalog(std::string_view file_path) const {
+    const auto print_stats = [this](const app::ImportStats& stats) {
+        output_ << "Imported "sv << stats.books << " books and "sv << stats.authors
+                << " new authors from "sv << stats.rows << " rows in "sv << stats.elapsed.count()
+                << " s ("sv << static_cast<size_t>(stats.GetRowsPerSecond()) << " rows/s)"sv;
+        if (stats.invalid_rows > 0) {
+            output_ << ", skipped "sv << stats.invalid_rows << " invalid rows"sv;
+        }
+        output_ << std::endl;
+    };
+    try {
+        const auto stats = use_cases_.ImportCatalog(
+            std::string{boost::algorithm::trim_copy(file_path)}, print_stats);
+        for (const auto& error : stats.errors) {
+            output_ << error << std::endl;
+        }
+        print_stats(stats);
+    } catch (const std::exception& e) {
+        output_ << "Failed to import catalog: "sv << e.what() << std::endl;
+    }
+    return true;
+}
+
+bool View::ShowAuthors() const {
+    PrintVector(output_, GetAuthors());
+    return true;
+}
+
+bool View::ShowBooks() const {
+    PrintVector(output_, GetBooks());
+    return true;
+}
+
+bool View::ShowAuthorBooks() const {
+    try {
+        if (auto author_id = SelectAuthor()) {
+            PrintVector(output_, GetAuthorBooks(*author_id));
+        }
+    } catch (const std::exception&) {
+        throw std::runtime_error("Failed to Show Books");
+    }
+    return true;
+}
+
+std::optional<detail::AddBookParams> View::GetBookParams(std::istream& cmd_input) const {
+    detail::AddBookParams params;
+
+    if (!(cmd_input >> params.publication_year)) {
+        throw std::invalid_argument("Invalid publication year");
+    }
+    std::getline(cmd_input, params.title);
+    boost::algorithm::trim(params.title);
+    if (params.title.empty()) {
+        throw std::invalid_argument("Empty book title");
+    }
+
+    auto author_id = SelectAuthor();
+    if (not author_id.has_value())
+        return std::nullopt;
+    else {
+        params.author_id = author_id.value();
+        return params;
+    }
+}
+
+std::optional<std::string> View::SelectAuthor() const {
+    output_ << "Select author:" << std::endl;
+    auto authors = GetAuthors();
+    PrintVector(output_, authors);
+    output_ << "Enter author # or empty line to cancel" << std::endl;
+
+    std::string str;
+    if (!std::getline(input_, str) || str.empty()) {
+        return std::nullopt;
+    }
+
+    int author_idx;
+    try {
+        author_idx = std::stoi(str);
+    } catch (std::exception const&) {
+        throw std::runtime_error("Invalid author num");
+    }
+
+    --author_idx;
+    if (author_idx < 0 or author_idx >= authors.size()) {
+        throw std::runtime_error("Invalid author num");
+    }
+
+    return authors[author_idx].id;
+}
+
+namespace {
+
+std::vector<detail::BookInfo> MakeBookInfos(const std::vector<domain::Book>& books) {
+    std::vector<detail::BookInfo> infos;
+    infos.reserve(books.size());
+    for (const auto& book : books) {
+        infos.push_back({book.GetTitle(), book.GetPublicationYear()});
+    }
+    return infos;
+}
+
+}  // namespace
+
+std::vector<detail::AuthorInfo> View::GetAuthors() const {
+    std::vector<detail::AuthorInfo> dst_autors;
+    for (const auto& author : use_cases_.GetAuthors()) {
+        dst_autors.push_back({author.GetId().ToString(), author.GetName()});
+    }
+    return dst_autors;
+}
+
+std::vector<detail::BookInfo> View::GetBooks() const {
+    return MakeBookInfos(use_cases_.GetBooks());
+}
+
+std::vector<detail::BookInfo> View::GetAuthorBooks(const std::string& author_id) const {
+    return MakeBookInfos(use_cases_.GetAuthorBooks(author_id));
+}
+
+}  // namespace ui
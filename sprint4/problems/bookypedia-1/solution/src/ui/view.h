@@ -0,0 +1,61 @@
+#pragma once
+#include <iosfwd>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace menu {
+class Menu;
+}
+
+namespace app {
+class UseCases;
+}
+
+namespace ui {
+namespace detail {
+
+struct AddBookParams {
+    std::string title;
+    std::string author_id;
+    int publication_year = 0;
+};
+
+struct AuthorInfo {
+    std::string id;
+    std::string name;
+};
+
+struct BookInfo {
+    std::string title;
+    int publication_year;
+};
+
+}  // namespace detail
+
+class View {
+public:
+    View(menu::Menu& menu, app::UseCases& use_cases, std::istream& input, std::ostream& output);
+
+private:
+    bool AddAuthor(std::string_view name) const;
+    bool AddBook(std::istream& cmd_input) const;
+    bool ImportCatalog(std::string_view file_path) const;
+    bool ShowAuthors() const;
+    bool ShowBooks() const;
+    bool ShowAuthorBooks() const;
+
+    std::optional<detail::AddBookParams> GetBookParams(std::istream& cmd_input) const;
+    std::optional<std::string> SelectAuthor() const;
+    std::vector<detail::AuthorInfo> GetAuthors() const;
+    std::vector<detail::BookInfo> GetBooks() const;
+    std::vector<detail::BookInfo> GetAuthorBooks(const std::string& author_id) const;
+
+    menu::Menu& menu_;
+    app::UseCases& use_cases_;
+    std::istream& input_;
+    std::ostream& output_;
+};
+
+}  // namespace ui
\ No newline at end of file
@@ -0,0 +1,214 @@
+#include <catch2/catch_test_macros.hpp>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../src/app/catalog_import.h"
+#include "../src/domain/author.h"
+
+using namespace std::literals;
+
+namespace {
+
+// Хранилище в памяти. Данные транзакции становятся видны только после Commit
+struct MemoryCatalogStorage : app::CatalogStorage {
+    std::vector<domain::Author> authors;
+    std::vector<domain::Book> books;
+    size_t write_count = 0;
+
+    class Writer : public app::CatalogWriter {
+    public:
+        explicit Writer(MemoryCatalogStorage& storage)
+            : storage_{storage} {
+        }
+
+        std::vector<domain::Author> LoadAuthors() override {
+            return storage_.authors;
+        }
+
+        void Write(std::span<const domain::Author> authors,
+                   std::span<const domain::Book> books) override {
+            authors_.insert(authors_.end(), authors.begin(), authors.end());
+            for (const auto& book : books) {
+                // Автор книги должен быть записан раньше неё
+                const auto has_author = [&book](const domain::Author& author) {
+                    return author.GetId() == book.GetAuthorId();
+                };
+                CHECK((std::any_of(authors_.begin(), authors_.end(), has_author)
+                       || std::any_of(storage_.authors.begin(), storage_.authors.end(),
+                                      has_author)));
+            }
+            books_.insert(books_.end(), books.begin(), books.end());
+            ++storage_.write_count;
+        }
+
+        void Commit() override {
+            storage_.authors.insert(storage_.authors.end(), authors_.begin(), authors_.end());
+            storage_.books.insert(storage_.books.end(), books_.begin(), books_.end());
+        }
+
+    private:
+        MemoryCatalogStorage& storage_;
+        std::vector<domain::Author> authors_;
+        std::vector<domain::Book> books_;
+    };
+
+    std::unique_ptr<app::CatalogWriter> StartImport() override {
+        return std::make_unique<Writer>(*this);
+    }
+
+    // Название книги -> имя её автора
+    std::map<std::string, std::string> GetBookAuthors() const {
+        std::map<std::string, std::string> result;
+        for (const auto& book : books) {
+            for (const auto& author : authors) {
+                if (author.GetId() == book.GetAuthorId()) {
+                    result.emplace(book.GetTitle(), author.GetName());
+                }
+            }
+        }
+        return result;
+    }
+};
+
+}  // namespace
+
+TEST_CASE("CSV catalog rows are parsed and validated") {
+    const auto chunk =
+        "author,title,publication_year\n"
+        "Leo Tolstoy, War and Peace ,1869\r\n"
+        "\n"
+        "\"Strugatsky, Arkady\",\"Roadside \"\"Picnic\"\"\",1972\n"
+        "No Year,Title,\n"
+        "Too,Many,Fields,1\n"
+        ",Untitled author,2000\n"
+        "\"Unterminated,Title,2000\n"sv;
+    const auto parsed = app::ParseCatalogChunk(chunk, app::CatalogFormat::CSV, 1, 2);
+
+    REQUIRE(parsed.records.size() == 2);
+    CHECK(parsed.records[0].author == "Leo Tolstoy"s);
+    CHECK(parsed.records[0].title == "War and Peace"s);
+    CHECK(parsed.records[0].publication_year == 1869);
+    CHECK(parsed.records[1].author == "Strugatsky, Arkady"s);
+    CHECK(parsed.records[1].title == "Roadside \"Picnic\""s);
+    CHECK(parsed.invalid_rows == 4);
+    CHECK(parsed.errors == std::vector{"Line 5: invalid publication year"s,
+                                       "Line 6: expected 3 fields, found 4"s});
+}
+
+TEST_CASE("JSONL catalog rows are parsed and validated") {
+    const auto chunk =
+        R"({"author": "Fyodor Dostoevsky", "title": "Crime and Punishment", )"
+        R"("publication_year": 1866})"
+        "\n"
+        R"({"id": 7, "title": "Бесы 📚", "publication_year": 1872, )"
+        R"("author": "F. \"Dostoevsky\""})"
+        "\n"
+        R"({"author": "No year", "title": "Book"})"
+        "\n"
+        R"({"author": "Nested", "title": "Book", "tags": [], "publication_year": 1})"
+        "\n"
+        R"({"author": "Trailing", "title": "Book", "publication_year": 1} x)"sv;
+    const auto parsed = app::ParseCatalogChunk(chunk, app::CatalogFormat::JSONL, 10, 10);
+
+    REQUIRE(parsed.records.size() == 2);
+    CHECK(parsed.records[0].title == "Crime and Punishment"s);
+    CHECK(parsed.records[0].publication_year == 1866);
+    CHECK(parsed.records[1].author == "F. \"Dostoevsky\""s);
+    CHECK(parsed.records[1].title == "Бесы \xF0\x9F\x93\x9A"s);
+    CHECK(parsed.invalid_rows == 3);
+    REQUIRE(parsed.errors.size() == 3);
+    CHECK(parsed.errors[0] == "Line 12: author, title and publication_year are required"s);
+}
+
+TEST_CASE("Rows with NUL characters or invalid UTF-8 are rejected") {
+    const auto csv_chunk =
+        "Valid,Title,2000\n"
+        "Bad\xFF\xFE author,Title,2000\n"
+        "Author,Truncated \xD0,2000\n"
+        "Author,Overlong \xC0\xAF,2000\n"
+        "Author,Surrogate \xED\xA0\x80,2000\n"
+        "Nul\0author,Title,2000\n"sv;
+    const auto csv = app::ParseCatalogChunk(csv_chunk, app::CatalogFormat::CSV, 1, 10);
+
+    REQUIRE(csv.records.size() == 1);
+    CHECK(csv.records[0].author == "Valid"s);
+    CHECK(csv.invalid_rows == 5);
+    CHECK(csv.errors == std::vector{"Line 2: author name is not valid UTF-8"s,
+                                    "Line 3: title is not valid UTF-8"s,
+                                    "Line 4: title is not valid UTF-8"s,
+                                    "Line 5: title is not valid UTF-8"s,
+                                    "Line 6: author name must not contain NUL characters"s});
+
+    const auto jsonl_chunk =
+        R"({"author": "Nul\u0000", "title": "Book", "publication_year": 1})"
+        "\n"
+        "{\"author\": \"Author\", \"title\": \"Bad \xFF\xFE\", \"publication_year\": 1}\n"
+        R"({"author": "Автор", "title": "\u041a\u043d\u0438\u0433\u0430", )"
+        R"("publication_year": 1})"sv;
+    const auto jsonl = app::ParseCatalogChunk(jsonl_chunk, app::CatalogFormat::JSONL, 1, 10);
+
+    REQUIRE(jsonl.records.size() == 1);
+    CHECK(jsonl.records[0].title == "Книга"s);
+    CHECK(jsonl.invalid_rows == 2);
+    CHECK(jsonl.errors == std::vector{"Line 1: author name must not contain NUL characters"s,
+                                      "Line 2: title is not valid UTF-8"s});
+}
+
+TEST_CASE("Catalog format is detected by file extension") {
+    CHECK(app::GetCatalogFormat("books.csv"sv) == app::CatalogFormat::CSV);
+    CHECK(app::GetCatalogFormat("/tmp/books.jsonl"sv) == app::CatalogFormat::JSONL);
+    CHECK_THROWS_AS(app::GetCatalogFormat("books.txt"sv), std::invalid_argument);
+}
+
+TEST_CASE("Catalog import deduplicates authors across chunks") {
+    MemoryCatalogStorage storage;
+    const domain::Author existing_author{domain::AuthorId::New(), "Author 0"s};
+    storage.authors.push_back(existing_author);
+
+    std::ostringstream catalog;
+    catalog << "author,title,publication_year\n"sv;
+    constexpr int NUM_BOOKS = 1000;
+    for (int i = 0; i < NUM_BOOKS; ++i) {
+        catalog << "Author "sv << i % 7 << ",Book "sv << i << ',' << 1900 + i % 100 << '\n';
+    }
+    catalog << "Broken row\n"sv;
+    // Последняя строка без перевода строки
+    catalog << "Author 7,Last book,2024"sv;
+
+    std::istringstream input{catalog.str()};
+    app::ImportOptions options;
+    options.num_threads = 3;
+    // Маленькие фрагменты разрезают файл посреди строк
+    options.chunk_size = 100;
+    options.progress_interval = {};
+    size_t progress_calls = 0;
+    const auto stats =
+        app::CatalogImporter{storage, options}.Import(input, app::CatalogFormat::CSV,
+                                                      [&progress_calls](const auto& stats) {
+                                                          ++progress_calls;
+                                                          CHECK(stats.books > 0);
+                                                      });
+
+    CHECK(stats.books == NUM_BOOKS + 1);
+    CHECK(stats.rows == NUM_BOOKS + 2);
+    CHECK(stats.invalid_rows == 1);
+    CHECK(stats.errors == std::vector{"Line 1002: expected 3 fields, found 1"s});
+    // Author 0 уже был в хранилище
+    CHECK(stats.authors == 7);
+    CHECK(storage.authors.size() == 8);
+    CHECK(storage.write_count > 1);
+    CHECK(progress_calls == storage.write_count);
+
+    const auto book_authors = storage.GetBookAuthors();
+    REQUIRE(book_authors.size() == NUM_BOOKS + 1);
+    for (int i = 0; i < NUM_BOOKS; ++i) {
+        CHECK(book_authors.at("Book "s + std::to_string(i)) == "Author "s + std::to_string(i % 7));
+    }
+    CHECK(book_authors.at("Last book"s) == "Author 7"s);
+    const auto book_0 = std::find_if(storage.books.begin(), storage.books.end(), [](auto& book) {
+        return book.GetTitle() == "Book 0"s;
+    });
+    CHECK(book_0->GetAuthorId() == existing_author.GetId());
+}
@@ -0,0 +1,138 @@
+#include <catch2/catch_test_macros.hpp>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../src/menu/menu.h"
+
+using namespace std::literals;
+
+namespace {
+
+// Меню с командами, запоминающими полученные аргументы
+struct MenuFixture {
+    std::istringstream input;
+    std::ostringstream output;
+    menu::Menu menu{input, output};
+    std::vector<std::string> stream_args;
+    std::vector<std::string> line_args;
+
+    MenuFixture() {
+        menu.AddAction("Stream"s, "value"s, "Stream command"s, [this](std::istream& args) {
+            std::string value;
+            args >> value;
+            stream_args.push_back(value);
+            return true;
+        });
+        menu.AddLineAction("Line"s, "text"s, "Line command"s, [this](std::string_view args) {
+            line_args.emplace_back(args);
+            return true;
+        });
+        menu.AddAction("Exit"s, {}, "Exit"s, [](std::istream&) {
+            return false;
+        });
+    }
+};
+
+}  // namespace
+
+TEST_CASE_METHOD(MenuFixture, "Menu dispatches commands in interactive and batch modes") {
+    const auto commands = "Stream 42\n  Line hello world\n\nUnknown\nStream\t7\r\n"s;
+    for (const bool batch : {false, true}) {
+        input.str(commands);
+        input.clear();
+        output.str({});
+        stream_args.clear();
+        line_args.clear();
+
+        if (batch) {
+            menu.RunBatch();
+        } else {
+            menu.Run();
+        }
+
+        CHECK(stream_args == std::vector{"42"s, "7"s});
+        CHECK(line_args == std::vector{" hello world"s});
+        CHECK(output.str() == "Invalid command\nCommand 'Unknown' has not been found.\n"s);
+    }
+}
+
+TEST_CASE_METHOD(MenuFixture, "Batch mode joins lines split between blocks and stops on exit") {
+    std::string commands;
+    size_t count = 0;
+    while (commands.size() < menu::Menu::BATCH_BLOCK_SIZE * 2 + 100) {
+        commands += "Line "s + std::to_string(count++) + '\n';
+    }
+    commands += "Exit\nLine after exit\n"s;
+    input.str(commands);
+
+    menu.RunBatch();
+
+    REQUIRE(line_args.size() == count);
+    for (size_t i = 0; i < count; ++i) {
+        CHECK(line_args[i] == " "s + std::to_string(i));
+    }
+    CHECK(output.str().empty());
+}
+
+TEST_CASE_METHOD(MenuFixture, "Batch mode executes the last line without a line feed") {
+    input.str("Stream 1\nStream 2"s);
+    menu.RunBatch();
+    CHECK(stream_args == std::vector{"1"s, "2"s});
+}
+
+TEST_CASE_METHOD(MenuFixture, "Stream state set by a command does not leak into the next one") {
+    std::vector<int> numbers;
+    menu.AddAction("Hex"s, "value"s, "Reads a hex number"s, [&numbers](std::istream& args) {
+        int value = 0;
+        args.exceptions(std::ios_base::failbit);
+        args >> std::hex >> std::noskipws >> value;
+        numbers.push_back(value);
+        return true;
+    });
+    menu.AddAction("Dec"s, "value"s, "Reads a decimal number"s, [&numbers](std::istream& args) {
+        int value = 0;
+        args >> value;
+        numbers.push_back(args ? value : -1);
+        return true;
+    });
+    input.str("Hex ff\nDec 10\nDec x\nDec 12\n"s);
+
+    menu.Run();
+
+    // Пробел перед аргументом Hex не пропускается из-за noskipws, и чтение завершается ошибкой
+    CHECK(numbers == std::vector{10, -1, 12});
+    CHECK(!output.str().empty());
+}
+
+TEST_CASE("Perfect hash index finds every key and only them") {
+    std::vector<std::string> keys;
+    std::vector<int> values;
+    for (int i = 0; i < 1000; ++i) {
+        keys.push_back("Command"s + std::to_string(i));
+        values.push_back(i);
+    }
+    std::vector<size_t> indices(keys.size());
+    for (size_t i = 0; i < indices.size(); ++i) {
+        indices[i] = i;
+    }
+
+    menu::PerfectHashIndex<int> index;
+    index.Build(
+        indices,
+        [&keys](size_t i) -> std::string_view {
+            return keys[i];
+        },
+        [&values](size_t i) {
+            return &values[i];
+        });
+
+    for (size_t i = 0; i < keys.size(); ++i) {
+        const int* value = index.Find(keys[i]);
+        REQUIRE(value != nullptr);
+        CHECK(*value == values[i]);
+    }
+    CHECK(index.Find("Command1000"sv) == nullptr);
+    CHECK(index.Find(""sv) == nullptr);
+    CHECK(menu::PerfectHashIndex<int>{}.Find("Command0"sv) == nullptr);
+}
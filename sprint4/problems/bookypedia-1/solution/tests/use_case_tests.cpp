@@ -0,0 +1,89 @@
+#include <catch2/catch_test_macros.hpp>
+#include <stdexcept>
+
+#include "../src/app/use_cases_impl.h"
+#include "../src/domain/author.h"
+#include "../src/domain/book.h"
+
+namespace {
+
+struct MockAuthorRepository : domain::AuthorRepository {
+    std::vector<domain::Author> saved_authors;
+
+    void Save(const domain::Author& author) override {
+        saved_authors.emplace_back(author);
+    }
+
+    std::vector<domain::Author> GetAll() override {
+        return saved_authors;
+    }
+};
+
+struct MockBookRepository : domain::BookRepository {
+    std::vector<domain::Book> saved_books;
+
+    void Save(const domain::Book& book) override {
+        saved_books.emplace_back(book);
+    }
+
+    std::vector<domain::Book> GetAll() override {
+        return saved_books;
+    }
+
+    std::vector<domain::Book> GetByAuthor(const domain::AuthorId& author_id) override {
+        std::vector<domain::Book> books;
+        for (const auto& book : saved_books) {
+            if (book.GetAuthorId() == author_id) {
+                books.push_back(book);
+            }
+        }
+        return books;
+    }
+};
+
+struct MockCatalogStorage : app::CatalogStorage {
+    std::unique_ptr<app::CatalogWriter> StartImport() override {
+        throw std::logic_error("Catalog import is not expected");
+    }
+};
+
+struct Fixture {
+    MockAuthorRepository authors;
+    MockBookRepository books;
+    MockCatalogStorage catalog;
+};
+
+}  // namespace
+
+SCENARIO_METHOD(Fixture, "Book Adding") {
+    GIVEN("Use cases") {
+        app::UseCasesImpl use_cases{authors, books, catalog};
+
+        WHEN("Adding an author") {
+            const auto author_name = "Joanne Rowling";
+            use_cases.AddAuthor(author_name);
+
+            THEN("author with the specified name is saved to repository") {
+                REQUIRE(authors.saved_authors.size() == 1);
+                CHECK(authors.saved_authors.at(0).GetName() == author_name);
+                CHECK(authors.saved_authors.at(0).GetId() != domain::AuthorId{});
+            }
+
+            AND_WHEN("Adding a book of the author") {
+                const auto author_id = authors.saved_authors.at(0).GetId();
+                use_cases.AddBook(author_id.ToString(), "Harry Potter", 1997);
+
+                THEN("the book is saved to repository with the author's id") {
+                    REQUIRE(books.saved_books.size() == 1);
+                    const auto& book = books.saved_books.at(0);
+                    CHECK(book.GetTitle() == "Harry Potter");
+                    CHECK(book.GetPublicationYear() == 1997);
+                    CHECK(book.GetAuthorId() == author_id);
+                    CHECK(book.GetId() != domain::BookId{});
+                    CHECK(use_cases.GetAuthorBooks(author_id.ToString()).size() == 1);
+                    CHECK(use_cases.GetAuthorBooks(domain::AuthorId::New().ToString()).empty());
+                }
+            }
+        }
+    }
+}
\ No newline at end of file